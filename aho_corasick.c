@@ -0,0 +1,224 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "aho_corasick.h"
+#include "outils.h"
+
+#include <string.h>
+
+#define NB_OCTETS 256
+
+/*
+ * 'transitions' contient NB_OCTETS cases par état. Pendant la construction
+ * de l'arbre, une case vaut -1 quand la transition n'existe pas ; le
+ * parcours en largeur remplace ensuite ces cases par la transition de l'état
+ * de suppléance.
+ *
+ * 'sortie[e]' est le premier motif qui se termine en e (ou -1), les autres
+ * s'obtiennent avec 'motif_suivant'. 'lien_sortie[e]' est le plus proche
+ * état de la chaîne des suppléances de e où se termine un motif (ou -1).
+ */
+struct _Aho_corasick {
+	int nb_etats;
+	int capacite;
+	int * transitions;
+	int * sortie;
+	int * lien_sortie;
+	int * motif_suivant;
+	int nb_motifs;
+	int utilisees[NB_OCTETS];
+};
+
+static int nouvel_etat( Aho_corasick * ac ){
+	int e = ac->nb_etats++;
+	if( e == ac->capacite ){
+		ac->capacite *= 2;
+		ac->transitions = xrealloc(
+			ac->transitions, (size_t) ac->capacite * NB_OCTETS * sizeof(int)
+		);
+		ac->sortie = xrealloc( ac->sortie, ac->capacite * sizeof(int) );
+		ac->lien_sortie = xrealloc( ac->lien_sortie, ac->capacite * sizeof(int) );
+	}
+	memset( ac->transitions + (size_t) e * NB_OCTETS, -1, NB_OCTETS * sizeof(int) );
+	ac->sortie[e] = -1;
+	ac->lien_sortie[e] = -1;
+	return e;
+}
+
+Aho_corasick * creer_aho_corasick( const char ** motifs, size_t nb_motifs ){
+	Aho_corasick * res = xmalloc( sizeof(Aho_corasick) );
+	int * suppleances, * file;
+	int debut = 0, fin = 0, c;
+	size_t i;
+
+	res->nb_etats = 0;
+	res->capacite = 16;
+	res->transitions = xmalloc( (size_t) res->capacite * NB_OCTETS * sizeof(int) );
+	res->sortie = xmalloc( res->capacite * sizeof(int) );
+	res->lien_sortie = xmalloc( res->capacite * sizeof(int) );
+	res->nb_motifs = nb_motifs;
+	res->motif_suivant = xmalloc( ( nb_motifs + 1 ) * sizeof(int) );
+	memset( res->utilisees, 0, sizeof(res->utilisees) );
+	nouvel_etat( res );
+
+	// L'arbre des préfixes
+	for( i = 0; i < nb_motifs; i++ ){
+		const unsigned char * m = (const unsigned char *) motifs[i];
+		int e = 0;
+		for( ; *m; m++ ){
+			int * case_transition = res->transitions + (size_t) e * NB_OCTETS + *m;
+			if( *case_transition < 0 ){
+				// nouvel_etat() peut déplacer le tableau des transitions
+				int f = nouvel_etat( res );
+				res->transitions[ (size_t) e * NB_OCTETS + *m ] = f;
+			}
+			res->utilisees[*m] = 1;
+			e = res->transitions[ (size_t) e * NB_OCTETS + *m ];
+		}
+		res->motif_suivant[i] = res->sortie[e];
+		res->sortie[e] = i;
+	}
+
+	// Les suppléances, par un parcours en largeur. Quand un état est traité,
+	// la ligne de son état de suppléance (moins profond) est déjà complète.
+	suppleances = xmalloc( res->nb_etats * sizeof(int) );
+	file = xmalloc( res->nb_etats * sizeof(int) );
+	suppleances[0] = 0;
+	file[ fin++ ] = 0;
+	while( debut < fin ){
+		int e = file[ debut++ ];
+		int * ligne = res->transitions + (size_t) e * NB_OCTETS;
+		const int * ligne_suppleance =
+			res->transitions + (size_t) suppleances[e] * NB_OCTETS;
+		for( c = 0; c < NB_OCTETS; c++ ){
+			int f = ligne[c];
+			if( f < 0 ){
+				ligne[c] = ( e == 0 ) ? 0 : ligne_suppleance[c];
+			}else{
+				int s = ( e == 0 ) ? 0 : ligne_suppleance[c];
+				suppleances[f] = s;
+				res->lien_sortie[f] =
+					( res->sortie[s] >= 0 ) ? s : res->lien_sortie[s];
+				file[ fin++ ] = f;
+			}
+		}
+	}
+	xfree( suppleances );
+	xfree( file );
+	return res;
+}
+
+void liberer_aho_corasick( Aho_corasick * ac ){
+	if( ac ){
+		xfree( ac->transitions );
+		xfree( ac->sortie );
+		xfree( ac->lien_sortie );
+		xfree( ac->motif_suivant );
+		xfree( ac );
+	}
+}
+
+int nb_etats_aho_corasick( const Aho_corasick * ac ){
+	return ac->nb_etats;
+}
+
+/* Signale les motifs qui se terminent dans l'état e, et renvoie leur nombre.
+ */
+static size_t signaler_sorties(
+	const Aho_corasick * ac, int e, size_t fin,
+	void (* action )( int motif, size_t fin, void * data ), void * data
+){
+	size_t res = 0;
+	int m;
+	if( ac->sortie[e] < 0 ) e = ac->lien_sortie[e];
+	for( ; e >= 0; e = ac->lien_sortie[e] ){
+		for( m = ac->sortie[e]; m >= 0; m = ac->motif_suivant[m] ){
+			if( action ) action( m, fin, data );
+			res++;
+		}
+	}
+	return res;
+}
+
+size_t chercher_motifs(
+	const Aho_corasick * ac, const char * texte, size_t longueur,
+	void (* action )( int motif, size_t fin, void * data ), void * data
+){
+	const unsigned char * t = (const unsigned char *) texte;
+	size_t res = signaler_sorties( ac, 0, 0, action, data );
+	size_t i;
+	int e = 0;
+	for( i = 0; i < longueur; i++ ){
+		e = ac->transitions[ (size_t) e * NB_OCTETS + t[i] ];
+		if( ac->sortie[e] >= 0 || ac->lien_sortie[e] >= 0 ){
+			res += signaler_sorties( ac, e, i + 1, action, data );
+		}
+	}
+	return res;
+}
+
+int contient_un_motif(
+	const Aho_corasick * ac, const char * texte, size_t longueur
+){
+	const unsigned char * t = (const unsigned char *) texte;
+	size_t i;
+	int e = 0;
+	if( ac->sortie[0] >= 0 ) return 1;
+	for( i = 0; i < longueur; i++ ){
+		e = ac->transitions[ (size_t) e * NB_OCTETS + t[i] ];
+		if( ac->sortie[e] >= 0 || ac->lien_sortie[e] >= 0 ) return 1;
+	}
+	return 0;
+}
+
+Automate * aho_corasick_vers_automate(
+	const Aho_corasick * ac, const Ensemble * alphabet, int contient
+){
+	Automate * res = creer_automate();
+	int lettres[NB_OCTETS];
+	int e, c;
+
+	memcpy( lettres, ac->utilisees, sizeof(lettres) );
+	if( alphabet ){
+		Ensemble_iterateur it;
+		for( it = premier_iterateur_ensemble( alphabet );
+			! iterateur_ensemble_est_vide( it );
+			it = iterateur_suivant_ensemble( it )
+		){
+			lettres[ (unsigned char) get_element( it ) ] = 1;
+		}
+	}
+
+	for( e = 0; e < ac->nb_etats; e++ ){
+		int final = ( ac->sortie[e] >= 0 || ac->lien_sortie[e] >= 0 );
+		ajouter_etat( res, e );
+		if( final ) ajouter_etat_final( res, e );
+		for( c = 0; c < NB_OCTETS; c++ ){
+			if( ! lettres[c] ) continue;
+			ajouter_transition(
+				res, e, (char) c,
+				( contient && final ) ? e : ac->transitions[ (size_t) e * NB_OCTETS + c ]
+			);
+		}
+	}
+	ajouter_etat_initial( res, 0 );
+	return res;
+}
@@ -0,0 +1,111 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __AHO_CORASICK_H__
+#define __AHO_CORASICK_H__
+
+#include <stddef.h>
+
+#include "automate.h"
+
+/**
+ * \brief Un automate de recherche simultanée de plusieurs motifs.
+ */
+typedef struct _Aho_corasick Aho_corasick;
+
+/**
+ * \brief Construit l'automate d'Aho-Corasick d'une liste de motifs.
+ *
+ * Les motifs sont rangés dans un arbre des préfixes, puis les liens de
+ * suppléance sont calculés par un parcours en largeur et utilisés pour
+ * compléter la table de transitions : chaque état a une transition pour
+ * chacun des 256 octets, et la recherche lit chaque caractère du texte une
+ * seule fois, sans jamais revenir en arrière.
+ *
+ * Le motif numéro i est motifs[i]. Un même motif peut apparaître plusieurs
+ * fois dans la liste.
+ *
+ * \param motifs Les motifs
+ * \param nb_motifs Le nombre de motifs
+ * \return L'automate, à libérer avec liberer_aho_corasick()
+ */
+Aho_corasick * creer_aho_corasick( const char ** motifs, size_t nb_motifs );
+
+void liberer_aho_corasick( Aho_corasick * ac );
+
+/**
+ * \brief Renvoie le nombre d'états de l'automate d'Aho-Corasick.
+ */
+int nb_etats_aho_corasick( const Aho_corasick * ac );
+
+/**
+ * \brief Cherche toutes les occurrences des motifs dans un texte.
+ *
+ * Pour chaque occurrence, 'action' est appelée avec le numéro du motif et la
+ * position de fin de l'occurrence dans le texte (la position qui suit son
+ * dernier caractère). Les occurrences sont signalées par position de fin
+ * croissante. 'action' peut être NULL si seul le nombre d'occurrences
+ * importe.
+ *
+ * \param ac L'automate
+ * \param texte Le texte
+ * \param longueur La longueur du texte
+ * \param action La fonction à appeler pour chaque occurrence, ou NULL
+ * \param data Un pointeur passé à 'action'
+ * \return Le nombre d'occurrences
+ */
+size_t chercher_motifs(
+	const Aho_corasick * ac, const char * texte, size_t longueur,
+	void (* action )( int motif, size_t fin, void * data ), void * data
+);
+
+/**
+ * \brief Renvoie 1 si le texte contient au moins un des motifs, et 0 sinon.
+ *
+ * La recherche s'arrête à la première occurrence trouvée.
+ */
+int contient_un_motif(
+	const Aho_corasick * ac, const char * texte, size_t longueur
+);
+
+/**
+ * \brief Convertit l'automate d'Aho-Corasick en automate déterministe
+ *        complet.
+ *
+ * L'alphabet de l'automate obtenu est formé des lettres des motifs et de
+ * celles de 'alphabet' (qui peut être NULL). Les états sont numérotés comme
+ * ceux de l'arbre des préfixes, l'état initial est 0.
+ *
+ * Si 'contient' vaut 0, l'automate reconnaît les mots qui se terminent par un
+ * des motifs. Sinon, les états finaux bouclent sur toutes les lettres et
+ * l'automate reconnaît les mots qui contiennent un des motifs, comme
+ * creer_automate_des_sur_mot().
+ *
+ * \param ac L'automate d'Aho-Corasick
+ * \param alphabet Des lettres à ajouter à l'alphabet, ou NULL
+ * \param contient 0 ou 1
+ * \return L'automate
+ */
+Automate * aho_corasick_vers_automate(
+	const Aho_corasick * ac, const Ensemble * alphabet, int contient
+);
+
+#endif
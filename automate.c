@@ -22,6 +22,10 @@
 #include "table.h"
 #include "ensemble.h"
 #include "outils.h"
+#include "hachage.h"
+#include "fifo.h"
+#include "index_automate.h"
+#include "parcours.h"
 
 #include <search.h>
 #include <stdio.h>
@@ -38,6 +42,9 @@ struct _Automate {
     Table * transitions;
     Ensemble * initiaux;
     Ensemble * finaux;
+    // L'index d'un automate gelé, NULL sinon (voir geler_automate()).
+    Index_automate * index;
+    int indice_initial;
 };
 
 typedef struct _Cle {
@@ -79,11 +86,11 @@ void supprimer_cle( Cle * cle ){
 
 void initialiser_cle( Cle * cle, int origine, char lettre ){
     cle->origine = origine;
-    cle->lettre = (int) lettre;
+    cle->lettre = (unsigned char) lettre;
 }
 
 Cle * creer_cle( int origine, char lettre ){
-    Cle * result = xmalloc( sizeof(Cle) );
+    Cle * result = xmalloc_etiquete( sizeof(Cle), ALLOCATION_AUTOMATE );
     initialiser_cle( result, origine, lettre );
     return result;
 }
@@ -93,7 +100,8 @@ Cle * copier_cle( const Cle * cle ){
 }
 
 Automate * creer_automate(){
-    Automate * automate = xmalloc( sizeof(Automate) );
+    Automate * automate = xmalloc_etiquete(
+	sizeof(Automate), ALLOCATION_AUTOMATE );
     automate->etats = creer_ensemble( NULL, NULL, NULL );
     automate->alphabet = creer_ensemble( NULL, NULL, NULL );
     automate->transitions = 
@@ -103,10 +111,13 @@ Automate * creer_automate(){
     automate->initiaux = creer_ensemble( NULL, NULL, NULL );
     automate->finaux = creer_ensemble( NULL, NULL, NULL );
     automate->vide = creer_ensemble( NULL, NULL, NULL ); 
+    automate->index = NULL;
+    automate->indice_initial = -1;
     return automate;
 }
 
 void liberer_automate( Automate * automate ){
+    if( automate->index ) liberer_index_automate( automate->index );
     liberer_ensemble( automate->vide );
     liberer_ensemble( automate->finaux );
     liberer_ensemble( automate->initiaux );
@@ -140,7 +151,43 @@ const Ensemble * get_alphabet( const Automate * automate ){
     return automate->alphabet;
 }
 
+/* Toutes les modifications d'un automate passent par les fonctions qui
+ * appellent verifier_non_gele().
+ */
+static void verifier_non_gele( const Automate * automate ){
+    if( automate->index )
+	ERREUR( "Modification d'un automate gele" );
+}
+
+void geler_automate( Automate * automate ){
+    int i;
+    if( automate->index ) return;
+    automate->index = creer_index_automate( automate );
+    // Un automate déterministe est lu sans allocation : on retient son
+    // unique état initial.
+    automate->indice_initial = -1;
+    if( index_est_deterministe( automate->index ) ){
+	for( i = 0; i < automate->index->nb_etats; i++ )
+	    if( TESTER_BIT( automate->index->initiaux, i ) )
+		automate->indice_initial = i;
+	if( automate->indice_initial < 0 )
+	    automate->indice_initial = automate->index->nb_etats;
+    }
+}
+
+void degeler_automate( Automate * automate ){
+    if( ! automate->index ) return;
+    liberer_index_automate( automate->index );
+    automate->index = NULL;
+    automate->indice_initial = -1;
+}
+
+int est_gele( const Automate * automate ){
+    return automate->index != NULL;
+}
+
 void ajouter_etat( Automate * automate, int etat ){
+    verifier_non_gele( automate );
     ajouter_element( automate->etats, etat );
 }
 
@@ -149,7 +196,8 @@ void ajouter_etat( Automate * automate, int etat ){
  * si la lettre est déjà dans l'ensemble.
  */
 void ajouter_lettre( Automate * automate, char lettre ){
-    ajouter_element( automate->alphabet, lettre );
+    verifier_non_gele( automate );
+    ajouter_element( automate->alphabet, (unsigned char) lettre );
 }
 
 void ajouter_transition( Automate * automate,
@@ -157,6 +205,7 @@ void ajouter_transition( Automate * automate,
 			 char lettre,
 			 int fin
 			 ){
+    verifier_non_gele( automate );
     ajouter_etat( automate, origine );
     ajouter_etat( automate, fin );
     ajouter_lettre( automate, lettre );
@@ -177,11 +226,157 @@ void ajouter_transition( Automate * automate,
     ajouter_element( ens, fin );
 }
 
+typedef struct {
+    int origine;
+    int lettre;
+    int fin;
+} Transition_bloc;
+
+/* Les transitions sont triées dans l'ordre de la table des transitions
+ * (voir comparer_cle()), puis par état d'arrivée.
+ */
+static int comparer_transitions_bloc( const void * a, const void * b ){
+    const Transition_bloc * x = (const Transition_bloc *) a;
+    const Transition_bloc * y = (const Transition_bloc *) b;
+    if( x->origine != y->origine )
+	return ( x->origine > y->origine ) - ( x->origine < y->origine );
+    if( x->lettre != y->lettre )
+	return x->lettre - y->lettre;
+    return ( x->fin > y->fin ) - ( x->fin < y->fin );
+}
+
+/* Trie des entiers par un tri par base (quatre passes d'un octet), puis
+ * retire les doublons. Renvoie le nombre d'éléments restants.
+ */
+static size_t trier_elements_bloc( intptr_t * elements, size_t nb ){
+    intptr_t * tampon = xmalloc_etiquete(
+	( nb + 1 ) * sizeof(intptr_t), ALLOCATION_AUTOMATE );
+    intptr_t * source = elements, * destination = tampon, * echange;
+    size_t compteurs[257], i, res = 0;
+    int passe, c;
+
+    for( passe = 0; passe < 4; passe++ ){
+	memset( compteurs, 0, sizeof(compteurs) );
+	for( i = 0; i < nb; i++ ){
+	    // On inverse le bit de signe pour ranger les négatifs en premier.
+	    uint32_t cle = (uint32_t) source[i] ^ 0x80000000u;
+	    compteurs[ ( ( cle >> ( 8 * passe ) ) & 255 ) + 1 ]++;
+	}
+	for( c = 0; c < 256; c++ )
+	    compteurs[c+1] += compteurs[c];
+	for( i = 0; i < nb; i++ ){
+	    uint32_t cle = (uint32_t) source[i] ^ 0x80000000u;
+	    destination[ compteurs[ ( cle >> ( 8 * passe ) ) & 255 ]++ ] = source[i];
+	}
+	echange = source;
+	source = destination;
+	destination = echange;
+    }
+    // Après un nombre pair de passes, le résultat est dans 'elements'.
+    for( i = 0; i < nb; i++ ){
+	if( res == 0 || elements[i] != elements[res-1] )
+	    elements[res++] = elements[i];
+    }
+    xfree( tampon );
+    return res;
+}
+
+/* Quand l'automate n'a pas encore de transition, les transitions sont triées
+ * (si elles ne le sont pas déjà), puis les ensembles d'états, l'alphabet et
+ * la table des transitions sont construits directement à partir des
+ * tableaux triés (voir add_table_triee()).
+ */
+void ajouter_transitions_en_bloc( Automate * automate,
+				  const int * origines,
+				  const char * lettres,
+				  const int * fins,
+				  size_t nb
+				  ){
+    Transition_bloc * transitions;
+    intptr_t * elements, * cles, * valeurs;
+    Cle * contenus_cles;
+    int lettres_presentes[256];
+    size_t i, j, nb_elements, nb_cles;
+    int triees = 1, c;
+
+    verifier_non_gele( automate );
+    if( ! iterateur_est_vide( premier_iterateur_table( automate->transitions ) ) ){
+	for( i = 0; i < nb; i++ )
+	    ajouter_transition( automate, origines[i], lettres[i], fins[i] );
+	return;
+    }
+
+    transitions = xmalloc_etiquete(
+	( nb + 1 ) * sizeof(Transition_bloc), ALLOCATION_AUTOMATE );
+    for( i = 0; i < nb; i++ ){
+	transitions[i].origine = origines[i];
+	transitions[i].lettre = (unsigned char) lettres[i];
+	transitions[i].fin = fins[i];
+	if( i > 0 && comparer_transitions_bloc( transitions + i - 1, transitions + i ) > 0 )
+	    triees = 0;
+    }
+    if( ! triees )
+	qsort( transitions, nb, sizeof(Transition_bloc), comparer_transitions_bloc );
+
+    elements = xmalloc_etiquete(
+	( 2 * nb + 1 ) * sizeof(intptr_t), ALLOCATION_AUTOMATE );
+    for( i = 0; i < nb; i++ ){
+	elements[2*i] = transitions[i].origine;
+	elements[2*i+1] = transitions[i].fin;
+    }
+    nb_elements = trier_elements_bloc( elements, 2 * nb );
+    ajouter_elements_tries( automate->etats, elements, nb_elements );
+
+    memset( lettres_presentes, 0, sizeof(lettres_presentes) );
+    for( i = 0; i < nb; i++ )
+	lettres_presentes[ transitions[i].lettre ] = 1;
+    nb_elements = 0;
+    for( c = 0; c < 256; c++ ){
+	if( lettres_presentes[c] )
+	    elements[ nb_elements++ ] = c;
+    }
+    ajouter_elements_tries( automate->alphabet, elements, nb_elements );
+
+    contenus_cles = xmalloc_etiquete(
+	( nb + 1 ) * sizeof(Cle), ALLOCATION_AUTOMATE );
+    cles = xmalloc_etiquete(
+	( nb + 1 ) * sizeof(intptr_t), ALLOCATION_AUTOMATE );
+    valeurs = xmalloc_etiquete(
+	( nb + 1 ) * sizeof(intptr_t), ALLOCATION_AUTOMATE );
+    nb_cles = 0;
+    for( i = 0; i < nb; i = j ){
+	Ensemble * ens = creer_ensemble( NULL, NULL, NULL );
+	nb_elements = 0;
+	for( j = i;
+	     j < nb
+		 && transitions[j].origine == transitions[i].origine
+		 && transitions[j].lettre == transitions[i].lettre;
+	     j++ ){
+	    if( j == i || transitions[j].fin != transitions[j-1].fin )
+		elements[ nb_elements++ ] = transitions[j].fin;
+	}
+	ajouter_elements_tries( ens, elements, nb_elements );
+	initialiser_cle( contenus_cles + nb_cles,
+			 transitions[i].origine, transitions[i].lettre );
+	cles[ nb_cles ] = (intptr_t) ( contenus_cles + nb_cles );
+	valeurs[ nb_cles ] = (intptr_t) ens;
+	nb_cles++;
+    }
+    add_table_triee( automate->transitions, cles, valeurs, nb_cles );
+
+    xfree( valeurs );
+    xfree( cles );
+    xfree( contenus_cles );
+    xfree( elements );
+    xfree( transitions );
+}
+
 /* On test si l'etat fait ne fais pas déjà partie de l'automate.
  * Dans ce cas on l'ajoute à l'ensemble des états de l'automate
  * puis on le rend final.
  */
 void ajouter_etat_final( Automate * automate, int etat_final ){
+    verifier_non_gele( automate );
     if ( !est_un_etat_de_l_automate( automate, etat_final ))
 	ajouter_etat( automate, etat_final );
     ajouter_element( automate->finaux, etat_final );
@@ -192,6 +387,7 @@ void ajouter_etat_final( Automate * automate, int etat_final ){
  * puis on le rend initial.
  */
 void ajouter_etat_initial( Automate * automate, int etat_initial ){
+    verifier_non_gele( automate );
     if ( !est_un_etat_de_l_automate( automate, etat_initial ))
 	ajouter_etat( automate, etat_initial );
     ajouter_element( automate->initiaux, etat_initial );
@@ -228,6 +424,24 @@ Ensemble * delta( const Automate * automate,
     Ensemble * res = creer_ensemble( NULL, NULL, NULL );
     Ensemble_iterateur it;
 
+    if( automate->index ){
+	const Index_automate * index = automate->index;
+	for( it = premier_iterateur_ensemble( etats_courants );
+	     ! iterateur_ensemble_est_vide( it );
+	     it = iterateur_suivant_ensemble( it )
+	     ){
+	    int i = indice_etat( index, get_element( it ) ), t;
+	    if( i < 0 ) continue;
+	    for( t = index->debut[i]; t < index->debut[i+1]; t++ ){
+		if( index->lettres[t] == lettre )
+		    ajouter_element( res, index->noms[ index->fins[t] ] );
+		else if( (unsigned char) index->lettres[t] > (unsigned char) lettre )
+		    break;
+	    }
+	}
+	return res;
+    }
+
     for( it = premier_iterateur_ensemble( etats_courants );
 	 ! iterateur_ensemble_est_vide( it );
 	 it = iterateur_suivant_ensemble( it )
@@ -416,94 +630,56 @@ Automate * mot_to_automate( const char * mot ){
     return nouvel_automate;
 }
 
-/* On procède en considérant successivement tous les voisins
- * de l'état 'e' donné en paramètre, puis les voisins de ses voisins et
- * ainsi de suite. On obtiendra à la fin du procédé, un ensemble contenant
- * tous les états accessibles à partir de l'état de depart 'e'.
+/* Parcours en largeur depuis l'état 'etat' : chaque état atteint pour la
+ * première fois est ajouté au résultat et placé dans la file, puis ses
+ * voisins par chaque lettre sont examinés quand il en sort. Chaque état
+ * accessible est traité une seule fois.
  */
 Ensemble * etats_accessibles( const Automate * automate, int etat ){
     Ensemble * res = creer_ensemble( NULL, NULL, NULL );
-    Ensemble_iterateur it;
-    ajouter_element( res, etat);
-
-    it = premier_iterateur_ensemble( automate->alphabet );
-    while (! iterateur_ensemble_est_vide( it )){
-	Ensemble * voisins = delta( automate, res, get_element( it ));
-
-	// Si res inter voisins = voisins on a pas besoin d'ajouter
-	// d'éléments.
-	if( comparer_ensemble( creer_intersection_ensemble(res, voisins),
-			       voisins) == 0 ){
-	    it = iterateur_suivant_ensemble( it );
-	}
-	// Sinon on ajoute le(s) élément(s) et on repart au début
-	// de l'alphabet.
-	else {
-	    ajouter_elements( res, voisins );
-	    it = premier_iterateur_ensemble( automate->alphabet );
+    Fifo * file = creer_fifo();
+    Ensemble_iterateur it1, it2;
+
+    ajouter_element( res, etat );
+    ajouter_fifo( file, etat );
+    while( ! est_vide( file ) ){
+	int origine = retirer_fifo( file );
+	for( it1 = premier_iterateur_ensemble( automate->alphabet );
+	     ! iterateur_ensemble_est_vide( it1 );
+	     it1 = iterateur_suivant_ensemble( it1 )
+	     ){
+	    const Ensemble * fins =
+		voisins( automate, origine, get_element( it1 ) );
+	    for( it2 = premier_iterateur_ensemble( fins );
+		 ! iterateur_ensemble_est_vide( it2 );
+		 it2 = iterateur_suivant_ensemble( it2 )
+		 ){
+		int fin = get_element( it2 );
+		if( ! est_dans_l_ensemble( res, fin ) ){
+		    ajouter_element( res, fin );
+		    ajouter_fifo( file, fin );
+		}
+	    }
 	}
     }
+    liberer_fifo( file );
     return res;
 }
 
-/* On crée un nouvel automate, dont on ne recopiera que les états
- * accessibles et les transitions qui n'ont pas de lien avec des états
- * non accessibles.
+/* Les états accessibles sont calculés par un parcours en largeur de
+ * l'index de l'automate, puis on ne recopie que ces états et les
+ * transitions entre eux. Les états initiaux sont tous accessibles et
+ * l'alphabet n'est pas copié : l'ajout des transitions assure l'ajout des
+ * lettres concernées (on peut avoir le cas d'une réduction de l'alphabet
+ * lors de la construction d'un automate plus petit).
  */
 Automate * automate_accessible( const Automate * automate){
-    Automate * res = creer_automate();
-    Ensemble * accessibles = creer_ensemble(NULL, NULL, NULL);
-    Ensemble * tmp;
-    Ensemble_iterateur it1;
-    Table_iterateur it2;
-	
-    // On met à jour la variable 'accessibles' qui contient tous les
-    // états accessibles depuis chaque état initial.
-    for ( it1 = premier_iterateur_ensemble( get_initiaux( automate ));
-	  ! iterateur_ensemble_est_vide( it1 );
-	  it1 = iterateur_suivant_ensemble( it1 )
-	  ){
-	tmp = etats_accessibles(automate, get_element( it1 ));
-	ajouter_elements(accessibles, tmp);
-    }
-
-    // On met à jour les données de notre nouvel automate :
-    // - même états initiaux
-    // - l'ensemble des états, et celui des états finaux correspondent
-    // aux ensembles de celui de l'ancien automate, intersecté
-    // avec l'ensemble des états accessibles.
-    // - l'alphabet n'est pas copié car l'ajout de transition, assure
-    // l'ajout des lettres concernés. (on peut avoir le cas d'une réduction
-    // de l'alphabet lors de la construction d'un automate plus petit).
-	
-    res->vide = creer_ensemble( NULL, NULL, NULL);
-    //ajouter_elements(res->alphabet, get_alphabet( automate ));
-    ajouter_elements(res->initiaux, get_initiaux( automate )); 
-    ajouter_elements(res->etats, 
-		     creer_intersection_ensemble( get_etats(automate),
-						  accessibles));
-    ajouter_elements(res->finaux, 
-		     creer_intersection_ensemble( get_finaux(automate),
-						  accessibles));
-
-    // On met à jour les transitions : il faut que l'état d'origine et
-    // l'état d'arrivé soient tous deux accessibles.
-    for ( it2 = premier_iterateur_table( automate->transitions );
-	  ! iterateur_ensemble_est_vide( it2 );
-	  it2 = iterateur_suivant_ensemble( it2 )
-	  ){
-	Cle * cle = (Cle*) get_cle( it2 );
-	Ensemble * fins = (Ensemble*) get_valeur( it2 );
-	for( it1 = premier_iterateur_ensemble( fins );
-	     ! iterateur_ensemble_est_vide( it1 );
-	     it1 = iterateur_suivant_ensemble( it1 )
-	     ){
-	    int fin = get_element( it1 );
-	    if (est_dans_l_ensemble(accessibles, cle->origine) &&
-		est_dans_l_ensemble(accessibles, fin))
-		ajouter_transition(res, cle->origine, cle->lettre, fin);
-	}
-    }
+    Index_automate * index = creer_index_automate( automate );
+    uint64_t * accessibles = etats_accessibles_index( index, NULL, 1 );
+    Automate * res = restreindre_automate( index, accessibles, 0 );
+
+    xfree( accessibles );
+    liberer_index_automate( index );
     return res;
 }
 
@@ -540,11 +716,17 @@ Automate * miroir( const Automate * automate){
     return res;
 }
  
-/* On calcule le miroir de l'automate dont tous les etats sont accessibles, et 
- * on le renverse une deuxième fois. 
+/* Comme pour automate_accessible(), mais le parcours part des états
+ * finaux et remonte les transitions : tous les états finaux sont gardés.
  */
 Automate * automate_co_accessible( const Automate * automate){
-    return miroir( automate_accessible( miroir( automate )));
+    Index_automate * index = creer_index_automate( automate );
+    uint64_t * co_accessibles = etats_co_accessibles_index( index, NULL, 1 );
+    Automate * res = restreindre_automate( index, co_accessibles, 0 );
+
+    xfree( co_accessibles );
+    liberer_index_automate( index );
+    return res;
 }
 
 /* L'automate des préfixes correspond à l'automate dont tous les états
@@ -583,7 +765,12 @@ Automate * creer_automate_des_sur_mot( const Automate* automate, Ensemble * alph
   int e;
   Ensemble_iterateur it1, it2;
 	
-  ajouter_elements(res->alphabet, alphabet);
+  for( it1 = premier_iterateur_ensemble( alphabet );
+       ! iterateur_ensemble_est_vide( it1 );
+       it1 = iterateur_suivant_ensemble( it1 )
+       ){
+      ajouter_lettre( res, (char) get_element( it1 ) );
+  }
   
   for( it1 = premier_iterateur_ensemble( get_etats( res ) );
        ! iterateur_ensemble_est_vide( it1 );
@@ -794,28 +981,518 @@ Automate * creer_automate_des_sous_mots( const Automate* automate ){
     return res;
 }
 
+/* Le mélange est construit sur le produit Q1 x Q2 : depuis l'état (p,q), la
+ * lettre l mène en (p',q) pour toute transition (p,l)->p' de l'automate1 et
+ * en (p,q') pour toute transition (q,l)->q' de l'automate2. Les états
+ * initiaux sont I1 x I2 et les finaux F1 x F2.
+ *
+ * Comme Q1 x Q2 devient vite énorme, on ne crée que les couples accessibles
+ * depuis les couples initiaux. Chaque couple est codé dans une clé de 64 bits
+ * et une table de hachage lui associe son numéro dans le nouvel automate.
+ * Les couples sont numérotés dans l'ordre où on les découvre : le tableau
+ * 'paires' sert donc aussi de file des couples restant à traiter.
+ */
+typedef struct {
+    Automate * res;
+    Table_hachage * numeros;
+    uint64_t * paires;
+    int nb_paires;
+    int capacite;
+    int nb_etats_max;
+} Donnees_produit;
+
+static void initialiser_donnees_produit( Donnees_produit * d, int nb_etats_max,
+					 int construire
+					 ){
+    d->res = construire ? creer_automate() : NULL;
+    d->numeros = creer_table_hachage( 0 );
+    d->capacite = 16;
+    d->paires = xmalloc_etiquete(
+	d->capacite * sizeof(uint64_t), ALLOCATION_AUTOMATE );
+    d->nb_paires = 0;
+    d->nb_etats_max = nb_etats_max;
+}
+
+static void liberer_donnees_produit( Donnees_produit * d ){
+    liberer_table_hachage( d->numeros );
+    xfree( d->paires );
+}
+
+/* Renvoie le numéro du couple (p,q), en créant l'état s'il n'existe pas.
+ * Renvoie -1 si la création dépasse le nombre d'états autorisé.
+ * Si aucun automate n'est construit ('res' vaut NULL), seul le numéro est
+ * attribué.
+ */
+static int numero_paire( Donnees_produit * d, int p, int q ){
+    int nouveau;
+    uint64_t cle = CLE_PAIRE( p, q );
+    intptr_t * numero = sonder_table_hachage( d->numeros, cle, &nouveau );
+    if( nouveau ){
+	if( d->nb_etats_max > 0 && d->nb_paires >= d->nb_etats_max )
+	    return -1;
+	if( d->nb_paires == d->capacite ){
+	    uint64_t * tmp = xmalloc_etiquete(
+		2 * d->capacite * sizeof(uint64_t), ALLOCATION_AUTOMATE );
+	    memcpy( tmp, d->paires, d->capacite * sizeof(uint64_t) );
+	    xfree( d->paires );
+	    d->paires = tmp;
+	    d->capacite *= 2;
+	}
+	*numero = d->nb_paires;
+	d->paires[ d->nb_paires++ ] = cle;
+	if( d->res ) ajouter_etat( d->res, *numero );
+    }
+    return *numero;
+}
+
+Automate * creer_automate_du_melange_borne( const Automate* automate1,
+					    const Automate* automate2,
+					    int nb_etats_max
+					    ){
+    Donnees_produit d;
+    Ensemble_iterateur it1, it2, it3;
+    int courant;
+
+    initialiser_donnees_produit( &d, nb_etats_max, 1 );
+    ajouter_elements( d.res->alphabet, automate1->alphabet );
+    ajouter_elements( d.res->alphabet, automate2->alphabet );
+
+    for( it1 = premier_iterateur_ensemble( automate1->initiaux );
+	 ! iterateur_ensemble_est_vide( it1 );
+	 it1 = iterateur_suivant_ensemble( it1 )
+	 ){
+	for( it2 = premier_iterateur_ensemble( automate2->initiaux );
+	     ! iterateur_ensemble_est_vide( it2 );
+	     it2 = iterateur_suivant_ensemble( it2 )
+	     ){
+	    int e = numero_paire( &d, get_element( it1 ), get_element( it2 ) );
+	    if( e < 0 ) goto depassement;
+	    ajouter_element( d.res->initiaux, e );
+	}
+    }
+
+    for( courant = 0; courant < d.nb_paires; courant++ ){
+	int p = PREMIER_PAIRE( d.paires[courant] );
+	int q = SECOND_PAIRE( d.paires[courant] );
+
+	if( est_un_etat_final_de_l_automate( automate1, p ) &&
+	    est_un_etat_final_de_l_automate( automate2, q ) )
+	    ajouter_element( d.res->finaux, courant );
+
+	// On avance dans le premier automate ...
+	for( it1 = premier_iterateur_ensemble( automate1->alphabet );
+	     ! iterateur_ensemble_est_vide( it1 );
+	     it1 = iterateur_suivant_ensemble( it1 )
+	     ){
+	    char lettre = get_element( it1 );
+	    const Ensemble * fins = voisins( automate1, p, lettre );
+	    for( it3 = premier_iterateur_ensemble( fins );
+		 ! iterateur_ensemble_est_vide( it3 );
+		 it3 = iterateur_suivant_ensemble( it3 )
+		 ){
+		int e = numero_paire( &d, get_element( it3 ), q );
+		if( e < 0 ) goto depassement;
+		ajouter_transition( d.res, courant, lettre, e );
+	    }
+	}
+	// ... ou dans le second.
+	for( it2 = premier_iterateur_ensemble( automate2->alphabet );
+	     ! iterateur_ensemble_est_vide( it2 );
+	     it2 = iterateur_suivant_ensemble( it2 )
+	     ){
+	    char lettre = get_element( it2 );
+	    const Ensemble * fins = voisins( automate2, q, lettre );
+	    for( it3 = premier_iterateur_ensemble( fins );
+		 ! iterateur_ensemble_est_vide( it3 );
+		 it3 = iterateur_suivant_ensemble( it3 )
+		 ){
+		int e = numero_paire( &d, p, get_element( it3 ) );
+		if( e < 0 ) goto depassement;
+		ajouter_transition( d.res, courant, lettre, e );
+	    }
+	}
+    }
+
+    liberer_donnees_produit( &d );
+    return d.res;
+
+ depassement:
+    liberer_donnees_produit( &d );
+    liberer_automate( d.res );
+    return NULL;
+}
+
 Automate * creer_automate_du_melange( const Automate* automate1, const Automate* automate2 ){
-    Automate * res = creer_automate();
-    Automate * A = copier_automate(automate1);
-    Automate * B = creer_automate_etat_different(automate1, automate2);
-	    
-    ajouter_elements(res->etats,
-		     creer_union_ensemble(A->etats, B->etats));
-    ajouter_elements(res->initiaux,
-		     creer_union_ensemble(A->initiaux, B->initiaux));
-    ajouter_elements(res->finaux,
-		     creer_union_ensemble(A->finaux, B->finaux));
-    ajouter_elements(res->alphabet,
-		     creer_union_ensemble(A->alphabet, B->alphabet));
-    ajouter_transitions(res, A->transitions);
-    ajouter_transitions(res, B->transitions);
+    return creer_automate_du_melange_borne( automate1, automate2, 0 );
+}
 
+/* Ajoute le couple (p,q) à l'ensemble de couples codé par la table 'vus' et
+ * le tableau 'paires'.
+ */
+static void ajouter_paire( Table_hachage * vus, uint64_t ** paires,
+			   int * nb, int * capacite, int p, int q
+			   ){
+    int nouveau;
+    uint64_t cle = CLE_PAIRE( p, q );
+    sonder_table_hachage( vus, cle, &nouveau );
+    if( ! nouveau ) return;
+    if( *nb == *capacite ){
+	uint64_t * tmp = xmalloc_etiquete(
+	    2 * (*capacite) * sizeof(uint64_t), ALLOCATION_AUTOMATE );
+	memcpy( tmp, *paires, (*capacite) * sizeof(uint64_t) );
+	xfree( *paires );
+	*paires = tmp;
+	*capacite *= 2;
+    }
+    (*paires)[ (*nb)++ ] = cle;
+}
+
+/* On simule le mélange sans le construire : on maintient l'ensemble des
+ * couples (p,q) atteints après la lecture de chaque préfixe du mot.
+ */
+int le_mot_est_reconnu_par_le_melange( const Automate* automate1,
+				       const Automate* automate2,
+				       const char* mot
+				       ){
+    int cap_courants = 16, cap_suivants = 16;
+    int nb_courants = 0, nb_suivants = 0;
+    uint64_t * courants = xmalloc_etiquete(
+	cap_courants * sizeof(uint64_t), ALLOCATION_AUTOMATE );
+    uint64_t * suivants = xmalloc_etiquete(
+	cap_suivants * sizeof(uint64_t), ALLOCATION_AUTOMATE );
+    Table_hachage * vus = creer_table_hachage( 0 );
+    Ensemble_iterateur it1, it2;
+    int i, res = 0;
+
+    for( it1 = premier_iterateur_ensemble( automate1->initiaux );
+	 ! iterateur_ensemble_est_vide( it1 );
+	 it1 = iterateur_suivant_ensemble( it1 )
+	 ){
+	for( it2 = premier_iterateur_ensemble( automate2->initiaux );
+	     ! iterateur_ensemble_est_vide( it2 );
+	     it2 = iterateur_suivant_ensemble( it2 )
+	     ){
+	    ajouter_paire( vus, &courants, &nb_courants, &cap_courants,
+			   get_element( it1 ), get_element( it2 ) );
+	}
+    }
+
+    for( ; *mot && nb_courants > 0; mot++ ){
+	vider_table_hachage( vus );
+	nb_suivants = 0;
+	for( i = 0; i < nb_courants; i++ ){
+	    int p = PREMIER_PAIRE( courants[i] );
+	    int q = SECOND_PAIRE( courants[i] );
+	    for( it1 = premier_iterateur_ensemble( voisins( automate1, p, *mot ) );
+		 ! iterateur_ensemble_est_vide( it1 );
+		 it1 = iterateur_suivant_ensemble( it1 )
+		 ){
+		ajouter_paire( vus, &suivants, &nb_suivants, &cap_suivants,
+			       get_element( it1 ), q );
+	    }
+	    for( it2 = premier_iterateur_ensemble( voisins( automate2, q, *mot ) );
+		 ! iterateur_ensemble_est_vide( it2 );
+		 it2 = iterateur_suivant_ensemble( it2 )
+		 ){
+		ajouter_paire( vus, &suivants, &nb_suivants, &cap_suivants,
+			       p, get_element( it2 ) );
+	    }
+	}
+	uint64_t * tmp = courants;
+	courants = suivants;
+	suivants = tmp;
+	i = cap_courants;
+	cap_courants = cap_suivants;
+	cap_suivants = i;
+	nb_courants = nb_suivants;
+    }
+
+    for( i = 0; i < nb_courants && ! res; i++ ){
+	res = est_un_etat_final_de_l_automate( automate1, PREMIER_PAIRE( courants[i] ) )
+	    && est_un_etat_final_de_l_automate( automate2, SECOND_PAIRE( courants[i] ) );
+    }
+
+    liberer_table_hachage( vus );
+    xfree( courants );
+    xfree( suivants );
     return res;
 }
 
+/* Le produit de deux automates est lui aussi construit sur les couples
+ * d'états accessibles depuis I1 x I2 : la lettre l mène de (p,q) en (p',q')
+ * pour toute transition (p,l)->p' de l'automate1 et (q,l)->q' de
+ * l'automate2. Seul le choix des couples acceptants dépend du mode.
+ *
+ * Pour l'union et les différences, un mot qui sort de l'un des automates
+ * doit continuer à être lu par l'autre : on complète alors l'automate
+ * concerné par un état puits PUITS (qui n'est jamais final). Le couple
+ * (PUITS, PUITS) n'est jamais acceptant et n'est donc pas créé.
+ */
+#define PUITS INT_MIN
+
+static int completer_automate1( Mode_produit mode ){
+    return mode == PRODUIT_UNION || mode == PRODUIT_DIFFERENCE_SYMETRIQUE;
+}
+
+static int completer_automate2( Mode_produit mode ){
+    return mode != PRODUIT_INTERSECTION;
+}
+
+static int combiner_acceptation( int final1, int final2, Mode_produit mode ){
+    switch( mode ){
+    case PRODUIT_INTERSECTION :
+	return final1 && final2;
+    case PRODUIT_UNION :
+	return final1 || final2;
+    case PRODUIT_DIFFERENCE :
+	return final1 && ! final2;
+    case PRODUIT_DIFFERENCE_SYMETRIQUE :
+	return final1 != final2;
+    }
+    return 0;
+}
+
+/* Le complémentaire n'est calculable sur les couples d'états que si
+ * l'automate complémenté est déterministe.
+ */
+static void verifier_mode_produit( const Automate* automate1,
+				   const Automate* automate2,
+				   Mode_produit mode
+				   ){
+    if( mode == PRODUIT_DIFFERENCE_SYMETRIQUE && ! est_deterministe( automate1 ) ){
+	ERREUR( "La difference symetrique demande des automates deterministes" );
+    }
+    if( ( mode == PRODUIT_DIFFERENCE || mode == PRODUIT_DIFFERENCE_SYMETRIQUE )
+	&& ! est_deterministe( automate2 ) ){
+	ERREUR( "La difference demande un second automate deterministe" );
+    }
+}
+
+/* Explore les couples accessibles du produit. Si un automate est en cours de
+ * construction dans 'd', les états finaux et les transitions y sont ajoutés.
+ * Sinon, l'exploration s'arrête au premier couple acceptant.
+ * Renvoie 1 si un couple acceptant a été trouvé, 0 sinon, et -1 si le
+ * nombre d'états autorisé a été dépassé.
+ */
+static int explorer_produit( const Automate* automate1,
+			     const Automate* automate2,
+			     Mode_produit mode,
+			     Donnees_produit * d
+			     ){
+    Ensemble * alphabet = creer_union_ensemble( automate1->alphabet,
+						automate2->alphabet );
+    Ensemble * puits = creer_ensemble( NULL, NULL, NULL );
+    Ensemble_iterateur it1, it2, it3;
+    int courant, trouve = 0;
+
+    ajouter_element( puits, PUITS );
+    if( d->res ) ajouter_elements( d->res->alphabet, alphabet );
+
+    for( it1 = premier_iterateur_ensemble( automate1->initiaux );
+	 ! iterateur_ensemble_est_vide( it1 );
+	 it1 = iterateur_suivant_ensemble( it1 )
+	 ){
+	for( it2 = premier_iterateur_ensemble( automate2->initiaux );
+	     ! iterateur_ensemble_est_vide( it2 );
+	     it2 = iterateur_suivant_ensemble( it2 )
+	     ){
+	    int e = numero_paire( d, get_element( it1 ), get_element( it2 ) );
+	    if( e < 0 ) goto depassement;
+	    if( d->res ) ajouter_element( d->res->initiaux, e );
+	}
+    }
+    if( iterateur_ensemble_est_vide( premier_iterateur_ensemble( automate1->initiaux ) )
+	&& completer_automate1( mode ) ){
+	for( it2 = premier_iterateur_ensemble( automate2->initiaux );
+	     ! iterateur_ensemble_est_vide( it2 );
+	     it2 = iterateur_suivant_ensemble( it2 )
+	     ){
+	    int e = numero_paire( d, PUITS, get_element( it2 ) );
+	    if( e < 0 ) goto depassement;
+	    if( d->res ) ajouter_element( d->res->initiaux, e );
+	}
+    }
+    if( iterateur_ensemble_est_vide( premier_iterateur_ensemble( automate2->initiaux ) )
+	&& completer_automate2( mode ) ){
+	for( it1 = premier_iterateur_ensemble( automate1->initiaux );
+	     ! iterateur_ensemble_est_vide( it1 );
+	     it1 = iterateur_suivant_ensemble( it1 )
+	     ){
+	    int e = numero_paire( d, get_element( it1 ), PUITS );
+	    if( e < 0 ) goto depassement;
+	    if( d->res ) ajouter_element( d->res->initiaux, e );
+	}
+    }
+
+    for( courant = 0; courant < d->nb_paires; courant++ ){
+	int p = PREMIER_PAIRE( d->paires[courant] );
+	int q = SECOND_PAIRE( d->paires[courant] );
+
+	if( combiner_acceptation( est_un_etat_final_de_l_automate( automate1, p ),
+				  est_un_etat_final_de_l_automate( automate2, q ),
+				  mode ) ){
+	    if( ! d->res ){
+		trouve = 1;
+		break;
+	    }
+	    ajouter_element( d->res->finaux, courant );
+	}
+
+	for( it1 = premier_iterateur_ensemble( alphabet );
+	     ! iterateur_ensemble_est_vide( it1 );
+	     it1 = iterateur_suivant_ensemble( it1 )
+	     ){
+	    char lettre = get_element( it1 );
+	    const Ensemble * fins1 = voisins( automate1, p, lettre );
+	    const Ensemble * fins2 = voisins( automate2, q, lettre );
+	    int vide1 = iterateur_ensemble_est_vide( premier_iterateur_ensemble( fins1 ) );
+	    int vide2 = iterateur_ensemble_est_vide( premier_iterateur_ensemble( fins2 ) );
+
+	    if( vide1 && vide2 ) continue;
+	    if( vide1 ){
+		if( ! completer_automate1( mode ) ) continue;
+		fins1 = puits;
+	    }
+	    if( vide2 ){
+		if( ! completer_automate2( mode ) ) continue;
+		fins2 = puits;
+	    }
+	    for( it2 = premier_iterateur_ensemble( fins1 );
+		 ! iterateur_ensemble_est_vide( it2 );
+		 it2 = iterateur_suivant_ensemble( it2 )
+		 ){
+		for( it3 = premier_iterateur_ensemble( fins2 );
+		     ! iterateur_ensemble_est_vide( it3 );
+		     it3 = iterateur_suivant_ensemble( it3 )
+		     ){
+		    int e = numero_paire( d, get_element( it2 ), get_element( it3 ) );
+		    if( e < 0 ) goto depassement;
+		    if( d->res ) ajouter_transition( d->res, courant, lettre, e );
+		}
+	    }
+	}
+    }
+
+    liberer_ensemble( puits );
+    liberer_ensemble( alphabet );
+    return trouve;
+
+ depassement:
+    liberer_ensemble( puits );
+    liberer_ensemble( alphabet );
+    return -1;
+}
+
+Automate * creer_automate_produit_borne( const Automate* automate1,
+					 const Automate* automate2,
+					 Mode_produit mode,
+					 int nb_etats_max
+					 ){
+    Donnees_produit d;
+
+    verifier_mode_produit( automate1, automate2, mode );
+    initialiser_donnees_produit( &d, nb_etats_max, 1 );
+    if( explorer_produit( automate1, automate2, mode, &d ) < 0 ){
+	liberer_automate( d.res );
+	d.res = NULL;
+    }
+    liberer_donnees_produit( &d );
+    return d.res;
+}
+
+Automate * creer_automate_produit( const Automate* automate1,
+				   const Automate* automate2,
+				   Mode_produit mode
+				   ){
+    return creer_automate_produit_borne( automate1, automate2, mode, 0 );
+}
+
+int le_produit_est_vide( const Automate* automate1,
+			 const Automate* automate2,
+			 Mode_produit mode
+			 ){
+    Donnees_produit d;
+    int res;
+
+    verifier_mode_produit( automate1, automate2, mode );
+    initialiser_donnees_produit( &d, 0, 0 );
+    res = explorer_produit( automate1, automate2, mode, &d );
+    liberer_donnees_produit( &d );
+    return res == 0;
+}
+
+static int contient_un_final( const Automate * automate, const Ensemble * etats ){
+    Ensemble_iterateur it;
+    for( it = premier_iterateur_ensemble( etats );
+	 ! iterateur_ensemble_est_vide( it );
+	 it = iterateur_suivant_ensemble( it )
+	 ){
+	if( est_un_etat_final_de_l_automate( automate, get_element( it ) ) )
+	    return 1;
+    }
+    return 0;
+}
+
+/* On lit le mot une seule fois en faisant avancer en même temps les états
+ * courants des deux automates. La lecture s'arrête dès que plus aucun
+ * couple ne peut être acceptant. Comme on manipule des ensembles d'états,
+ * les automates n'ont pas besoin d'être déterministes.
+ */
+int le_mot_est_reconnu_par_le_produit( const Automate* automate1,
+				       const Automate* automate2,
+				       const char* mot,
+				       Mode_produit mode
+				       ){
+    Ensemble * etats1 = copier_ensemble( automate1->initiaux );
+    Ensemble * etats2 = copier_ensemble( automate2->initiaux );
+    int res;
+
+    for( ; *mot; mot++ ){
+	int vide1 = iterateur_ensemble_est_vide( premier_iterateur_ensemble( etats1 ) );
+	int vide2 = iterateur_ensemble_est_vide( premier_iterateur_ensemble( etats2 ) );
+	if( vide1 && ( vide2 || ! completer_automate1( mode ) ) ) break;
+	if( vide2 && mode == PRODUIT_INTERSECTION ) break;
+	deplacer_ensemble( etats1, delta( automate1, etats1, *mot ) );
+	deplacer_ensemble( etats2, delta( automate2, etats2, *mot ) );
+    }
+    res = ( *mot == '\0' )
+	&& combiner_acceptation( contient_un_final( automate1, etats1 ),
+				 contient_un_final( automate2, etats2 ),
+				 mode );
+    liberer_ensemble( etats1 );
+    liberer_ensemble( etats2 );
+    return res;
+}
+
+/* Un automate est déterministe s'il a au plus un état initial et si chaque
+ * couple (origine, lettre) mène à au plus un état.
+ */
+int est_deterministe( const Automate* automate ){
+    Table_iterateur it;
+    if( taille_ensemble( automate->initiaux ) > 1 ) return 0;
+    for( it = premier_iterateur_table( automate->transitions );
+	 ! iterateur_est_vide( it );
+	 it = iterateur_suivant_table( it )
+	 ){
+	if( taille_ensemble( (Ensemble*) get_valeur( it ) ) > 1 ) return 0;
+    }
+    return 1;
+}
+
 int est_une_transition_de_l_automate( const Automate* automate,
 				      int origine, char lettre, int fin
 				      ){
+    if( automate->index ){
+	const Index_automate * index = automate->index;
+	int i = indice_etat( index, origine ), j = indice_etat( index, fin ), t;
+	if( i < 0 || j < 0 ) return 0;
+	for( t = index->debut[i]; t < index->debut[i+1]; t++ ){
+	    if( (unsigned char) index->lettres[t] > (unsigned char) lettre )
+		break;
+	    if( index->lettres[t] == lettre && index->fins[t] == j ) return 1;
+	}
+	return 0;
+    }
     return est_dans_l_ensemble( voisins( automate, origine, lettre ), fin );
 }
 
@@ -832,7 +1509,7 @@ int est_un_etat_final_de_l_automate( const Automate * automate, int etat ){
 }
 
 int est_une_lettre_de_l_automate( const Automate * automate, char lettre ){
-    return est_dans_l_ensemble( get_alphabet( automate ), lettre);
+    return est_dans_l_ensemble( get_alphabet( automate ), (unsigned char) lettre);
 }
 
 void print_ensemble_2( const intptr_t ens ){
@@ -862,7 +1539,68 @@ void print_automate( const Automate * automate ){
     printf("\n");
 }
 
+/* La lecture d'un mot par un automate gelé. Un automate déterministe est
+ * parcouru sans allocation ; sinon, les états atteints sont rangés dans deux
+ * listes, et un ensemble de bits évite les doublons.
+ */
+static int le_mot_est_reconnu_par_l_index( const Automate* automate,
+					   const char* mot
+					   ){
+    const Index_automate * index = automate->index;
+    int * courants, * suivants, * echange;
+    uint64_t * marques;
+    int nb_courants = 0, nb_suivants, i, k, t, res = 0;
+
+    if( automate->indice_initial >= 0 ){
+	i = automate->indice_initial;
+	if( i == index->nb_etats ) return 0;
+	for( ; *mot && i >= 0; mot++ )
+	    i = transition_index( index, i, *mot );
+	return i >= 0 && TESTER_BIT( index->finaux, i );
+    }
+
+    courants = xmalloc( ( 2 * (size_t) index->nb_etats + 1 ) * sizeof(int) );
+    suivants = courants + index->nb_etats;
+    marques = xmalloc( ( NB_MOTS_BITS( index->nb_etats ) + 1 ) * sizeof(uint64_t) );
+    memset( marques, 0, ( NB_MOTS_BITS( index->nb_etats ) + 1 ) * sizeof(uint64_t) );
+    for( i = 0; i < index->nb_etats; i++ )
+	if( TESTER_BIT( index->initiaux, i ) )
+	    courants[ nb_courants++ ] = i;
+    for( ; *mot && nb_courants > 0; mot++ ){
+	nb_suivants = 0;
+	for( k = 0; k < nb_courants; k++ ){
+	    i = courants[k];
+	    for( t = index->debut[i]; t < index->debut[i+1]; t++ ){
+		int fin = index->fins[t];
+		if( index->lettres[t] != *mot ){
+		    if( (unsigned char) index->lettres[t] > (unsigned char) *mot )
+			break;
+		    continue;
+		}
+		if( ! TESTER_BIT( marques, fin ) ){
+		    MARQUER_BIT( marques, fin );
+		    suivants[ nb_suivants++ ] = fin;
+		}
+	    }
+	}
+	for( k = 0; k < nb_suivants; k++ )
+	    marques[ suivants[k] >> 6 ] = 0;
+	echange = courants;
+	courants = suivants;
+	suivants = echange;
+	nb_courants = nb_suivants;
+    }
+    for( k = 0; k < nb_courants; k++ )
+	if( TESTER_BIT( index->finaux, courants[k] ) )
+	    res = 1;
+    xfree( courants < suivants ? courants : suivants );
+    xfree( marques );
+    return res;
+}
+
 int le_mot_est_reconnu( const Automate* automate, const char* mot ){
+    if( automate->index )
+	return le_mot_est_reconnu_par_l_index( automate, mot );
     Ensemble * accessible = delta_star( automate, get_initiaux( automate ), mot);
     return (taille_ensemble
 	    (creer_intersection_ensemble
@@ -874,10 +1612,12 @@ int le_mot_est_reconnu( const Automate* automate, const char* mot ){
  */
 void supprimer_etat(Automate * automate, int etat){
     // on maintient un ensemble des transitions à supprimer.
-    Ensemble * trans_a_suppr = creer_ensemble(NULL, NULL, NULL);
+    Ensemble * trans_a_suppr;
     Table_iterateur it1;
     Ensemble_iterateur it2;
 
+    verifier_non_gele( automate );
+    trans_a_suppr = creer_ensemble(NULL, NULL, NULL);
     retirer_element(automate->etats, etat);
     retirer_element(automate->initiaux, etat);
     retirer_element(automate->finaux, etat);
@@ -31,6 +31,8 @@
  * états sont des entiers codés par le 
  * type int. Les lettres sont codées par le type char, et l'automate n'accepte 
  * pas d'epsilon transition.
+ * Les lettres sont des octets : elles sont ordonnées comme des unsigned char,
+ * y compris quand le type char est signé.
  * L'automate codé, peut avoir plusieurs états initiaux.
  * 
  */
@@ -50,6 +52,44 @@ Automate * creer_automate();
  */ 
 void liberer_automate( Automate * automate);
 
+/**
+ * \brief Gèle un automate : il ne peut plus être modifié, et plusieurs fils
+ *        d'exécution peuvent le lire en même temps, sans verrou.
+ *
+ * Un automate n'est jamais modifié par les fonctions qui le lisent. Une fois
+ * l'automate gelé, les fonctions qui le modifient (ajouter_etat(),
+ * ajouter_transition(), supprimer_etat(), ...) arrêtent le programme avec
+ * une erreur : les lectures concurrentes sont donc sûres jusqu'à
+ * degeler_automate().
+ *
+ * Le gel construit l'index de l'automate (voir index_automate.h), avec
+ * lequel le_mot_est_reconnu(), delta() et est_une_transition_de_l_automate()
+ * évitent les allocations des recherches dans la table des transitions. Un
+ * automate déterministe gelé reconnaît un mot sans aucune allocation.
+ *
+ * Geler un automate déjà gelé n'a pas d'effet.
+ *
+ * \param automate L'automate à geler
+ */
+void geler_automate( Automate * automate );
+
+/**
+ * \brief Rend un automate gelé de nouveau modifiable, et libère son index.
+ *
+ * Aucun autre fil ne doit lire l'automate pendant l'appel.
+ *
+ * \param automate Un automate
+ */
+void degeler_automate( Automate * automate );
+
+/**
+ * \brief Renvoie 1 si l'automate est gelé et 0 sinon.
+ *
+ * \param automate Un automate
+ * \return 1 ou 0
+ */
+int est_gele( const Automate * automate );
+
 /**
  * \brief Ajoute un état à un automate passé en paramètre.
  *
@@ -81,6 +121,26 @@ void ajouter_transition(
 	Automate * automate, int origine, char lettre, int fin
 );
 
+/**
+ * \brief Ajoute 'nb' transitions d'un coup à l'automate passé en paramètre.
+ *
+ * Le résultat est le même que celui de 'nb' appels à ajouter_transition(),
+ * mais si l'automate n'a encore aucune transition, ses ensembles et sa table
+ * de transitions sont construits directement, en temps O( nb ) si les
+ * transitions sont déjà triées par origine, lettre (comme unsigned char)
+ * puis fin, et en O( nb log nb ) sinon.
+ *
+ * \param automate Un automate
+ * \param origines Les origines des transitions
+ * \param lettres Les lettres des transitions
+ * \param fins Les fins des transitions
+ * \param nb Le nombre de transitions
+ */
+void ajouter_transitions_en_bloc(
+	Automate * automate, const int * origines, const char * lettres,
+	const int * fins, size_t nb
+);
+
 /**
  * \brief Ajoute un état final à un automate passé en paramètre.
  *
@@ -145,6 +205,9 @@ const Ensemble * get_finaux( const Automate* automate );
  *
  * La mémoire de l'ensemble renvoyé est gérée par l'automate.
  *
+ * Les éléments de l'ensemble sont les lettres converties en unsigned char
+ * (entre 0 et 255).
+ *
  * \param automate Un automate
  * \return L'ensmble des lettres de l'automate
  */ 
@@ -441,6 +504,145 @@ Automate * creer_automate_des_sous_mots( const Automate* automate );
   */
 Automate * creer_automate_du_melange( const Automate* automate1,  const Automate* automate2 );
 
+/**
+  * \brief Créer l'automate du mélange en limitant son nombre d'états.
+  *
+  * L'automate du mélange est construit sur le produit des états des deux
+  * automates, mais seuls les couples d'états accessibles depuis les couples
+  * d'états initiaux sont créés. Les états de l'automate renvoyé sont numérotés
+  * à partir de 0 dans l'ordre où ils sont découverts.
+  *
+  * Si la construction demande plus de 'nb_etats_max' états, elle est
+  * abandonnée et la fonction renvoie NULL. Si 'nb_etats_max' vaut 0, le
+  * nombre d'états n'est pas limité (c'est ce que fait
+  * creer_automate_du_melange()).
+  *
+  * \param automate1 Le premier automate
+  * \param automate2 Le deuième automate
+  * \param nb_etats_max Le nombre maximal d'états, ou 0
+  * \return L'auomtate du mélange ou NULL
+  */
+Automate * creer_automate_du_melange_borne(
+	const Automate* automate1, const Automate* automate2, int nb_etats_max
+);
+
+/**
+ * \brief Renvoie 1 si le mot passé en paramètre est reconnu par l'automate du
+ *        mélange des deux automates, et renvoie 0 sinon.
+ *
+ * L'automate du mélange n'est pas construit : la fonction ne manipule que
+ * les couples d'états atteints en lisant le mot.
+ *
+ * \param automate1 Le premier automate
+ * \param automate2 Le deuième automate
+ * \param mot Le mot à reconaître
+ * \return 1 ou 0
+ */
+int le_mot_est_reconnu_par_le_melange(
+	const Automate* automate1, const Automate* automate2, const char* mot
+);
+
+/**
+ * \brief Les différentes façons de combiner les langages de deux automates
+ *        dans un automate produit.
+ *
+ * Si L1 et L2 sont les langages des deux automates, le produit reconnaît :
+ *   - PRODUIT_INTERSECTION : L1 inter L2,
+ *   - PRODUIT_UNION : L1 union L2,
+ *   - PRODUIT_DIFFERENCE : L1 privé de L2,
+ *   - PRODUIT_DIFFERENCE_SYMETRIQUE : ( L1 union L2 ) privé de ( L1 inter L2 ).
+ */
+typedef enum {
+	PRODUIT_INTERSECTION,
+	PRODUIT_UNION,
+	PRODUIT_DIFFERENCE,
+	PRODUIT_DIFFERENCE_SYMETRIQUE
+} Mode_produit;
+
+/**
+ * \brief Renvoie 1 si l'automate est déterministe et 0 sinon.
+ *
+ * Un automate est déterministe s'il possède au plus un état initial et si,
+ * depuis chaque état, chaque lettre mène à au plus un état.
+ *
+ * \param automate Un automate
+ * \return 1 ou 0
+ */
+int est_deterministe( const Automate* automate );
+
+/**
+ * \brief Créer l'automate produit de deux automates.
+ *
+ * Les états du produit sont les couples d'états des deux automates, mais seuls
+ * les couples accessibles depuis les couples d'états initiaux sont créés. Ils
+ * sont numérotés à partir de 0 dans l'ordre où ils sont découverts.
+ *
+ * Pour PRODUIT_DIFFERENCE, le second automate doit être déterministe, et pour
+ * PRODUIT_DIFFERENCE_SYMETRIQUE les deux automates doivent l'être. Le
+ * programme s'arrête avec une erreur sinon.
+ *
+ * \param automate1 Le premier automate
+ * \param automate2 Le deuxième automate
+ * \param mode La façon de combiner les deux langages
+ * \return L'automate produit
+ */
+Automate * creer_automate_produit(
+	const Automate* automate1, const Automate* automate2, Mode_produit mode
+);
+
+/**
+ * \brief Créer l'automate produit de deux automates en limitant son nombre
+ *        d'états.
+ *
+ * Fonctionne comme creer_automate_produit(), mais renvoie NULL si l'automate
+ * produit a plus de 'nb_etats_max' états. Si 'nb_etats_max' vaut 0, le nombre
+ * d'états n'est pas limité.
+ *
+ * \param automate1 Le premier automate
+ * \param automate2 Le deuxième automate
+ * \param mode La façon de combiner les deux langages
+ * \param nb_etats_max Le nombre maximal d'états, ou 0
+ * \return L'automate produit ou NULL
+ */
+Automate * creer_automate_produit_borne(
+	const Automate* automate1, const Automate* automate2, Mode_produit mode,
+	int nb_etats_max
+);
+
+/**
+ * \brief Renvoie 1 si le langage de l'automate produit est vide, et 0 sinon.
+ *
+ * L'automate produit n'est pas construit : les couples d'états sont explorés
+ * à la volée et l'exploration s'arrête au premier couple acceptant.
+ * Les automates doivent être déterministes dans les mêmes cas que pour
+ * creer_automate_produit().
+ *
+ * \param automate1 Le premier automate
+ * \param automate2 Le deuxième automate
+ * \param mode La façon de combiner les deux langages
+ * \return 1 ou 0
+ */
+int le_produit_est_vide(
+	const Automate* automate1, const Automate* automate2, Mode_produit mode
+);
+
+/**
+ * \brief Renvoie 1 si le mot est reconnu par l'automate produit, et 0 sinon.
+ *
+ * L'automate produit n'est pas construit et le mot n'est lu qu'une fois. Les
+ * automates peuvent ici être non déterministes, quel que soit le mode.
+ *
+ * \param automate1 Le premier automate
+ * \param automate2 Le deuxième automate
+ * \param mot Le mot à reconaître
+ * \param mode La façon de combiner les deux langages
+ * \return 1 ou 0
+ */
+int le_mot_est_reconnu_par_le_produit(
+	const Automate* automate1, const Automate* automate2, const char* mot,
+	Mode_produit mode
+);
+
 /**
  * \brief Affiche sur l'entrée standard (stdout) l'automate passé en paramètre
  *
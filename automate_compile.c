@@ -0,0 +1,155 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "automate_compile.h"
+#include "hachage.h"
+#include "outils.h"
+
+#include <string.h>
+#include <sys/mman.h>
+
+#define NB_OCTETS 256
+
+/*
+ * Les transitions sont d'abord rangées par octet (tri stable, donc par état
+ * d'origine pour un même octet). Deux octets sont équivalents si leurs
+ * listes de transitions sont identiques : on compare les listes de même
+ * empreinte.
+ */
+int calculer_classes_octets(
+	const Index_automate * index, unsigned char classes[256]
+){
+	int m = index->nb_transitions;
+	int * ordre = xmalloc( ( m + 1 ) * 2 * sizeof(int) );
+	int debut[NB_OCTETS + 1];
+	uint64_t empreintes[NB_OCTETS];
+	int representants[NB_OCTETS];
+	int nb_classes = 0, premiere_classe = 0;
+	int c, e, t, k;
+
+	memset( debut, 0, sizeof(debut) );
+	for( t = 0; t < m; t++ ) debut[ (unsigned char) index->lettres[t] + 1 ]++;
+	for( c = 0; c < NB_OCTETS; c++ ) debut[c+1] += debut[c];
+	for( e = 0; e < index->nb_etats; e++ ){
+		for( t = index->debut[e]; t < index->debut[e+1]; t++ ){
+			int position = debut[ (unsigned char) index->lettres[t] ]++;
+			ordre[ 2 * position ] = e;
+			ordre[ 2 * position + 1 ] = index->fins[t];
+		}
+	}
+	for( c = NB_OCTETS; c > 0; c-- ) debut[c] = debut[c-1];
+	debut[0] = 0;
+
+	// Les octets sans transition forment la classe 0.
+	for( c = 0; c < NB_OCTETS; c++ ){
+		if( debut[c+1] == debut[c] ) premiere_classe = 1;
+	}
+	nb_classes = premiere_classe;
+	for( c = 0; c < NB_OCTETS; c++ ){
+		int nb = 2 * ( debut[c+1] - debut[c] );
+		const int * liste = ordre + 2 * debut[c];
+		uint64_t h = hacher_64( nb );
+		if( nb == 0 ){
+			classes[c] = 0;
+			continue;
+		}
+		for( t = 0; t < nb; t++ ) h = hacher_64( h ^ (uint32_t) liste[t] );
+		for( k = premiere_classe; k < nb_classes; k++ ){
+			int r = representants[k];
+			if( empreintes[k] == h
+				&& 2 * ( debut[r+1] - debut[r] ) == nb
+				&& memcmp( ordre + 2 * debut[r], liste, nb * sizeof(int) ) == 0
+			){
+				break;
+			}
+		}
+		if( k == nb_classes ){
+			empreintes[k] = h;
+			representants[k] = c;
+			nb_classes++;
+		}
+		classes[c] = k;
+	}
+
+	xfree( ordre );
+	return nb_classes;
+}
+
+Automate_compile * compiler_automate( const Automate * automate ){
+	Index_automate * index = creer_index_automate( automate );
+	Automate_compile * res = xmalloc( sizeof(Automate_compile) );
+	size_t nb_cases, nb_mots = NB_MOTS_BITS( index->nb_etats ) + 1;
+	int e, t;
+
+	if( ! index_est_deterministe( index ) ){
+		ERREUR( "La compilation demande un automate deterministe" );
+	}
+	res->nb_etats = index->nb_etats;
+	res->initial = -1;
+	res->projection = NULL;
+	res->taille_projection = 0;
+	res->nb_classes = calculer_classes_octets( index, res->classes );
+	nb_cases = (size_t) index->nb_etats * res->nb_classes;
+	res->transitions = xmalloc( ( nb_cases + 1 ) * sizeof(int32_t) );
+	memset( res->transitions, -1, ( nb_cases + 1 ) * sizeof(int32_t) );
+	res->finaux = xmalloc( nb_mots * sizeof(uint64_t) );
+	memcpy( res->finaux, index->finaux, nb_mots * sizeof(uint64_t) );
+	for( e = 0; e < index->nb_etats; e++ ){
+		if( TESTER_BIT( index->initiaux, e ) ) res->initial = e;
+		for( t = index->debut[e]; t < index->debut[e+1]; t++ ){
+			res->transitions[
+				(size_t) e * res->nb_classes
+				+ res->classes[ (unsigned char) index->lettres[t] ]
+			] = index->fins[t];
+		}
+	}
+	liberer_index_automate( index );
+	return res;
+}
+
+void liberer_automate_compile( Automate_compile * automate ){
+	if( automate ){
+		if( automate->projection ){
+			munmap( automate->projection, automate->taille_projection );
+		}else{
+			xfree( automate->transitions );
+			xfree( automate->finaux );
+		}
+		xfree( automate );
+	}
+}
+
+int reconnait_compile(
+	const Automate_compile * automate, const char * mot, size_t longueur
+){
+	const unsigned char * m = (const unsigned char *) mot;
+	const int32_t * transitions = automate->transitions;
+	const unsigned char * classes = automate->classes;
+	size_t nb_classes = automate->nb_classes;
+	int e = automate->initial;
+	size_t i;
+	if( e < 0 ) return 0;
+	for( i = 0; i < longueur; i++ ){
+		e = transitions[ e * nb_classes + classes[ m[i] ] ];
+		if( e < 0 ) return 0;
+	}
+	return TESTER_BIT( automate->finaux, e );
+}
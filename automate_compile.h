@@ -0,0 +1,93 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __AUTOMATE_COMPILE_H__
+#define __AUTOMATE_COMPILE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "automate.h"
+#include "index_automate.h"
+
+/**
+ * \brief Calcule les classes d'octets équivalents d'un automate indexé.
+ *
+ * Deux octets sont équivalents s'ils mènent aux mêmes états depuis chaque
+ * état de l'automate. Les octets qui ne sont pas dans l'alphabet forment la
+ * classe 0 (s'il y en a). 'classes[c]' reçoit le numéro de la classe de
+ * l'octet c.
+ *
+ * \param index Un automate indexé
+ * \param classes Un tableau de 256 cases
+ * \return Le nombre de classes
+ */
+int calculer_classes_octets(
+	const Index_automate * index, unsigned char classes[256]
+);
+
+/**
+ * \brief Un automate déterministe compilé en table, pour la reconnaissance
+ *        rapide de mots.
+ *
+ * Les colonnes de la table sont les classes d'octets équivalents (voir
+ * calculer_classes_octets()) : la transition de l'état e par l'octet c est
+ * transitions[ e * nb_classes + classes[c] ], ou -1 s'il n'y en a pas. Les
+ * états finaux sont codés par un ensemble de bits. L'état initial est
+ * 'initial', ou -1 si l'automate n'a pas d'état initial.
+ *
+ * Si 'projection' n'est pas NULL, les tableaux ne sont pas alloués : ils sont
+ * lus directement dans un fichier projeté en mémoire (voir
+ * projeter_automate_compile()), de 'taille_projection' octets.
+ */
+typedef struct {
+	int nb_etats;
+	int initial;
+	int nb_classes;
+	unsigned char classes[256];
+	int32_t * transitions;
+	uint64_t * finaux;
+	void * projection;
+	size_t taille_projection;
+} Automate_compile;
+
+/**
+ * \brief Compile un automate déterministe.
+ *
+ * Le programme s'arrête avec une erreur si l'automate n'est pas
+ * déterministe.
+ *
+ * \param automate Un automate déterministe
+ * \return L'automate compilé, à libérer avec liberer_automate_compile()
+ */
+Automate_compile * compiler_automate( const Automate * automate );
+
+void liberer_automate_compile( Automate_compile * automate );
+
+/**
+ * \brief Renvoie 1 si l'automate compilé reconnaît le mot de longueur
+ *        'longueur' (qui peut contenir des '\0'), et 0 sinon.
+ */
+int reconnait_compile(
+	const Automate_compile * automate, const char * mot, size_t longueur
+);
+
+#endif
@@ -26,6 +26,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "avl.h"
+#include "outils.h"
 
 /* Creates and returns a new table
    with comparison function |compare| using parameter |param|
@@ -841,13 +842,14 @@ avl_destroy (struct avl_table *tree, avl_item_func *destroy)
   tree->avl_alloc->libavl_free (tree->avl_alloc, tree);
 }
 
-/* Allocates |size| bytes of space using |malloc()|.
-   Returns a null pointer if allocation fails. */
+/* Allocates |size| bytes of space using |xmalloc_etiquete()|, so that the
+   allocations of the trees are counted as those of the AVL subsystem.
+   Does not return if allocation fails. */
 void *
 avl_malloc (struct libavl_allocator *allocator, size_t size)
 {
   assert (allocator != NULL && size > 0);
-  return malloc (size);
+  return xmalloc_etiquete (size, ALLOCATION_AVL);
 }
 
 /* Frees |block|. */
@@ -855,10 +857,10 @@ void
 avl_free (struct libavl_allocator *allocator, void *block)
 {
   assert (allocator != NULL && block != NULL);
-  free (block);
+  xfree (block);
 }
 
-/* Default memory allocator that uses |malloc()| and |free()|. */
+/* Default memory allocator that uses |xmalloc_etiquete()| and |xfree()|. */
 struct libavl_allocator avl_allocator_default =
   {
     avl_malloc,
@@ -0,0 +1,1137 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*
+ * Les micro-benchmarks de la bibliothèque.
+ *
+ * Chaque benchmark prépare ses données (non mesuré), puis répète son
+ * opération jusqu'à dépasser une durée minimale. Il est exécuté dans un
+ * processus fils, pour que le pic de mémoire mesuré soit le sien. Les
+ * résultats sont écrits sur la sortie standard, un objet JSON par ligne.
+ *
+ * Usage : ./benchmark [-t duree_min] [-r repetitions] [-c reference.json]
+ *                     [-s seuil_en_pourcents] [filtre]
+ * Seuls les benchmarks dont le nom contient 'filtre' sont exécutés.
+ *
+ * Avec -r, chaque benchmark est exécuté plusieurs fois (chaque fois dans un
+ * nouveau processus), et le résultat donne la médiane des temps avec un
+ * intervalle de confiance. Avec -c, les résultats ne sont pas écrits en
+ * JSON mais comparés à ceux d'un fichier de référence, écrit auparavant
+ * par ce programme : un tableau donne la variation de chaque benchmark, et
+ * le programme échoue si l'un d'eux a ralenti de plus du seuil (10% par
+ * défaut) au-delà du bruit de mesure. Le bruit n'est estimé qu'à partir de
+ * trois répétitions : avec -c, -r vaut 5 par défaut et doit valoir au
+ * moins 3.
+ *
+ * Les allocations sont comptées par xmalloc() (voir outils.h) pendant la
+ * mesure : 'octets_perdus_par_op' est la variation des octets vivants par
+ * itération (non nulle si l'opération fuit), et 'pic_alloue_ko' la somme
+ * des pics des sous-systèmes au-delà des données préparées.
+ *
+ * Les entrées sont produites par des générateurs à graine fixe : deux
+ * exécutions mesurent exactement le même travail.
+ */
+
+#include "automate.h"
+#include "determinisation.h"
+#include "echantillonnage.h"
+#include "fifo.h"
+#include "file_concurrente.h"
+#include "generateur.h"
+#include "index_automate.h"
+#include "outils.h"
+#include "parcours.h"
+#include "table.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define GRAINE 20140101
+
+static double maintenant(){
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+/*
+ * Les générateurs d'automates.
+ */
+
+/* Une chaîne 0 -a-> 1 -a-> ... -a-> n-1, de l'état initial 0 à l'état final
+ * n-1.
+ */
+static Automate * generer_chaine( int n ){
+	Automate * res = creer_automate();
+	int i;
+	ajouter_etat_initial( res, 0 );
+	ajouter_etat_final( res, n - 1 );
+	for( i = 0; i + 1 < n; i++ ) ajouter_transition( res, i, 'a', i + 1 );
+	return res;
+}
+
+/* n états, et une transition par lettre entre tous les couples d'états. */
+static Automate * generer_clique( int n, int nb_lettres ){
+	Automate * res = creer_automate();
+	int i, j, c;
+	ajouter_etat_initial( res, 0 );
+	ajouter_etat_final( res, n - 1 );
+	for( i = 0; i < n; i++ ){
+		for( c = 0; c < nb_lettres; c++ ){
+			for( j = 0; j < n; j++ ) ajouter_transition( res, i, 'a' + c, j );
+		}
+	}
+	return res;
+}
+
+/* n états, 'degre' transitions aléatoires par état sur 'nb_lettres' lettres,
+ * l'état initial 0, et un état final sur dix en moyenne.
+ */
+static Automate * generer_aleatoire(
+	int n, int nb_lettres, int degre, uint64_t graine
+){
+	Parametres_generateur p;
+	initialiser_parametres_generateur( &p );
+	p.nb_etats = n;
+	p.taille_alphabet = nb_lettres;
+	p.degre_moyen = degre;
+	p.graine = graine;
+	return generer_automate_aleatoire( &p );
+}
+
+static int comparer_mots( const void * a, const void * b ){
+	return strcmp( *(const char * const *) a, *(const char * const *) b );
+}
+
+/* L'arbre préfixe de 'nb_mots' mots aléatoires de longueur 1 à
+ * 'longueur_max' sur les lettres de 'a' à 'z'.
+ */
+static Automate * generer_trie( int nb_mots, int longueur_max, uint64_t graine ){
+	Generateur_aleatoire g;
+	Automate * res = creer_automate();
+	char ** mots = xmalloc( nb_mots * sizeof(char *) );
+	int * pile = xmalloc( ( longueur_max + 1 ) * sizeof(int) );
+	int i, k, nb_etats = 1;
+
+	initialiser_generateur_aleatoire( &g, graine );
+	for( i = 0; i < nb_mots; i++ ){
+		int longueur = 1 + tirer_aleatoire( &g ) % longueur_max;
+		mots[i] = xmalloc( longueur + 1 );
+		for( k = 0; k < longueur; k++ ) mots[i][k] = 'a' + tirer_aleatoire( &g ) % 26;
+		mots[i][longueur] = '\0';
+	}
+	// Dans l'ordre lexicographique, un mot partage avec l'arbre déjà
+	// construit exactement son plus long préfixe commun avec le précédent.
+	qsort( mots, nb_mots, sizeof(char *), comparer_mots );
+	ajouter_etat_initial( res, 0 );
+	pile[0] = 0;
+	for( i = 0; i < nb_mots; i++ ){
+		k = 0;
+		if( i > 0 ){
+			while( mots[i][k] && mots[i][k] == mots[i-1][k] ) k++;
+		}
+		for( ; mots[i][k]; k++ ){
+			ajouter_transition( res, pile[k], mots[i][k], nb_etats );
+			pile[k+1] = nb_etats++;
+		}
+		ajouter_etat_final( res, pile[k] );
+	}
+	for( i = 0; i < nb_mots; i++ ) xfree( mots[i] );
+	xfree( mots );
+	xfree( pile );
+	return res;
+}
+
+static char * generer_mot( int longueur, int nb_lettres, uint64_t graine ){
+	Generateur_aleatoire g;
+	char * res = xmalloc( longueur + 1 );
+	int i;
+	initialiser_generateur_aleatoire( &g, graine );
+	for( i = 0; i < longueur; i++ ) res[i] = 'a' + tirer_aleatoire( &g ) % nb_lettres;
+	res[longueur] = '\0';
+	return res;
+}
+
+static Ensemble * generer_ensemble( int n, int borne, uint64_t graine ){
+	Generateur_aleatoire g;
+	Ensemble * res = creer_ensemble( NULL, NULL, NULL );
+	int taille = 0;
+	initialiser_generateur_aleatoire( &g, graine );
+	while( taille < n ){
+		intptr_t element = tirer_aleatoire( &g ) % borne;
+		if( ! est_dans_l_ensemble( res, element ) ){
+			ajouter_element( res, element );
+			taille++;
+		}
+	}
+	return res;
+}
+
+static intptr_t * generer_cles( int n, uint64_t graine ){
+	Generateur_aleatoire g;
+	intptr_t * res = xmalloc( n * sizeof(intptr_t) );
+	int i;
+	initialiser_generateur_aleatoire( &g, graine );
+	for( i = 0; i < n; i++ ) res[i] = tirer_aleatoire( &g ) % ( 10 * n );
+	return res;
+}
+
+/*
+ * Les données d'un benchmark : chaque préparation remplit les champs dont
+ * son opération a besoin, les autres restent nuls.
+ */
+typedef struct {
+	Automate * automate;
+	Automate * autre;
+	Ensemble * ensemble;
+	Ensemble * autre_ensemble;
+	Table * table;
+	Index_automate * index;
+	Index_automate * miroir;
+	Charge_mots * charge;
+	intptr_t * cles;
+	char * mot;
+	int n;
+	int nb_fils;
+} Donnees;
+
+typedef struct {
+	const char * nom;
+	void (* preparer )( Donnees * d );
+	void (* executer )( Donnees * d, long i );
+} Benchmark;
+
+static void liberer_donnees( Donnees * d ){
+	if( d->automate ) liberer_automate( d->automate );
+	if( d->autre ) liberer_automate( d->autre );
+	if( d->ensemble ) liberer_ensemble( d->ensemble );
+	if( d->autre_ensemble ) liberer_ensemble( d->autre_ensemble );
+	if( d->table ) liberer_table( d->table );
+	if( d->index ) liberer_index_automate( d->index );
+	if( d->miroir ) liberer_index_automate( d->miroir );
+	if( d->charge ) liberer_charge_mots( d->charge );
+	xfree( d->cles );
+	xfree( d->mot );
+}
+
+/* Ensemble */
+
+static void preparer_cles_1000( Donnees * d ){
+	d->n = 1000;
+	d->cles = generer_cles( d->n, GRAINE );
+}
+
+static void executer_ensemble_ajouter( Donnees * d, long i ){
+	Ensemble * e = creer_ensemble( NULL, NULL, NULL );
+	int k;
+	for( k = 0; k < d->n; k++ ) ajouter_element( e, d->cles[k] );
+	liberer_ensemble( e );
+}
+
+static void preparer_ensembles_100000( Donnees * d ){
+	d->n = 100000;
+	d->ensemble = generer_ensemble( d->n, 4 * d->n, GRAINE );
+	d->autre_ensemble = generer_ensemble( d->n, 4 * d->n, GRAINE + 1 );
+	d->cles = generer_cles( d->n, GRAINE + 2 );
+}
+
+static void executer_ensemble_est_dans( Donnees * d, long i ){
+	est_dans_l_ensemble( d->ensemble, d->cles[ i % d->n ] );
+}
+
+static void executer_ensemble_union( Donnees * d, long i ){
+	liberer_ensemble( creer_union_ensemble( d->ensemble, d->autre_ensemble ) );
+}
+
+static void executer_ensemble_intersection( Donnees * d, long i ){
+	liberer_ensemble(
+		creer_intersection_ensemble( d->ensemble, d->autre_ensemble )
+	);
+}
+
+/* Table */
+
+static void executer_table_ajouter( Donnees * d, long i ){
+	Table * t = creer_table( NULL, NULL, NULL );
+	int k;
+	for( k = 0; k < d->n; k++ ) add_table( t, d->cles[k], k );
+	liberer_table( t );
+}
+
+static void executer_table_ajouter_supprimer( Donnees * d, long i ){
+	Table * t = creer_table( NULL, NULL, NULL );
+	int k;
+	for( k = 0; k < d->n; k++ ) add_table( t, d->cles[k], k );
+	for( k = 0; k < d->n; k++ ) delete_table( t, d->cles[k] );
+	liberer_table( t );
+}
+
+static void preparer_table_100000( Donnees * d ){
+	int k;
+	d->n = 100000;
+	d->cles = generer_cles( d->n, GRAINE );
+	d->table = creer_table( NULL, NULL, NULL );
+	for( k = 0; k < d->n; k++ ) add_table( d->table, d->cles[k], k );
+}
+
+static void executer_table_trouver( Donnees * d, long i ){
+	trouver_table( d->table, d->cles[ ( i * 7919 ) % d->n ] );
+}
+
+/* Files */
+
+/* L'ancienne file de la bibliothèque, gardée comme point de comparaison :
+ * une liste simplement chaînée, avec une allocation par élément.
+ */
+typedef struct _Maillon {
+	struct _Maillon * suivant;
+	intptr_t element;
+} Maillon;
+
+static void executer_liste_chainee( Donnees * d, long i ){
+	Maillon * tete = NULL;
+	int k;
+	for( k = 0; k < d->n; k++ ){
+		Maillon * m = xmalloc_etiquete( sizeof(Maillon), ALLOCATION_FIFO );
+		m->suivant = tete;
+		m->element = k;
+		tete = m;
+	}
+	while( tete ){
+		Maillon * m = tete;
+		tete = m->suivant;
+		xfree( m );
+	}
+}
+
+static void executer_fifo( Donnees * d, long i ){
+	Fifo * fifo = creer_fifo();
+	int k;
+	for( k = 0; k < d->n; k++ ) ajouter_fifo( fifo, k );
+	while( ! est_vide( fifo ) ) retirer_fifo( fifo );
+	liberer_fifo( fifo );
+}
+
+static void executer_pile( Donnees * d, long i ){
+	Pile * pile = creer_pile();
+	int k;
+	for( k = 0; k < d->n; k++ ) empiler( pile, k );
+	while( ! pile_est_vide( pile ) ) depiler( pile );
+	liberer_pile( pile );
+}
+
+/* Files concurrentes
+ *
+ * Chaque itération fait passer d->n éléments par une file partagée entre
+ * 'nb_fils' producteurs et autant de consommateurs, ou par une deque dont
+ * le propriétaire empile et dépile pendant que 'nb_fils' - 1 voleurs
+ * volent. Les variantes vont jusqu'au nombre de cœurs de la machine.
+ */
+
+#define NB_FILS_MAX 64
+
+typedef struct {
+	File_concurrente * file;
+	Deque_vol * deque;
+	long nb_elements;
+	int * fin;
+} Travail_concurrent;
+
+static void * produire( void * donnees ){
+	Travail_concurrent * t = donnees;
+	long k;
+	for( k = 0; k < t->nb_elements; k++ ){
+		while( ! ajouter_file_concurrente( t->file, k ) ) sched_yield();
+	}
+	return NULL;
+}
+
+static void * consommer( void * donnees ){
+	Travail_concurrent * t = donnees;
+	intptr_t element;
+	long k = 0;
+	while( k < t->nb_elements ){
+		if( retirer_file_concurrente( t->file, &element ) ){
+			k++;
+		}else{
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+static void * voler( void * donnees ){
+	Travail_concurrent * t = donnees;
+	intptr_t element;
+	for(;;){
+		Resultat_vol vol = voler_deque_vol( t->deque, &element );
+		if( vol == VOL_VIDE ){
+			if( __atomic_load_n( t->fin, __ATOMIC_ACQUIRE ) ) return NULL;
+			sched_yield();
+		}
+	}
+}
+
+static int nb_fils_benchmark( Donnees * d ){
+	int nb = d->nb_fils;
+	if( nb == 0 ) nb = sysconf( _SC_NPROCESSORS_ONLN );
+	if( nb > NB_FILS_MAX ) nb = NB_FILS_MAX;
+	return nb < 1 ? 1 : nb;
+}
+
+static void executer_file_concurrente( Donnees * d, long i ){
+	int nb_fils = nb_fils_benchmark( d ), k;
+	pthread_t producteurs[ NB_FILS_MAX ], consommateurs[ NB_FILS_MAX ];
+	Travail_concurrent t;
+	t.file = creer_file_concurrente( 1024 );
+	t.nb_elements = d->n / nb_fils;
+	for( k = 0; k < nb_fils; k++ ){
+		pthread_create( &consommateurs[k], NULL, consommer, &t );
+		pthread_create( &producteurs[k], NULL, produire, &t );
+	}
+	for( k = 0; k < nb_fils; k++ ){
+		pthread_join( producteurs[k], NULL );
+		pthread_join( consommateurs[k], NULL );
+	}
+	liberer_file_concurrente( t.file );
+}
+
+static void executer_deque_vol( Donnees * d, long i ){
+	int nb_fils = nb_fils_benchmark( d ), fin = 0, k;
+	long nb_elements = d->n, e;
+	pthread_t voleurs[ NB_FILS_MAX ];
+	Travail_concurrent t;
+	intptr_t element;
+	t.deque = creer_deque_vol();
+	t.fin = &fin;
+	for( k = 1; k < nb_fils; k++ ){
+		pthread_create( &voleurs[k], NULL, voler, &t );
+	}
+	for( e = 0; e < nb_elements; e++ ){
+		empiler_deque_vol( t.deque, e );
+		if( e % 2 ) depiler_deque_vol( t.deque, &element );
+	}
+	while( depiler_deque_vol( t.deque, &element ) );
+	__atomic_store_n( &fin, 1, __ATOMIC_RELEASE );
+	for( k = 1; k < nb_fils; k++ ) pthread_join( voleurs[k], NULL );
+	liberer_deque_vol( t.deque );
+}
+
+/* Un nombre de fils nul désigne tous les cœurs. */
+static void preparer_concurrent_1( Donnees * d ){
+	d->n = 100000;
+	d->nb_fils = 1;
+}
+
+static void preparer_concurrent_2( Donnees * d ){
+	d->n = 100000;
+	d->nb_fils = 2;
+}
+
+static void preparer_concurrent_4( Donnees * d ){
+	d->n = 100000;
+	d->nb_fils = 4;
+}
+
+static void preparer_concurrent_tous( Donnees * d ){
+	d->n = 100000;
+	d->nb_fils = 0;
+}
+
+/* Automates */
+
+static void preparer_taille_100000( Donnees * d ){
+	d->n = 100000;
+}
+
+static void executer_generer_index( Donnees * d, long i ){
+	Parametres_generateur p;
+	initialiser_parametres_generateur( &p );
+	p.nb_etats = d->n;
+	p.taille_alphabet = 4;
+	p.degre_moyen = 4;
+	p.graine = GRAINE + i;
+	liberer_index_automate( generer_index_aleatoire( &p ) );
+}
+
+static void preparer_nfa_10000( Donnees * d ){
+	d->automate = generer_aleatoire( 10000, 4, 4, GRAINE );
+	d->ensemble = generer_ensemble( 100, 10000, GRAINE + 1 );
+	d->mot = generer_mot( 16, 4, GRAINE + 2 );
+}
+
+static void preparer_nfa_1000( Donnees * d ){
+	d->automate = generer_aleatoire( 1000, 4, 4, GRAINE );
+	d->autre = generer_aleatoire( 1000, 4, 2, GRAINE + 1 );
+	d->mot = generer_mot( 16, 4, GRAINE + 2 );
+}
+
+static void preparer_nfa_100( Donnees * d ){
+	d->automate = generer_aleatoire( 100, 4, 3, GRAINE );
+	d->autre = generer_aleatoire( 100, 4, 3, GRAINE + 1 );
+}
+
+static void preparer_chaine_1000( Donnees * d ){
+	d->automate = generer_chaine( 1000 );
+	d->mot = xmalloc( 1000 );
+	memset( d->mot, 'a', 999 );
+	d->mot[999] = '\0';
+}
+
+static void preparer_chaines_20( Donnees * d ){
+	d->automate = generer_chaine( 20 );
+	d->autre = generer_chaine( 20 );
+}
+
+static void preparer_clique_50( Donnees * d ){
+	d->automate = generer_clique( 50, 2 );
+	d->mot = generer_mot( 16, 2, GRAINE );
+}
+
+static void preparer_trie_100( Donnees * d ){
+	d->automate = generer_trie( 100, 12, GRAINE );
+}
+
+static void preparer_trie_20( Donnees * d ){
+	d->automate = generer_trie( 20, 12, GRAINE );
+}
+
+/* Un automate dont le déterminisé a environ 28 000 états. */
+static void preparer_nfa_400( Donnees * d ){
+	Parametres_generateur p;
+	initialiser_parametres_generateur( &p );
+	p.nb_etats = 400;
+	p.taille_alphabet = 3;
+	p.degre_moyen = 2;
+	p.densite_initiaux = 0.2;
+	p.densite_finaux = 0.3;
+	p.graine = 1;
+	d->automate = generer_automate_aleatoire( &p );
+}
+
+static void preparer_nfa_400_1_fil( Donnees * d ){
+	preparer_nfa_400( d );
+	d->nb_fils = 1;
+}
+
+static void preparer_nfa_400_2_fils( Donnees * d ){
+	preparer_nfa_400( d );
+	d->nb_fils = 2;
+}
+
+static void preparer_nfa_400_4_fils( Donnees * d ){
+	preparer_nfa_400( d );
+	d->nb_fils = 4;
+}
+
+static void preparer_nfa_400_tous_fils( Donnees * d ){
+	preparer_nfa_400( d );
+	d->nb_fils = 0;
+}
+
+static void executer_determiniser( Donnees * d, long i ){
+	liberer_automate( creer_automate_deterministe( d->automate ) );
+}
+
+static void executer_determiniser_parallele( Donnees * d, long i ){
+	liberer_automate(
+		creer_automate_deterministe_parallele( d->automate, d->nb_fils )
+	);
+}
+
+/* Un index d'un million d'états de degré 4, et son miroir. */
+static void preparer_index_1000000( Donnees * d ){
+	Parametres_generateur p;
+	initialiser_parametres_generateur( &p );
+	p.nb_etats = 1000000;
+	p.taille_alphabet = 4;
+	p.degre_moyen = 4;
+	p.graine = GRAINE;
+	d->index = generer_index_aleatoire( &p );
+	d->miroir = creer_index_miroir( d->index );
+}
+
+static void preparer_index_1000000_1_fil( Donnees * d ){
+	preparer_index_1000000( d );
+	d->nb_fils = 1;
+}
+
+static void preparer_index_1000000_2_fils( Donnees * d ){
+	preparer_index_1000000( d );
+	d->nb_fils = 2;
+}
+
+static void preparer_index_1000000_4_fils( Donnees * d ){
+	preparer_index_1000000( d );
+	d->nb_fils = 4;
+}
+
+static void preparer_index_1000000_tous_fils( Donnees * d ){
+	preparer_index_1000000( d );
+	d->nb_fils = 0;
+}
+
+/* Sans index miroir, le parcours reste descendant. */
+static void executer_parcours_descendant( Donnees * d, long i ){
+	uint64_t * atteints = xmalloc(
+		( NB_MOTS_BITS( d->index->nb_etats ) + 1 ) * sizeof(uint64_t)
+	);
+	parcourir_en_largeur(
+		d->index, NULL, d->index->initiaux, atteints, d->nb_fils
+	);
+	xfree( atteints );
+}
+
+static void executer_parcours_largeur( Donnees * d, long i ){
+	xfree( etats_accessibles_index( d->index, d->miroir, d->nb_fils ) );
+}
+
+/* Des fils qui se partagent la lecture d'une charge de mots par un même
+ * automate.
+ */
+typedef struct {
+	const Automate * automate;
+	const Charge_mots * charge;
+	int debut;
+	int fin;
+	int nb_reconnus;
+} Lecture_partagee;
+
+static void * lire_mots( void * donnees ){
+	Lecture_partagee * l = donnees;
+	int k;
+	for( k = l->debut; k < l->fin; k++ ){
+		l->nb_reconnus += le_mot_est_reconnu( l->automate, l->charge->mots[k] );
+	}
+	return NULL;
+}
+
+/* Un automate déterministe de 10 000 états et 10 000 mots, dont la moitié
+ * sont reconnus.
+ */
+static void preparer_dfa_10000( Donnees * d ){
+	Parametres_generateur p;
+	Parametres_mots pm = { 10000, 0.5, LOI_GEOMETRIQUE, 16, GRAINE + 1 };
+	Index_automate * index;
+	initialiser_parametres_generateur( &p );
+	p.nb_etats = 10000;
+	p.taille_alphabet = 4;
+	p.degre_moyen = 3;
+	p.deterministe = 1;
+	p.graine = GRAINE;
+	d->automate = generer_automate_aleatoire( &p );
+	index = creer_index_automate( d->automate );
+	d->charge = generer_charge_mots( index, &pm );
+	liberer_index_automate( index );
+}
+
+/* La référence non gelée, lue par un seul fil. */
+static void preparer_dfa_10000_non_gele_1_fil( Donnees * d ){
+	preparer_dfa_10000( d );
+	d->nb_fils = 1;
+}
+
+static void preparer_dfa_10000_gele( Donnees * d, int nb_fils ){
+	preparer_dfa_10000( d );
+	geler_automate( d->automate );
+	d->nb_fils = nb_fils;
+}
+
+static void preparer_dfa_10000_gele_1_fil( Donnees * d ){
+	preparer_dfa_10000_gele( d, 1 );
+}
+
+static void preparer_dfa_10000_gele_2_fils( Donnees * d ){
+	preparer_dfa_10000_gele( d, 2 );
+}
+
+static void preparer_dfa_10000_gele_4_fils( Donnees * d ){
+	preparer_dfa_10000_gele( d, 4 );
+}
+
+static void preparer_dfa_10000_gele_tous_fils( Donnees * d ){
+	preparer_dfa_10000_gele( d, 0 );
+}
+
+static void executer_lecture_partagee( Donnees * d, long i ){
+	int nb_fils = nb_fils_benchmark( d ), k;
+	pthread_t fils[ NB_FILS_MAX ];
+	Lecture_partagee lectures[ NB_FILS_MAX ];
+	for( k = 0; k < nb_fils; k++ ){
+		lectures[k].automate = d->automate;
+		lectures[k].charge = d->charge;
+		lectures[k].debut = (long) d->charge->nb_mots * k / nb_fils;
+		lectures[k].fin = (long) d->charge->nb_mots * ( k + 1 ) / nb_fils;
+		lectures[k].nb_reconnus = 0;
+		if( k > 0 ) pthread_create( &fils[k], NULL, lire_mots, &lectures[k] );
+	}
+	lire_mots( &lectures[0] );
+	for( k = 1; k < nb_fils; k++ ) pthread_join( fils[k], NULL );
+}
+
+static void executer_delta( Donnees * d, long i ){
+	liberer_ensemble( delta( d->automate, d->ensemble, 'a' + i % 4 ) );
+}
+
+static void executer_delta_star( Donnees * d, long i ){
+	liberer_ensemble(
+		delta_star( d->automate, get_initiaux( d->automate ), d->mot )
+	);
+}
+
+static void executer_le_mot_est_reconnu( Donnees * d, long i ){
+	le_mot_est_reconnu( d->automate, d->mot );
+}
+
+static void executer_copier_automate( Donnees * d, long i ){
+	liberer_automate( copier_automate( d->automate ) );
+}
+
+static void executer_etats_accessibles( Donnees * d, long i ){
+	liberer_ensemble( etats_accessibles( d->automate, 0 ) );
+}
+
+static void executer_automate_accessible( Donnees * d, long i ){
+	liberer_automate( automate_accessible( d->automate ) );
+}
+
+static void executer_automate_co_accessible( Donnees * d, long i ){
+	liberer_automate( automate_co_accessible( d->automate ) );
+}
+
+static void executer_miroir( Donnees * d, long i ){
+	liberer_automate( miroir( d->automate ) );
+}
+
+static void executer_prefixes( Donnees * d, long i ){
+	liberer_automate( creer_automate_des_prefixes( d->automate ) );
+}
+
+static void executer_facteurs( Donnees * d, long i ){
+	liberer_automate( creer_automate_des_facteurs( d->automate ) );
+}
+
+static void executer_concatenation( Donnees * d, long i ){
+	liberer_automate( creer_automate_de_concatenation( d->automate, d->autre ) );
+}
+
+static void executer_produit( Donnees * d, long i ){
+	liberer_automate(
+		creer_automate_produit( d->automate, d->autre, PRODUIT_INTERSECTION )
+	);
+}
+
+static void executer_melange( Donnees * d, long i ){
+	liberer_automate( creer_automate_du_melange( d->automate, d->autre ) );
+}
+
+static const Benchmark benchmarks[] = {
+	{ "ensemble_ajouter_1000", preparer_cles_1000, executer_ensemble_ajouter },
+	{ "ensemble_est_dans_100000", preparer_ensembles_100000, executer_ensemble_est_dans },
+	{ "ensemble_union_100000", preparer_ensembles_100000, executer_ensemble_union },
+	{ "ensemble_intersection_100000", preparer_ensembles_100000, executer_ensemble_intersection },
+	{ "table_ajouter_1000", preparer_cles_1000, executer_table_ajouter },
+	{ "table_trouver_100000", preparer_table_100000, executer_table_trouver },
+	{ "table_ajouter_supprimer_1000", preparer_cles_1000, executer_table_ajouter_supprimer },
+	{ "liste_chainee_100000", preparer_taille_100000, executer_liste_chainee },
+	{ "fifo_100000", preparer_taille_100000, executer_fifo },
+	{ "pile_100000", preparer_taille_100000, executer_pile },
+	{ "file_concurrente_100000_1_fil", preparer_concurrent_1, executer_file_concurrente },
+	{ "file_concurrente_100000_2_fils", preparer_concurrent_2, executer_file_concurrente },
+	{ "file_concurrente_100000_4_fils", preparer_concurrent_4, executer_file_concurrente },
+	{ "file_concurrente_100000_tous_fils", preparer_concurrent_tous, executer_file_concurrente },
+	{ "deque_vol_100000_1_fil", preparer_concurrent_1, executer_deque_vol },
+	{ "deque_vol_100000_2_fils", preparer_concurrent_2, executer_deque_vol },
+	{ "deque_vol_100000_4_fils", preparer_concurrent_4, executer_deque_vol },
+	{ "deque_vol_100000_tous_fils", preparer_concurrent_tous, executer_deque_vol },
+	{ "generer_index_nfa_100000", preparer_taille_100000, executer_generer_index },
+	{ "delta_nfa_10000", preparer_nfa_10000, executer_delta },
+	{ "delta_star_nfa_10000", preparer_nfa_10000, executer_delta_star },
+	{ "delta_star_clique_50", preparer_clique_50, executer_delta_star },
+	{ "le_mot_est_reconnu_nfa_1000", preparer_nfa_1000, executer_le_mot_est_reconnu },
+	{ "le_mot_est_reconnu_chaine_1000", preparer_chaine_1000, executer_le_mot_est_reconnu },
+	{ "copier_automate_nfa_1000", preparer_nfa_1000, executer_copier_automate },
+	{ "etats_accessibles_nfa_1000", preparer_nfa_1000, executer_etats_accessibles },
+	{ "automate_accessible_nfa_1000", preparer_nfa_1000, executer_automate_accessible },
+	{ "automate_co_accessible_nfa_100", preparer_nfa_100, executer_automate_co_accessible },
+	{ "miroir_nfa_1000", preparer_nfa_1000, executer_miroir },
+	{ "prefixes_trie_100", preparer_trie_100, executer_prefixes },
+	{ "facteurs_trie_20", preparer_trie_20, executer_facteurs },
+	{ "concatenation_nfa_100", preparer_nfa_100, executer_concatenation },
+	{ "produit_nfa_100", preparer_nfa_100, executer_produit },
+	{ "melange_chaines_20", preparer_chaines_20, executer_melange },
+	{ "determiniser_nfa_400", preparer_nfa_400, executer_determiniser },
+	{ "determiniser_parallele_nfa_400_1_fil", preparer_nfa_400_1_fil, executer_determiniser_parallele },
+	{ "determiniser_parallele_nfa_400_2_fils", preparer_nfa_400_2_fils, executer_determiniser_parallele },
+	{ "determiniser_parallele_nfa_400_4_fils", preparer_nfa_400_4_fils, executer_determiniser_parallele },
+	{ "determiniser_parallele_nfa_400_tous_fils", preparer_nfa_400_tous_fils, executer_determiniser_parallele },
+	{ "parcours_descendant_1000000_1_fil", preparer_index_1000000_1_fil, executer_parcours_descendant },
+	{ "parcours_largeur_1000000_1_fil", preparer_index_1000000_1_fil, executer_parcours_largeur },
+	{ "parcours_largeur_1000000_2_fils", preparer_index_1000000_2_fils, executer_parcours_largeur },
+	{ "parcours_largeur_1000000_4_fils", preparer_index_1000000_4_fils, executer_parcours_largeur },
+	{ "parcours_largeur_1000000_tous_fils", preparer_index_1000000_tous_fils, executer_parcours_largeur },
+	{ "lecture_dfa_10000_non_gele_1_fil", preparer_dfa_10000_non_gele_1_fil, executer_lecture_partagee },
+	{ "lecture_dfa_10000_gele_1_fil", preparer_dfa_10000_gele_1_fil, executer_lecture_partagee },
+	{ "lecture_dfa_10000_gele_2_fils", preparer_dfa_10000_gele_2_fils, executer_lecture_partagee },
+	{ "lecture_dfa_10000_gele_4_fils", preparer_dfa_10000_gele_4_fils, executer_lecture_partagee },
+	{ "lecture_dfa_10000_gele_tous_fils", preparer_dfa_10000_gele_tous_fils, executer_lecture_partagee }
+};
+
+#define NB_BENCHMARKS ( (int) ( sizeof(benchmarks) / sizeof(benchmarks[0]) ) )
+
+static double mesurer( const Benchmark * b, Donnees * d, long nb_iterations ){
+	double debut = maintenant();
+	long i;
+	for( i = 0; i < nb_iterations; i++ ) b->executer( d, i );
+	return maintenant() - debut;
+}
+
+/* Le résultat d'une exécution d'un benchmark. */
+typedef struct {
+	long nb_iterations;
+	double ns_par_op;
+	double allocations_par_op;
+	double octets_perdus_par_op;
+	long long pic_alloue_ko;
+	long rss_max_ko;
+} Mesure;
+
+/* Exécute un benchmark et remplit sa mesure. Le nombre d'itérations est
+ * doublé jusqu'à ce que la mesure dure au moins le quart de 'duree_min',
+ * puis ajusté pour que la mesure finale dure environ 'duree_min'.
+ */
+static void executer_benchmark(
+	const Benchmark * b, double duree_min, Mesure * mesure
+){
+	Donnees d;
+	struct rusage utilisation;
+	Releve_allocations avant, apres;
+	Compteurs_allocation total;
+	long nb_iterations = 1;
+	double duree;
+
+	memset( &d, 0, sizeof(Donnees) );
+	b->preparer( &d );
+	b->executer( &d, 0 );
+	while( ( duree = mesurer( b, &d, nb_iterations ) ) < duree_min / 4 ){
+		nb_iterations *= 2;
+	}
+	if( duree < duree_min ){
+		nb_iterations = nb_iterations * ( duree_min / duree ) + 1;
+	}
+
+	relever_allocations( &avant );
+	duree = mesurer( b, &d, nb_iterations );
+	relever_allocations( &apres );
+	difference_allocations( &avant, &apres, &apres );
+	total_allocations( &apres, &total );
+	getrusage( RUSAGE_SELF, &utilisation );
+
+	mesure->nb_iterations = nb_iterations;
+	mesure->ns_par_op = 1e9 * duree / nb_iterations;
+	mesure->allocations_par_op = (double) total.allocations / nb_iterations;
+	mesure->octets_perdus_par_op = (double) total.octets_vivants / nb_iterations;
+	mesure->pic_alloue_ko = total.pic_octets / 1024;
+	mesure->rss_max_ko = utilisation.ru_maxrss;
+	liberer_donnees( &d );
+}
+
+/* Exécute un benchmark dans un processus fils, qui renvoie sa mesure par un
+ * tube. Renvoie 1 en cas de succès, 0 sinon.
+ */
+static int lancer_benchmark(
+	const Benchmark * b, double duree_min, Mesure * mesure
+){
+	int tube[2], statut;
+	ssize_t lus;
+	pid_t fils;
+
+	fflush( stdout );
+	if( pipe( tube ) < 0 ) ERREUR( "pipe() a echoue" );
+	fils = fork();
+	if( fils < 0 ) ERREUR( "fork() a echoue" );
+	if( fils == 0 ){
+		close( tube[0] );
+		executer_benchmark( b, duree_min, mesure );
+		if( write( tube[1], mesure, sizeof(Mesure) ) != sizeof(Mesure) ){
+			exit( EXIT_FAILURE );
+		}
+		exit( EXIT_SUCCESS );
+	}
+	close( tube[1] );
+	lus = read( tube[0], mesure, sizeof(Mesure) );
+	close( tube[0] );
+	return waitpid( fils, &statut, 0 ) >= 0
+		&& WIFEXITED( statut ) && WEXITSTATUS( statut ) == 0
+		&& lus == sizeof(Mesure);
+}
+
+/* Le résumé des répétitions d'un benchmark : la médiane des temps et un
+ * intervalle de confiance à 95% pour cette médiane, donné par deux
+ * statistiques d'ordre (ce qui ne suppose rien sur la loi des temps).
+ * Les autres champs sont ceux de la répétition médiane.
+ *
+ * Pour moins d'une dizaine de répétitions, les rangs sont ramenés à 1 et
+ * n : l'intervalle est alors [min, max], dont le niveau est moindre (environ
+ * 94% pour 5 répétitions, 1 - 2^(1-n) en général).
+ */
+typedef struct {
+	Mesure mediane;
+	double ic_bas;
+	double ic_haut;
+	int nb_repetitions;
+} Resume;
+
+static int comparer_mesures( const void * a, const void * b ){
+	double x = ( (const Mesure *) a )->ns_par_op;
+	double y = ( (const Mesure *) b )->ns_par_op;
+	return ( x > y ) - ( x < y );
+}
+
+static void resumer( Mesure * mesures, int n, Resume * resume ){
+	double ecart = 0.98 * sqrt( n );
+	int bas = (int) floor( n / 2.0 - ecart );
+	int haut = (int) ceil( n / 2.0 + ecart );
+
+	qsort( mesures, n, sizeof(Mesure), comparer_mesures );
+	if( bas < 1 ) bas = 1;
+	if( haut > n ) haut = n;
+	resume->mediane = mesures[ n / 2 ];
+	if( n % 2 == 0 ){
+		resume->mediane.ns_par_op =
+			( mesures[ n / 2 - 1 ].ns_par_op + mesures[ n / 2 ].ns_par_op ) / 2;
+	}
+	resume->ic_bas = mesures[ bas - 1 ].ns_par_op;
+	resume->ic_haut = mesures[ haut - 1 ].ns_par_op;
+	resume->nb_repetitions = n;
+}
+
+static void ecrire_resume( const char * nom, const Resume * r ){
+	const Mesure * m = &r->mediane;
+	printf(
+		"{\"benchmark\": \"%s\", \"iterations\": %ld, \"ns_par_op\": %.1f, "
+		"\"ops_par_s\": %.1f, \"allocations_par_op\": %.2f, "
+		"\"octets_perdus_par_op\": %.1f, \"pic_alloue_ko\": %lld, "
+		"\"rss_max_ko\": %ld",
+		nom, m->nb_iterations, m->ns_par_op, 1e9 / m->ns_par_op,
+		m->allocations_par_op, m->octets_perdus_par_op, m->pic_alloue_ko,
+		m->rss_max_ko
+	);
+	if( r->nb_repetitions > 1 ){
+		printf(
+			", \"repetitions\": %d, \"ic_bas\": %.1f, \"ic_haut\": %.1f",
+			r->nb_repetitions, r->ic_bas, r->ic_haut
+		);
+	}
+	printf( "}\n" );
+}
+
+/*
+ * Les résultats de référence, lus dans un fichier écrit par ce programme
+ * (une ligne JSON par benchmark). Sans répétitions, l'intervalle de
+ * confiance est réduit à la valeur mesurée.
+ */
+typedef struct {
+	char nom[64];
+	double ns_par_op;
+	double ic_bas;
+	double ic_haut;
+} Reference;
+
+static int lire_champ( const char * ligne, const char * champ, double * valeur ){
+	char motif[64];
+	const char * p;
+	snprintf( motif, sizeof(motif), "\"%s\": ", champ );
+	p = strstr( ligne, motif );
+	if( ! p ) return 0;
+	*valeur = strtod( p + strlen( motif ), NULL );
+	return 1;
+}
+
+static Reference * lire_references( const char * fichier, int * nb ){
+	FILE * f = fopen( fichier, "r" );
+	Reference * res = NULL;
+	char ligne[1024];
+	int capacite = 0;
+
+	*nb = 0;
+	if( ! f ) return NULL;
+	while( fgets( ligne, sizeof(ligne), f ) ){
+		Reference r;
+		const char * debut = strstr( ligne, "\"benchmark\": \"" );
+		const char * fin;
+		if( ! debut ) continue;
+		debut += strlen( "\"benchmark\": \"" );
+		fin = strchr( debut, '"' );
+		if( ! fin || fin - debut >= (int) sizeof(r.nom) ) continue;
+		memcpy( r.nom, debut, fin - debut );
+		r.nom[ fin - debut ] = '\0';
+		if( ! lire_champ( ligne, "ns_par_op", &r.ns_par_op ) ) continue;
+		if( ! lire_champ( ligne, "ic_bas", &r.ic_bas ) ) r.ic_bas = r.ns_par_op;
+		if( ! lire_champ( ligne, "ic_haut", &r.ic_haut ) ) r.ic_haut = r.ns_par_op;
+		if( *nb == capacite ){
+			capacite = 2 * capacite + 16;
+			res = xrealloc( res, capacite * sizeof(Reference) );
+		}
+		res[ (*nb)++ ] = r;
+	}
+	fclose( f );
+	return res;
+}
+
+static const Reference * trouver_reference(
+	const Reference * references, int nb, const char * nom
+){
+	int i;
+	for( i = 0; i < nb; i++ ){
+		if( strcmp( references[i].nom, nom ) == 0 ) return references + i;
+	}
+	return NULL;
+}
+
+/* Écrit une ligne du tableau de comparaison, et renvoie 1 si le benchmark a
+ * régressé : sa médiane dépasse celle de la référence de plus de 'seuil'
+ * (en proportion), et les intervalles de confiance sont disjoints.
+ */
+static int comparer_a_la_reference(
+	const char * nom, const Resume * r, const Reference * reference,
+	double seuil
+){
+	double variation;
+	const char * verdict = "stable";
+	int regression = 0;
+
+	if( ! reference ){
+		printf(
+			"%-36s %14s %14.1f %9s  %s\n", nom, "-", r->mediane.ns_par_op,
+			"-", "nouveau"
+		);
+		return 0;
+	}
+	variation = r->mediane.ns_par_op / reference->ns_par_op - 1;
+	if( variation > seuil && r->ic_bas > reference->ic_haut ){
+		verdict = "REGRESSION";
+		regression = 1;
+	}else if( variation < - seuil && r->ic_haut < reference->ic_bas ){
+		verdict = "amelioration";
+	}
+	printf(
+		"%-36s %14.1f %14.1f %+8.1f%%  %s\n", nom, reference->ns_par_op,
+		r->mediane.ns_par_op, 100 * variation, verdict
+	);
+	return regression;
+}
+
+static void usage( const char * programme ){
+	fprintf(
+		stderr, "Usage : %s [-t duree_min] [-r repetitions] "
+		"[-c reference.json] [-s seuil_en_pourcents] [filtre]\n", programme
+	);
+	exit( EXIT_FAILURE );
+}
+
+int main( int argc, char ** argv ){
+	const char * filtre = "";
+	const char * fichier_reference = NULL;
+	Reference * references = NULL;
+	Mesure * mesures;
+	double duree_min = 0.2, seuil = 0.10;
+	int nb_repetitions = 0, nb_references = 0, nb_regressions = 0;
+	int i, k, resultat = EXIT_SUCCESS;
+
+	for( i = 1; i < argc; i++ ){
+		if( argv[i][0] == '-' && i + 1 >= argc ) usage( argv[0] );
+		if( strcmp( argv[i], "-t" ) == 0 ){
+			duree_min = atof( argv[++i] );
+		}else if( strcmp( argv[i], "-r" ) == 0 ){
+			nb_repetitions = atoi( argv[++i] );
+			if( nb_repetitions < 1 ) usage( argv[0] );
+		}else if( strcmp( argv[i], "-c" ) == 0 ){
+			fichier_reference = argv[++i];
+		}else if( strcmp( argv[i], "-s" ) == 0 ){
+			seuil = atof( argv[++i] ) / 100;
+		}else{
+			filtre = argv[i];
+		}
+	}
+	if( nb_repetitions == 0 ) nb_repetitions = fichier_reference ? 5 : 1;
+	if( fichier_reference && nb_repetitions < 3 ){
+		fprintf( stderr, "La comparaison demande au moins 3 repetitions.\n" );
+		return EXIT_FAILURE;
+	}
+	if( fichier_reference ){
+		references = lire_references( fichier_reference, &nb_references );
+		if( ! references ){
+			fprintf( stderr, "Reference %s illisible ou vide.\n", fichier_reference );
+			return EXIT_FAILURE;
+		}
+		printf(
+			"%-36s %14s %14s %9s  %s\n", "benchmark", "reference (ns)",
+			"actuel (ns)", "variation", "verdict"
+		);
+	}
+
+	mesures = xmalloc( nb_repetitions * sizeof(Mesure) );
+	for( i = 0; i < NB_BENCHMARKS; i++ ){
+		Resume resume;
+		if( ! strstr( benchmarks[i].nom, filtre ) ) continue;
+		for( k = 0; k < nb_repetitions; k++ ){
+			if( ! lancer_benchmark( benchmarks + i, duree_min, mesures + k ) ){
+				break;
+			}
+		}
+		if( k < nb_repetitions ){
+			fprintf( stderr, "Le benchmark %s a echoue.\n", benchmarks[i].nom );
+			resultat = EXIT_FAILURE;
+			continue;
+		}
+		resumer( mesures, nb_repetitions, &resume );
+		if( fichier_reference ){
+			nb_regressions += comparer_a_la_reference(
+				benchmarks[i].nom, &resume,
+				trouver_reference( references, nb_references, benchmarks[i].nom ),
+				seuil
+			);
+		}else{
+			ecrire_resume( benchmarks[i].nom, &resume );
+		}
+		fflush( stdout );
+	}
+	if( nb_regressions > 0 ){
+		printf(
+			"%d benchmark(s) en regression de plus de %.0f%%.\n",
+			nb_regressions, 100 * seuil
+		);
+		resultat = EXIT_FAILURE;
+	}
+	xfree( mesures );
+	xfree( references );
+	return resultat;
+}
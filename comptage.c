@@ -0,0 +1,397 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "comptage.h"
+#include "index_automate.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Tous les calculs sont faits sur le type Compte. Si 'modulo' est non nul,
+ * les nombres restent inférieurs à 'modulo' (donc à 2^64) et leur produit
+ * tient sur 128 bits. Si 'modulo' est nul, les calculs sont exacts et
+ * saturent à COMPTE_MAX.
+ */
+static inline Compte ajouter_comptes( Compte a, Compte b, uint64_t modulo ){
+	Compte res = a + b;
+	if( modulo ){
+		if( res >= modulo ) res -= modulo;
+		return res;
+	}
+	return ( res < a ) ? COMPTE_MAX : res;
+}
+
+static inline Compte multiplier_comptes( Compte a, Compte b, uint64_t modulo ){
+	if( modulo ){
+		return ( a * b ) % modulo;
+	}
+	if( a != 0 && b > COMPTE_MAX / a ) return COMPTE_MAX;
+	return a * b;
+}
+
+char * compte_vers_chaine( Compte compte, char * tampon ){
+	char chiffres[TAILLE_CHAINE_COMPTE];
+	int n = 0, i;
+	do{
+		chiffres[ n++ ] = '0' + (int) ( compte % 10 );
+		compte /= 10;
+	}while( compte );
+	for( i = 0; i < n; i++ ) tampon[i] = chiffres[ n - 1 - i ];
+	tampon[n] = '\0';
+	return tampon;
+}
+
+/*
+ * Comptage longueur par longueur.
+ *
+ * On note c_k(q) le nombre de mots de longueur k qui mènent de l'état q à un
+ * état final : c_0(q) vaut 1 si q est final et 0 sinon, et c_{k+1}(q) est la
+ * somme des c_k(r) pour toutes les transitions (q,a)->r. Le nombre de mots
+ * de longueur k reconnus est la somme des c_k(i) sur les états initiaux i.
+ */
+static void etape_comptes(
+	const Index_automate * index, const Compte * precedents, Compte * suivants,
+	uint64_t modulo
+){
+	int q, t;
+	for( q = 0; q < index->nb_etats; q++ ){
+		Compte somme = 0;
+		for( t = index->debut[q]; t < index->debut[q+1]; t++ ){
+			somme = ajouter_comptes( somme, precedents[ index->fins[t] ], modulo );
+		}
+		suivants[q] = somme;
+	}
+}
+
+static Compte somme_initiaux(
+	const Index_automate * index, const Compte * comptes, uint64_t modulo
+){
+	Compte res = 0;
+	int q;
+	for( q = 0; q < index->nb_etats; q++ ){
+		if( TESTER_BIT( index->initiaux, q ) ){
+			res = ajouter_comptes( res, comptes[q], modulo );
+		}
+	}
+	return res;
+}
+
+static Compte compter_par_longueur(
+	const Index_automate * index, uint64_t longueur, uint64_t modulo,
+	int au_plus
+){
+	int n = index->nb_etats, q, nul;
+	Compte * comptes = xmalloc( ( n + 1 ) * sizeof(Compte) );
+	Compte * suivants = xmalloc( ( n + 1 ) * sizeof(Compte) );
+	Compte un = modulo ? 1 % modulo : 1;
+	Compte res;
+	uint64_t k;
+
+	for( q = 0; q < n; q++ ){
+		comptes[q] = TESTER_BIT( index->finaux, q ) ? un : 0;
+	}
+	res = au_plus ? somme_initiaux( index, comptes, modulo ) : 0;
+	for( k = 1; k <= longueur; k++ ){
+		Compte * tmp;
+		etape_comptes( index, comptes, suivants, modulo );
+		tmp = comptes;
+		comptes = suivants;
+		suivants = tmp;
+		if( au_plus ){
+			res = ajouter_comptes( res, somme_initiaux( index, comptes, modulo ), modulo );
+		}
+		// Plus aucun chemin ne mène à un état final : les comptes suivants
+		// seront tous nuls.
+		for( nul = 1, q = 0; q < n && nul; q++ ) nul = ( comptes[q] == 0 );
+		if( nul ) break;
+	}
+	if( ! au_plus && k > longueur ){
+		res = somme_initiaux( index, comptes, modulo );
+	}
+	xfree( comptes );
+	xfree( suivants );
+	return res;
+}
+
+static void etape_poids(
+	const Index_automate * index, const long double * precedents,
+	long double * suivants
+){
+	long double plus_grand = 0;
+	int q, t;
+	for( q = 0; q < index->nb_etats; q++ ){
+		long double somme = 0;
+		for( t = index->debut[q]; t < index->debut[q+1]; t++ ){
+			somme += precedents[ index->fins[t] ];
+		}
+		suivants[q] = somme;
+		if( somme > plus_grand ) plus_grand = somme;
+	}
+	if( plus_grand > 0 ){
+		for( q = 0; q < index->nb_etats; q++ ) suivants[q] /= plus_grand;
+	}
+}
+
+Table_comptes * creer_table_comptes(
+	const Index_automate * index, int longueur
+){
+	Table_comptes * res = xmalloc( sizeof(Table_comptes) );
+	int n = index->nb_etats, q, k;
+	size_t nb_cases = (size_t) ( longueur + 1 ) * n + 1;
+
+	res->nb_etats = n;
+	res->longueur = longueur;
+	res->exacte = 1;
+	res->poids = NULL;
+	res->comptes = xmalloc( nb_cases * sizeof(Compte) );
+	for( q = 0; q < n; q++ ){
+		res->comptes[q] = TESTER_BIT( index->finaux, q ) ? 1 : 0;
+	}
+	for( k = 1; k <= longueur && res->exacte; k++ ){
+		Compte * ligne = res->comptes + (size_t) k * n;
+		etape_comptes( index, ligne - n, ligne, 0 );
+		for( q = 0; q < n && res->exacte; q++ ){
+			res->exacte = ( ligne[q] != COMPTE_MAX );
+		}
+	}
+	if( res->exacte ) return res;
+
+	// Les nombres exacts sont trop grands : on recommence avec des poids
+	// approchés.
+	xfree( res->comptes );
+	res->comptes = NULL;
+	res->poids = xmalloc( nb_cases * sizeof(long double) );
+	for( q = 0; q < n; q++ ){
+		res->poids[q] = TESTER_BIT( index->finaux, q ) ? 1 : 0;
+	}
+	for( k = 1; k <= longueur; k++ ){
+		long double * ligne = res->poids + (size_t) k * n;
+		etape_poids( index, ligne - n, ligne );
+	}
+	return res;
+}
+
+void liberer_table_comptes( Table_comptes * table ){
+	if( table ){
+		xfree( table->comptes );
+		xfree( table->poids );
+		xfree( table );
+	}
+}
+
+/*
+ * Comptage par puissances de la matrice de transition.
+ *
+ * M(i,j) est le nombre de lettres qui mènent de i à j. Si x est le vecteur
+ * ligne des états initiaux et f le vecteur colonne des états finaux, le
+ * nombre de mots de longueur k est x.M^k.f.
+ *
+ * Pour compter les mots de longueur au plus k, on ajoute à la matrice un
+ * état supplémentaire s, avec M(i,s) = f(i) et M(s,s) = 1. La coordonnée s
+ * de (x,0).M^(k+1) vaut alors la somme des x.M^j.f pour j de 0 à k.
+ *
+ * Les produits de matrices sont faits par blocs de BLOC x BLOC éléments pour
+ * que les trois blocs manipulés tiennent dans le cache.
+ */
+#define BLOC 32
+
+static void multiplier_matrices(
+	const Compte * a, const Compte * b, Compte * c, int n, uint64_t modulo
+){
+	int ii, jj, kk, i, j, k;
+	memset( c, 0, (size_t) n * n * sizeof(Compte) );
+	for( ii = 0; ii < n; ii += BLOC ){
+		int fin_i = ( ii + BLOC < n ) ? ii + BLOC : n;
+		for( kk = 0; kk < n; kk += BLOC ){
+			int fin_k = ( kk + BLOC < n ) ? kk + BLOC : n;
+			for( jj = 0; jj < n; jj += BLOC ){
+				int fin_j = ( jj + BLOC < n ) ? jj + BLOC : n;
+				for( i = ii; i < fin_i; i++ ){
+					Compte * ligne_c = c + (size_t) i * n;
+					for( k = kk; k < fin_k; k++ ){
+						Compte x = a[ (size_t) i * n + k ];
+						const Compte * ligne_b = b + (size_t) k * n;
+						if( x == 0 ) continue;
+						for( j = jj; j < fin_j; j++ ){
+							if( ligne_b[j] == 0 ) continue;
+							ligne_c[j] = ajouter_comptes(
+								ligne_c[j], multiplier_comptes( x, ligne_b[j], modulo ),
+								modulo
+							);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+static void multiplier_vecteur_matrice(
+	const Compte * v, const Compte * m, Compte * res, int n, uint64_t modulo
+){
+	int i, j;
+	memset( res, 0, n * sizeof(Compte) );
+	for( i = 0; i < n; i++ ){
+		if( v[i] == 0 ) continue;
+		for( j = 0; j < n; j++ ){
+			res[j] = ajouter_comptes(
+				res[j], multiplier_comptes( v[i], m[ (size_t) i * n + j ], modulo ),
+				modulo
+			);
+		}
+	}
+}
+
+static Compte compter_par_matrice(
+	const Index_automate * index, uint64_t longueur, uint64_t modulo,
+	int au_plus
+){
+	int n = index->nb_etats;
+	int taille = au_plus ? n + 1 : n;
+	size_t nb_cases = (size_t) taille * taille;
+	Compte * puissance = xmalloc( nb_cases * sizeof(Compte) );
+	Compte * produit = xmalloc( nb_cases * sizeof(Compte) );
+	Compte * vecteur = xmalloc( taille * sizeof(Compte) );
+	Compte * tmp = xmalloc( taille * sizeof(Compte) );
+	Compte un = modulo ? 1 % modulo : 1;
+	Compte * matrice = NULL;
+	Compte res = 0;
+	// longueur + 1 ne tient pas sur 64 bits quand longueur vaut UINT64_MAX :
+	// on élève alors à la puissance longueur, et on multiplie une fois de
+	// plus par la matrice à la fin.
+	int etape_supplementaire = au_plus && longueur == UINT64_MAX;
+	uint64_t exposant = au_plus && ! etape_supplementaire ? longueur + 1 : longueur;
+	int i, t;
+
+	memset( puissance, 0, nb_cases * sizeof(Compte) );
+	for( i = 0; i < n; i++ ){
+		for( t = index->debut[i]; t < index->debut[i+1]; t++ ){
+			Compte * caseij = puissance + (size_t) i * taille + index->fins[t];
+			*caseij = ajouter_comptes( *caseij, un, modulo );
+		}
+		vecteur[i] = TESTER_BIT( index->initiaux, i ) ? un : 0;
+	}
+	if( au_plus ){
+		for( i = 0; i < n; i++ ){
+			puissance[ (size_t) i * taille + n ] = TESTER_BIT( index->finaux, i ) ? un : 0;
+		}
+		puissance[ (size_t) n * taille + n ] = un;
+		vecteur[n] = 0;
+	}
+	if( etape_supplementaire ){
+		matrice = xmalloc( nb_cases * sizeof(Compte) );
+		memcpy( matrice, puissance, nb_cases * sizeof(Compte) );
+	}
+
+	// Exponentiation rapide, appliquée directement au vecteur ligne.
+	while( exposant ){
+		if( exposant & 1 ){
+			Compte * echange;
+			multiplier_vecteur_matrice( vecteur, puissance, tmp, taille, modulo );
+			echange = vecteur;
+			vecteur = tmp;
+			tmp = echange;
+		}
+		exposant >>= 1;
+		if( exposant ){
+			Compte * echange;
+			multiplier_matrices( puissance, puissance, produit, taille, modulo );
+			echange = puissance;
+			puissance = produit;
+			produit = echange;
+		}
+	}
+	if( matrice ){
+		Compte * echange;
+		multiplier_vecteur_matrice( vecteur, matrice, tmp, taille, modulo );
+		echange = vecteur;
+		vecteur = tmp;
+		tmp = echange;
+		xfree( matrice );
+	}
+
+	if( au_plus ){
+		res = vecteur[n];
+	}else{
+		for( i = 0; i < n; i++ ){
+			if( TESTER_BIT( index->finaux, i ) ){
+				res = ajouter_comptes( res, vecteur[i], modulo );
+			}
+		}
+	}
+
+	xfree( puissance );
+	xfree( produit );
+	xfree( vecteur );
+	xfree( tmp );
+	return res;
+}
+
+static Compte compter( const Automate * automate, uint64_t longueur,
+	uint64_t modulo, int au_plus
+){
+	Index_automate * index = creer_index_automate( automate );
+	double n = index->nb_etats;
+	double cout_longueur, cout_matrice;
+	int nb_carres = 1;
+	uint64_t l;
+	Compte res;
+
+	if( ! index_est_deterministe( index ) ){
+		ERREUR( "Le comptage des mots demande un automate deterministe" );
+	}
+
+	// Coûts approximatifs des deux méthodes.
+	for( l = longueur; l > 0; l >>= 1 ) nb_carres++;
+	cout_longueur = (double) longueur * ( index->nb_transitions + 2 * n );
+	cout_matrice = ( n + 1 ) * ( n + 1 ) * ( n + 1 ) * nb_carres;
+	if( index->nb_etats == 0 ){
+		res = 0;
+	}else if( cout_longueur <= cout_matrice ){
+		res = compter_par_longueur( index, longueur, modulo, au_plus );
+	}else{
+		res = compter_par_matrice( index, longueur, modulo, au_plus );
+	}
+	liberer_index_automate( index );
+	return res;
+}
+
+Compte compter_mots( const Automate * automate, uint64_t longueur ){
+	return compter( automate, longueur, 0, 0 );
+}
+
+Compte compter_mots_au_plus( const Automate * automate, uint64_t longueur ){
+	return compter( automate, longueur, 0, 1 );
+}
+
+uint64_t compter_mots_modulo(
+	const Automate * automate, uint64_t longueur, uint64_t modulo
+){
+	if( modulo == 0 ) ERREUR( "Le modulo doit etre non nul" );
+	return (uint64_t) compter( automate, longueur, modulo, 0 );
+}
+
+uint64_t compter_mots_au_plus_modulo(
+	const Automate * automate, uint64_t longueur, uint64_t modulo
+){
+	if( modulo == 0 ) ERREUR( "Le modulo doit etre non nul" );
+	return (uint64_t) compter( automate, longueur, modulo, 1 );
+}
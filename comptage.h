@@ -0,0 +1,159 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __COMPTAGE_H__
+#define __COMPTAGE_H__
+
+#include <stdint.h>
+
+#include "automate.h"
+#include "index_automate.h"
+
+/**
+ * \brief Le type des nombres de mots : des entiers non signés de 128 bits.
+ *
+ * Quand un calcul exact dépasse la capacité de ce type, le résultat est
+ * remplacé par COMPTE_MAX.
+ */
+typedef unsigned __int128 Compte;
+
+#define COMPTE_MAX ( (Compte) -1 )
+
+/**
+ * \brief Taille minimale du tampon à passer à compte_vers_chaine().
+ */
+#define TAILLE_CHAINE_COMPTE 40
+
+/**
+ * \brief Renvoie le nombre de mots de longueur 'longueur' reconnus par un
+ *        automate déterministe.
+ *
+ * Pour une longueur modérée, les nombres de chemins sont calculés longueur
+ * par longueur en parcourant les transitions. Pour une grande longueur, la
+ * matrice de transition de l'automate est élevée à la puissance 'longueur'
+ * par carrés successifs. La méthode la moins coûteuse est choisie
+ * automatiquement.
+ *
+ * Le programme s'arrête avec une erreur si l'automate n'est pas
+ * déterministe. Si le résultat dépasse la capacité du type Compte,
+ * COMPTE_MAX est renvoyé.
+ *
+ * \param automate Un automate déterministe
+ * \param longueur La longueur des mots
+ * \return Le nombre de mots reconnus de cette longueur
+ */
+Compte compter_mots( const Automate * automate, uint64_t longueur );
+
+/**
+ * \brief Renvoie le nombre de mots de longueur inférieure ou égale à
+ *        'longueur' reconnus par un automate déterministe.
+ *
+ * Voir compter_mots().
+ *
+ * \param automate Un automate déterministe
+ * \param longueur La longueur maximale des mots
+ * \return Le nombre de mots reconnus de longueur au plus 'longueur'
+ */
+Compte compter_mots_au_plus( const Automate * automate, uint64_t longueur );
+
+/**
+ * \brief Renvoie le nombre de mots de longueur 'longueur' reconnus par un
+ *        automate déterministe, modulo 'modulo'.
+ *
+ * Voir compter_mots(). Le modulo doit être non nul.
+ *
+ * \param automate Un automate déterministe
+ * \param longueur La longueur des mots
+ * \param modulo Le modulo
+ * \return Le nombre de mots modulo 'modulo'
+ */
+uint64_t compter_mots_modulo(
+	const Automate * automate, uint64_t longueur, uint64_t modulo
+);
+
+/**
+ * \brief Renvoie le nombre de mots de longueur inférieure ou égale à
+ *        'longueur' reconnus par un automate déterministe, modulo 'modulo'.
+ *
+ * Voir compter_mots(). Le modulo doit être non nul.
+ *
+ * \param automate Un automate déterministe
+ * \param longueur La longueur maximale des mots
+ * \param modulo Le modulo
+ * \return Le nombre de mots modulo 'modulo'
+ */
+uint64_t compter_mots_au_plus_modulo(
+	const Automate * automate, uint64_t longueur, uint64_t modulo
+);
+
+/**
+ * \brief Les nombres de chemins de chaque longueur menant de chaque état à un
+ *        état final.
+ *
+ * La case k * nb_etats + q contient le nombre de mots de longueur k qui
+ * mènent de l'état d'indice q (dans l'index) à un état final, pour k allant
+ * de 0 à 'longueur'.
+ *
+ * Si un de ces nombres dépasse la capacité du type Compte, 'exacte' vaut 0,
+ * 'comptes' est NULL et 'poids' contient des valeurs approchées : chaque
+ * ligne k est divisée par son plus grand élément, ce qui conserve les
+ * proportions entre les états pour une même longueur. Sinon, 'exacte' vaut 1
+ * et 'poids' est NULL.
+ */
+typedef struct {
+	int nb_etats;
+	int longueur;
+	int exacte;
+	Compte * comptes;
+	long double * poids;
+} Table_comptes;
+
+/**
+ * \brief Calcule la table des nombres de chemins de longueur au plus
+ *        'longueur' d'un automate indexé.
+ *
+ * La table est remplie avec le même calcul, longueur par longueur, que
+ * compter_mots().
+ *
+ * \param index Un automate indexé
+ * \param longueur La longueur maximale
+ * \return La table, à libérer avec liberer_table_comptes()
+ */
+Table_comptes * creer_table_comptes(
+	const Index_automate * index, int longueur
+);
+
+/**
+ * \brief Libère une table créée par creer_table_comptes().
+ */
+void liberer_table_comptes( Table_comptes * table );
+
+/**
+ * \brief Écrit un nombre de mots en base 10 dans le tampon passé en
+ *        paramètre, et renvoie ce tampon.
+ *
+ * \param compte Un nombre de mots
+ * \param tampon Un tampon d'au moins TAILLE_CHAINE_COMPTE caractères
+ * \return Le tampon
+ */
+char * compte_vers_chaine( Compte compte, char * tampon );
+
+#endif
@@ -0,0 +1,833 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "determinisation.h"
+#include "file_concurrente.h"
+#include "index_automate.h"
+#include "hachage.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+
+typedef struct {
+	char lettre;
+	int fin;
+} Successeur;
+
+static int comparer_successeurs( const void * a, const void * b ){
+	const Successeur * x = (const Successeur *) a;
+	const Successeur * y = (const Successeur *) b;
+	if( x->lettre != y->lettre ){
+		return ( (unsigned char) x->lettre > (unsigned char) y->lettre ) ? 1 : -1;
+	}
+	return ( x->fin > y->fin ) - ( x->fin < y->fin );
+}
+
+/*
+ * Les ensembles d'états déjà construits sont rangés les uns à la suite des
+ * autres dans 'elements' (triés, sans doublon) : l'ensemble k occupe les
+ * cases debut[k] à debut[k+1]-1. Ils sont retrouvés grâce à une table de
+ * hachage par sondage linéaire, qui contient leurs numéros (-1 : case vide).
+ */
+typedef struct {
+	int nb_ensembles;
+	int capacite_ensembles;
+	int * debut;
+	size_t nb_elements;
+	size_t capacite_elements;
+	int * elements;
+	int * table;
+	size_t masque;
+} Sous_ensembles;
+
+static uint64_t hacher_sous_ensemble( const int * elements, int nb ){
+	uint64_t h = hacher_64( nb );
+	int i;
+	for( i = 0; i < nb; i++ ) h = hacher_64( h ^ (uint32_t) elements[i] );
+	return h;
+}
+
+static void initialiser_sous_ensembles( Sous_ensembles * s ){
+	s->nb_ensembles = 0;
+	s->capacite_ensembles = 64;
+	s->debut = xmalloc( ( s->capacite_ensembles + 1 ) * sizeof(int) );
+	s->debut[0] = 0;
+	s->nb_elements = 0;
+	s->capacite_elements = 256;
+	s->elements = xmalloc( s->capacite_elements * sizeof(int) );
+	s->masque = 127;
+	s->table = xmalloc( ( s->masque + 1 ) * sizeof(int) );
+	memset( s->table, -1, ( s->masque + 1 ) * sizeof(int) );
+}
+
+static void liberer_sous_ensembles( Sous_ensembles * s ){
+	xfree( s->debut );
+	xfree( s->elements );
+	xfree( s->table );
+}
+
+static void agrandir_table_sous_ensembles( Sous_ensembles * s ){
+	int k;
+	xfree( s->table );
+	s->masque = 2 * s->masque + 1;
+	s->table = xmalloc( ( s->masque + 1 ) * sizeof(int) );
+	memset( s->table, -1, ( s->masque + 1 ) * sizeof(int) );
+	for( k = 0; k < s->nb_ensembles; k++ ){
+		size_t i = hacher_sous_ensemble(
+			s->elements + s->debut[k], s->debut[k+1] - s->debut[k]
+		) & s->masque;
+		while( s->table[i] >= 0 ) i = ( i + 1 ) & s->masque;
+		s->table[i] = k;
+	}
+}
+
+/* Renvoie le numéro de l'ensemble, dont la valeur de hachage est 'h', en
+ * l'ajoutant s'il est nouveau (*nouveau vaut alors 1).
+ */
+static int numero_sous_ensemble_hache(
+	Sous_ensembles * s, const int * elements, int nb, uint64_t h, int * nouveau
+){
+	size_t i = h & s->masque;
+	int k;
+	*nouveau = 0;
+	while( ( k = s->table[i] ) >= 0 ){
+		if( s->debut[k+1] - s->debut[k] == nb
+			&& memcmp( s->elements + s->debut[k], elements, nb * sizeof(int) ) == 0
+		){
+			return k;
+		}
+		i = ( i + 1 ) & s->masque;
+	}
+
+	*nouveau = 1;
+	k = s->nb_ensembles++;
+	if( s->nb_ensembles > s->capacite_ensembles ){
+		s->capacite_ensembles *= 2;
+		s->debut = xrealloc( s->debut, ( s->capacite_ensembles + 1 ) * sizeof(int) );
+	}
+	if( s->nb_elements + nb > s->capacite_elements ){
+		while( s->nb_elements + nb > s->capacite_elements ){
+			s->capacite_elements *= 2;
+		}
+		s->elements = xrealloc( s->elements, s->capacite_elements * sizeof(int) );
+	}
+	memcpy( s->elements + s->nb_elements, elements, nb * sizeof(int) );
+	s->nb_elements += nb;
+	s->debut[k+1] = s->nb_elements;
+	s->table[i] = k;
+	if( 2 * (size_t) s->nb_ensembles > s->masque ){
+		agrandir_table_sous_ensembles( s );
+	}
+	return k;
+}
+
+/* Renvoie le numéro de l'ensemble, en l'ajoutant s'il est nouveau.
+ */
+static int numero_sous_ensemble(
+	Sous_ensembles * s, const int * elements, int nb
+){
+	int nouveau;
+	return numero_sous_ensemble_hache(
+		s, elements, nb, hacher_sous_ensemble( elements, nb ), &nouveau
+	);
+}
+
+/* Calcule les transitions d'un ensemble d'états, triées par lettre puis
+ * par état d'arrivée : chaque lettre donne un ensemble d'arrivée trié, dont
+ * les doublons sont consécutifs. Le tableau des successeurs est agrandi si
+ * besoin. Renvoie le nombre de transitions, et indique dans *final si
+ * l'ensemble contient un état final.
+ */
+static int calculer_successeurs(
+	const Index_automate * index, const int * elements, int nb,
+	Successeur ** successeurs, int * capacite, int * final
+){
+	int nb_successeurs = 0, i, t;
+
+	*final = 0;
+	for( i = 0; i < nb; i++ ){
+		int e = elements[i];
+		nb_successeurs += index->debut[e+1] - index->debut[e];
+		*final |= TESTER_BIT( index->finaux, e );
+	}
+	if( nb_successeurs > *capacite ){
+		*capacite = 2 * nb_successeurs;
+		*successeurs = xrealloc( *successeurs, *capacite * sizeof(Successeur) );
+	}
+	nb_successeurs = 0;
+	for( i = 0; i < nb; i++ ){
+		int e = elements[i];
+		for( t = index->debut[e]; t < index->debut[e+1]; t++ ){
+			(*successeurs)[ nb_successeurs ].lettre = index->lettres[t];
+			(*successeurs)[ nb_successeurs ].fin = index->fins[t];
+			nb_successeurs++;
+		}
+	}
+	// Sans successeur, le tableau peut encore être NULL.
+	if( nb_successeurs > 1 ){
+		qsort( *successeurs, nb_successeurs, sizeof(Successeur), comparer_successeurs );
+	}
+	return nb_successeurs;
+}
+
+/* Écrit dans 'ensemble' l'ensemble d'arrivée par la lettre du successeur
+ * 'i', et renvoie l'indice du premier successeur de la lettre suivante.
+ */
+static int ensemble_d_arrivee(
+	const Successeur * successeurs, int nb_successeurs, int i,
+	int * ensemble, int * nb
+){
+	char lettre = successeurs[i].lettre;
+	*nb = 0;
+	for( ; i < nb_successeurs && successeurs[i].lettre == lettre; i++ ){
+		if( *nb == 0 || ensemble[ *nb - 1 ] != successeurs[i].fin ){
+			ensemble[ (*nb)++ ] = successeurs[i].fin;
+		}
+	}
+	return i;
+}
+
+Automate * creer_automate_deterministe( const Automate * automate ){
+	Index_automate * index = creer_index_automate( automate );
+	Automate * res = creer_automate();
+	Sous_ensembles s;
+	int n = index->nb_etats;
+	int * ensemble = xmalloc( ( n + 1 ) * sizeof(int) );
+	Successeur * successeurs = NULL;
+	int capacite_successeurs = 0;
+	int nb, k, i;
+
+	initialiser_sous_ensembles( &s );
+	for( i = 0; i < index->taille_alphabet; i++ ){
+		ajouter_lettre( res, index->alphabet[i] );
+	}
+	nb = 0;
+	for( i = 0; i < n; i++ ){
+		if( TESTER_BIT( index->initiaux, i ) ) ensemble[ nb++ ] = i;
+	}
+	// Sans état initial, l'automate n'a aucun état.
+	if( nb > 0 ){
+		numero_sous_ensemble( &s, ensemble, nb );
+		ajouter_etat( res, 0 );
+		ajouter_etat_initial( res, 0 );
+	}
+
+	// Les ensembles sont traités dans l'ordre de leur création : c'est un
+	// parcours en largeur.
+	for( k = 0; k < s.nb_ensembles; k++ ){
+		int final;
+		int nb_successeurs = calculer_successeurs(
+			index, s.elements + s.debut[k], s.debut[k+1] - s.debut[k],
+			&successeurs, &capacite_successeurs, &final
+		);
+		if( final ) ajouter_etat_final( res, k );
+
+		for( i = 0; i < nb_successeurs; ){
+			char lettre = successeurs[i].lettre;
+			i = ensemble_d_arrivee( successeurs, nb_successeurs, i, ensemble, &nb );
+			ajouter_transition(
+				res, k, lettre, numero_sous_ensemble( &s, ensemble, nb )
+			);
+		}
+	}
+
+	xfree( successeurs );
+	xfree( ensemble );
+	liberer_sous_ensembles( &s );
+	liberer_index_automate( index );
+	return res;
+}
+
+/*
+ * Déterminisation parallèle.
+ *
+ * Les ensembles construits sont répartis entre NB_FRAGMENTS tables
+ * (Sous_ensembles), chacune protégée par son verrou, selon les bits de
+ * poids fort de leur valeur de hachage. Le numéro provisoire de l'ensemble
+ * k du fragment f est k * NB_FRAGMENTS + f : il ne dépend que du fragment,
+ * et aucun compteur global n'est partagé.
+ *
+ * Chaque fil a sa deque de vol de travail : il y empile les ensembles qu'il
+ * crée, les traite, et vole ceux des autres fils quand la sienne est vide.
+ * Les transitions trouvées sont écrites dans un tableau propre à chaque
+ * fil. Le nombre d'ensembles créés mais pas encore traités dit quand le
+ * travail est fini.
+ *
+ * À la fin, les ensembles sont renumérotés par le parcours en largeur de la
+ * version séquentielle : les deux automates sont identiques.
+ */
+
+#define BITS_FRAGMENTS 6
+#define NB_FRAGMENTS ( 1 << BITS_FRAGMENTS )
+
+typedef struct {
+	pthread_mutex_t verrou;
+	Sous_ensembles ensembles;
+} Fragment;
+
+typedef struct {
+	int origine;
+	int fin;
+	char lettre;
+} Transition_provisoire;
+
+typedef struct _Donnees_determinisation Donnees_determinisation;
+
+typedef struct {
+	Donnees_determinisation * donnees;
+	int numero;
+	Deque_vol * deque;
+	Transition_provisoire * transitions;
+	size_t nb_transitions;
+	size_t capacite_transitions;
+	int * finaux;
+	int nb_finaux;
+	int capacite_finaux;
+} Travailleur;
+
+struct _Donnees_determinisation {
+	const Index_automate * index;
+	Fragment fragments[ NB_FRAGMENTS ];
+	Travailleur * travailleurs;
+	int nb_fils;
+	long en_attente;
+};
+
+static int fragment_du_hachage( uint64_t h ){
+	return h >> ( 64 - BITS_FRAGMENTS );
+}
+
+/* Renvoie le numéro provisoire de l'ensemble, en l'ajoutant (et en le
+ * mettant dans la deque du travailleur) s'il est nouveau.
+ */
+static int numero_provisoire( Travailleur * w, const int * elements, int nb ){
+	Donnees_determinisation * d = w->donnees;
+	uint64_t h = hacher_sous_ensemble( elements, nb );
+	int f = fragment_du_hachage( h ), nouveau, k;
+
+	pthread_mutex_lock( &d->fragments[f].verrou );
+	k = numero_sous_ensemble_hache(
+		&d->fragments[f].ensembles, elements, nb, h, &nouveau
+	);
+	pthread_mutex_unlock( &d->fragments[f].verrou );
+	k = k * NB_FRAGMENTS + f;
+	if( nouveau ){
+		__atomic_add_fetch( &d->en_attente, 1, __ATOMIC_RELAXED );
+		empiler_deque_vol( w->deque, k );
+	}
+	return k;
+}
+
+static void traiter_ensemble(
+	Travailleur * w, int numero, int ** ensemble, int * capacite_ensemble,
+	Successeur ** successeurs, int * capacite_successeurs, int * arrivee
+){
+	Donnees_determinisation * d = w->donnees;
+	Fragment * fragment = &d->fragments[ numero % NB_FRAGMENTS ];
+	Sous_ensembles * s = &fragment->ensembles;
+	int k = numero / NB_FRAGMENTS, nb, nb_successeurs, final, i;
+
+	// L'ensemble est recopié : la table du fragment peut être agrandie par
+	// un autre fil.
+	pthread_mutex_lock( &fragment->verrou );
+	nb = s->debut[k+1] - s->debut[k];
+	if( nb > *capacite_ensemble ){
+		*capacite_ensemble = 2 * nb;
+		*ensemble = xrealloc( *ensemble, *capacite_ensemble * sizeof(int) );
+	}
+	memcpy( *ensemble, s->elements + s->debut[k], nb * sizeof(int) );
+	pthread_mutex_unlock( &fragment->verrou );
+
+	nb_successeurs = calculer_successeurs(
+		d->index, *ensemble, nb, successeurs, capacite_successeurs, &final
+	);
+	if( final ){
+		if( w->nb_finaux == w->capacite_finaux ){
+			w->capacite_finaux = 2 * w->capacite_finaux + 16;
+			w->finaux = xrealloc( w->finaux, w->capacite_finaux * sizeof(int) );
+		}
+		w->finaux[ w->nb_finaux++ ] = numero;
+	}
+	for( i = 0; i < nb_successeurs; ){
+		Transition_provisoire * t;
+		char lettre = (*successeurs)[i].lettre;
+		i = ensemble_d_arrivee( *successeurs, nb_successeurs, i, arrivee, &nb );
+		if( w->nb_transitions == w->capacite_transitions ){
+			w->capacite_transitions = 2 * w->capacite_transitions + 64;
+			w->transitions = xrealloc(
+				w->transitions,
+				w->capacite_transitions * sizeof(Transition_provisoire)
+			);
+		}
+		t = &w->transitions[ w->nb_transitions++ ];
+		t->origine = numero;
+		t->lettre = lettre;
+		t->fin = numero_provisoire( w, arrivee, nb );
+	}
+}
+
+/* Prend un ensemble à traiter : dans la deque du fil, sinon chez les
+ * autres fils. Renvoie 0 si aucun n'a été trouvé.
+ */
+static int prendre_ensemble( Travailleur * w, intptr_t * numero ){
+	Donnees_determinisation * d = w->donnees;
+	int i;
+	if( depiler_deque_vol( w->deque, numero ) ) return 1;
+	for( i = 1; i < d->nb_fils; i++ ){
+		Travailleur * victime = &d->travailleurs[ ( w->numero + i ) % d->nb_fils ];
+		Resultat_vol vol;
+		while( ( vol = voler_deque_vol( victime->deque, numero ) ) == VOL_CONFLIT );
+		if( vol == VOL_REUSSI ) return 1;
+	}
+	return 0;
+}
+
+static void * travailler( void * donnees ){
+	Travailleur * w = donnees;
+	Donnees_determinisation * d = w->donnees;
+	int n = d->index->nb_etats;
+	int capacite_ensemble = n + 1, capacite_successeurs = 0;
+	int * ensemble = xmalloc( capacite_ensemble * sizeof(int) );
+	int * arrivee = xmalloc( ( n + 1 ) * sizeof(int) );
+	Successeur * successeurs = NULL;
+	intptr_t numero;
+
+	while( __atomic_load_n( &d->en_attente, __ATOMIC_ACQUIRE ) > 0 ){
+		if( prendre_ensemble( w, &numero ) ){
+			traiter_ensemble(
+				w, numero, &ensemble, &capacite_ensemble,
+				&successeurs, &capacite_successeurs, arrivee
+			);
+			// Les ensembles créés ont été comptés avant que celui-ci ne
+			// soit décompté : le compteur ne s'annule qu'à la fin.
+			__atomic_sub_fetch( &d->en_attente, 1, __ATOMIC_RELEASE );
+		}else{
+			sched_yield();
+		}
+	}
+	xfree( successeurs );
+	xfree( arrivee );
+	xfree( ensemble );
+	return NULL;
+}
+
+Automate * creer_automate_deterministe_parallele(
+	const Automate * automate, int nb_fils
+){
+	Index_automate * index = creer_index_automate( automate );
+	Donnees_determinisation d;
+	Automate * res = creer_automate();
+	pthread_t * fils;
+	int decalage[ NB_FRAGMENTS + 1 ];
+	int * ensemble = xmalloc( ( index->nb_etats + 1 ) * sizeof(int) );
+	int * debut, * numeros, * file;
+	int * origines, * fins;
+	char * lettres;
+	size_t nb_transitions = 0, m;
+	int nb_ensembles, nb, f, i, k, initial;
+	int debut_file = 0, fin_file = 0;
+
+	nb = 0;
+	for( i = 0; i < index->nb_etats; i++ ){
+		if( TESTER_BIT( index->initiaux, i ) ) ensemble[ nb++ ] = i;
+	}
+	// Sans état initial, l'automate n'a aucun état.
+	if( nb == 0 ){
+		for( i = 0; i < index->taille_alphabet; i++ ){
+			ajouter_lettre( res, index->alphabet[i] );
+		}
+		xfree( ensemble );
+		liberer_index_automate( index );
+		return res;
+	}
+
+	if( nb_fils <= 0 ) nb_fils = sysconf( _SC_NPROCESSORS_ONLN );
+	if( nb_fils <= 0 ) nb_fils = 1;
+	d.index = index;
+	d.nb_fils = nb_fils;
+	d.en_attente = 0;
+	for( f = 0; f < NB_FRAGMENTS; f++ ){
+		pthread_mutex_init( &d.fragments[f].verrou, NULL );
+		initialiser_sous_ensembles( &d.fragments[f].ensembles );
+	}
+	d.travailleurs = xmalloc( nb_fils * sizeof(Travailleur) );
+	memset( d.travailleurs, 0, nb_fils * sizeof(Travailleur) );
+	for( i = 0; i < nb_fils; i++ ){
+		d.travailleurs[i].donnees = &d;
+		d.travailleurs[i].numero = i;
+		d.travailleurs[i].deque = creer_deque_vol();
+	}
+
+	initial = numero_provisoire( &d.travailleurs[0], ensemble, nb );
+
+	fils = xmalloc( nb_fils * sizeof(pthread_t) );
+	for( i = 1; i < nb_fils; i++ ){
+		if( pthread_create( &fils[i], NULL, travailler, &d.travailleurs[i] ) ){
+			ERREUR( "Impossible de creer un fil d'execution" );
+		}
+	}
+	travailler( &d.travailleurs[0] );
+	for( i = 1; i < nb_fils; i++ ) pthread_join( fils[i], NULL );
+	xfree( fils );
+
+	// Les numéros provisoires deviennent des indices consécutifs : l'ensemble
+	// k du fragment f a l'indice decalage[f] + k.
+	decalage[0] = 0;
+	for( f = 0; f < NB_FRAGMENTS; f++ ){
+		decalage[f+1] = decalage[f] + d.fragments[f].ensembles.nb_ensembles;
+	}
+	nb_ensembles = decalage[ NB_FRAGMENTS ];
+#define INDICE( numero ) \
+	( decalage[ (numero) % NB_FRAGMENTS ] + (numero) / NB_FRAGMENTS )
+
+	// Les transitions, rangées par origine. Celles d'un même ensemble ont
+	// été écrites ensemble, par lettre croissante, par un seul fil.
+	debut = xmalloc( ( nb_ensembles + 1 ) * sizeof(int) );
+	memset( debut, 0, ( nb_ensembles + 1 ) * sizeof(int) );
+	for( i = 0; i < nb_fils; i++ ){
+		Travailleur * w = &d.travailleurs[i];
+		for( m = 0; m < w->nb_transitions; m++ ){
+			debut[ INDICE( w->transitions[m].origine ) + 1 ]++;
+		}
+		nb_transitions += w->nb_transitions;
+	}
+	for( k = 0; k < nb_ensembles; k++ ) debut[k+1] += debut[k];
+	origines = xmalloc( ( nb_transitions + 1 ) * sizeof(int) );
+	lettres = xmalloc( nb_transitions + 1 );
+	fins = xmalloc( ( nb_transitions + 1 ) * sizeof(int) );
+	numeros = xmalloc( ( nb_ensembles + 1 ) * sizeof(int) );
+	memcpy( numeros, debut, nb_ensembles * sizeof(int) );
+	for( i = 0; i < nb_fils; i++ ){
+		Travailleur * w = &d.travailleurs[i];
+		for( m = 0; m < w->nb_transitions; m++ ){
+			int position = numeros[ INDICE( w->transitions[m].origine ) ]++;
+			lettres[ position ] = w->transitions[m].lettre;
+			fins[ position ] = INDICE( w->transitions[m].fin );
+		}
+	}
+
+	// Renumérotation par un parcours en largeur depuis l'ensemble initial,
+	// les lettres dans l'ordre croissant.
+	file = xmalloc( ( nb_ensembles + 1 ) * sizeof(int) );
+	for( k = 0; k < nb_ensembles; k++ ) numeros[k] = -1;
+	numeros[ INDICE( initial ) ] = 0;
+	file[ fin_file++ ] = INDICE( initial );
+	while( debut_file < fin_file ){
+		k = file[ debut_file++ ];
+		for( i = debut[k]; i < debut[k+1]; i++ ){
+			if( numeros[ fins[i] ] < 0 ){
+				numeros[ fins[i] ] = fin_file;
+				file[ fin_file++ ] = fins[i];
+			}
+		}
+	}
+	for( k = 0; k < nb_ensembles; k++ ){
+		for( i = debut[k]; i < debut[k+1]; i++ ){
+			origines[i] = numeros[k];
+			fins[i] = numeros[ fins[i] ];
+		}
+	}
+#undef INDICE
+
+	for( i = 0; i < index->taille_alphabet; i++ ){
+		ajouter_lettre( res, index->alphabet[i] );
+	}
+	ajouter_transitions_en_bloc( res, origines, lettres, fins, nb_transitions );
+	for( k = 0; k < nb_ensembles; k++ ) ajouter_etat( res, k );
+	ajouter_etat_initial( res, 0 );
+	for( i = 0; i < nb_fils; i++ ){
+		Travailleur * w = &d.travailleurs[i];
+		for( k = 0; k < w->nb_finaux; k++ ){
+			int indice = decalage[ w->finaux[k] % NB_FRAGMENTS ]
+				+ w->finaux[k] / NB_FRAGMENTS;
+			ajouter_etat_final( res, numeros[ indice ] );
+		}
+		xfree( w->transitions );
+		xfree( w->finaux );
+		liberer_deque_vol( w->deque );
+	}
+
+	for( f = 0; f < NB_FRAGMENTS; f++ ){
+		pthread_mutex_destroy( &d.fragments[f].verrou );
+		liberer_sous_ensembles( &d.fragments[f].ensembles );
+	}
+	xfree( d.travailleurs );
+	xfree( file );
+	xfree( numeros );
+	xfree( origines );
+	xfree( lettres );
+	xfree( fins );
+	xfree( debut );
+	xfree( ensemble );
+	liberer_index_automate( index );
+	return res;
+}
+
+/*
+ * Minimisation de Hopcroft.
+ *
+ * Les blocs de la partition sont des intervalles du tableau 'elements' :
+ * le bloc b occupe les cases premier[b] à dernier[b]-1, et position[e] donne
+ * la case de l'état e. Pour séparer un bloc, on déplace ses états marqués au
+ * début de son intervalle ; le bloc des états marqués devient un nouveau
+ * bloc.
+ */
+typedef struct {
+	int * elements;
+	int * position;
+	int * bloc;
+	int * premier;
+	int * dernier;
+	int * marques;
+	int nb_blocs;
+
+	// Les couples (bloc, lettre) à traiter
+	int * attente;
+	int nb_attente;
+	int capacite_attente;
+	char * en_attente;
+	int taille_alphabet;
+} Partition;
+
+static void mettre_en_attente( Partition * p, int bloc, int lettre ){
+	if( p->en_attente[ (size_t) bloc * p->taille_alphabet + lettre ] ) return;
+	p->en_attente[ (size_t) bloc * p->taille_alphabet + lettre ] = 1;
+	if( p->nb_attente == p->capacite_attente ){
+		p->capacite_attente *= 2;
+		p->attente = xrealloc( p->attente, p->capacite_attente * 2 * sizeof(int) );
+	}
+	p->attente[ 2 * p->nb_attente ] = bloc;
+	p->attente[ 2 * p->nb_attente + 1 ] = lettre;
+	p->nb_attente++;
+}
+
+static void marquer_etat( Partition * p, int e, int * touches, int * nb_touches ){
+	int b = p->bloc[e];
+	int j = p->premier[b] + p->marques[b];
+	int autre = p->elements[j];
+	if( p->position[e] < j ) return;
+	p->elements[ p->position[e] ] = autre;
+	p->position[autre] = p->position[e];
+	p->elements[j] = e;
+	p->position[e] = j;
+	if( p->marques[b]++ == 0 ) touches[ (*nb_touches)++ ] = b;
+}
+
+static void separer_bloc( Partition * p, int b ){
+	int m = p->marques[b], nouveau, i, a;
+	p->marques[b] = 0;
+	if( m == p->dernier[b] - p->premier[b] ) return;
+
+	nouveau = p->nb_blocs++;
+	p->premier[nouveau] = p->premier[b];
+	p->dernier[nouveau] = p->premier[b] + m;
+	p->marques[nouveau] = 0;
+	p->premier[b] += m;
+	for( i = p->premier[nouveau]; i < p->dernier[nouveau]; i++ ){
+		p->bloc[ p->elements[i] ] = nouveau;
+	}
+	for( a = 0; a < p->taille_alphabet; a++ ){
+		if( p->en_attente[ (size_t) b * p->taille_alphabet + a ]
+			|| m <= p->dernier[b] - p->premier[b]
+		){
+			mettre_en_attente( p, nouveau, a );
+		}else{
+			mettre_en_attente( p, b, a );
+		}
+	}
+}
+
+Automate * creer_automate_minimal( const Automate * automate ){
+	Index_automate * index = creer_index_automate( automate );
+	Automate * res = creer_automate();
+	Partition p;
+	int n, s, N, nb_cles, i, a, t, e;
+	int rang[256];
+	int * transitions, * debut_inverse, * inverse, * copie, * touches;
+	int * numeros, * file, nb_numeros, initial, puits;
+
+	if( ! index_est_deterministe( index ) ){
+		Automate * deterministe = creer_automate_deterministe( automate );
+		liberer_index_automate( index );
+		index = creer_index_automate( deterministe );
+		liberer_automate( deterministe );
+	}
+	n = index->nb_etats;
+	s = index->taille_alphabet;
+	N = n + 1;
+	puits = n;
+	for( a = 0; a < s; a++ ){
+		rang[ (unsigned char) index->alphabet[a] ] = a;
+		ajouter_lettre( res, index->alphabet[a] );
+	}
+
+	// L'automate complété par le puits, et ses transitions inverses
+	nb_cles = N * s;
+	transitions = xmalloc( ( nb_cles + 1 ) * sizeof(int) );
+	for( i = 0; i < nb_cles; i++ ) transitions[i] = puits;
+	for( e = 0; e < n; e++ ){
+		for( t = index->debut[e]; t < index->debut[e+1]; t++ ){
+			transitions[ e * s + rang[ (unsigned char) index->lettres[t] ] ] =
+				index->fins[t];
+		}
+	}
+	debut_inverse = xmalloc( ( nb_cles + 1 ) * sizeof(int) );
+	inverse = xmalloc( ( nb_cles + 1 ) * sizeof(int) );
+	memset( debut_inverse, 0, ( nb_cles + 1 ) * sizeof(int) );
+	for( e = 0; e < N; e++ ){
+		for( a = 0; a < s; a++ ){
+			debut_inverse[ a * N + transitions[ e * s + a ] + 1 ]++;
+		}
+	}
+	for( i = 0; i < nb_cles; i++ ) debut_inverse[i+1] += debut_inverse[i];
+	for( e = 0; e < N; e++ ){
+		for( a = 0; a < s; a++ ){
+			inverse[ debut_inverse[ a * N + transitions[ e * s + a ] ]++ ] = e;
+		}
+	}
+	for( i = nb_cles; i > 0; i-- ) debut_inverse[i] = debut_inverse[i-1];
+	debut_inverse[0] = 0;
+
+	// La partition initiale : les états finaux, puis les autres
+	p.elements = xmalloc( N * sizeof(int) );
+	p.position = xmalloc( N * sizeof(int) );
+	p.bloc = xmalloc( N * sizeof(int) );
+	p.premier = xmalloc( N * sizeof(int) );
+	p.dernier = xmalloc( N * sizeof(int) );
+	p.marques = xmalloc( N * sizeof(int) );
+	p.taille_alphabet = s;
+	p.en_attente = xmalloc( (size_t) N * s + 1 );
+	memset( p.en_attente, 0, (size_t) N * s + 1 );
+	p.capacite_attente = 64;
+	p.attente = xmalloc( p.capacite_attente * 2 * sizeof(int) );
+	p.nb_attente = 0;
+	p.nb_blocs = 1;
+	p.premier[0] = 0;
+	p.dernier[0] = N;
+	p.marques[0] = 0;
+	for( e = 0; e < N; e++ ){
+		p.elements[e] = e;
+		p.position[e] = e;
+		p.bloc[e] = 0;
+	}
+	touches = xmalloc( N * sizeof(int) );
+	copie = xmalloc( N * sizeof(int) );
+	{
+		int nb_touches = 0;
+		for( e = 0; e < n; e++ ){
+			if( TESTER_BIT( index->finaux, e ) ){
+				marquer_etat( &p, e, touches, &nb_touches );
+			}
+		}
+		if( nb_touches ){
+			// Toutes les lettres pour l'un des deux blocs suffisent.
+			int m = p.marques[0];
+			p.marques[0] = 0;
+			if( m < N ){
+				p.nb_blocs = 2;
+				p.premier[1] = 0;
+				p.dernier[1] = m;
+				p.marques[1] = 0;
+				p.premier[0] = m;
+				for( i = 0; i < m; i++ ) p.bloc[ p.elements[i] ] = 1;
+				for( a = 0; a < s; a++ ){
+					mettre_en_attente( &p, ( 2 * m <= N ) ? 1 : 0, a );
+				}
+			}
+		}
+	}
+
+	while( p.nb_attente > 0 ){
+		int nb_touches = 0, nb_copie = 0;
+		int c, cle;
+		p.nb_attente--;
+		c = p.attente[ 2 * p.nb_attente ];
+		a = p.attente[ 2 * p.nb_attente + 1 ];
+		p.en_attente[ (size_t) c * s + a ] = 0;
+
+		// Le bloc c peut être modifié par les marquages : on le copie.
+		for( i = p.premier[c]; i < p.dernier[c]; i++ ){
+			copie[ nb_copie++ ] = p.elements[i];
+		}
+		for( i = 0; i < nb_copie; i++ ){
+			cle = a * N + copie[i];
+			for( t = debut_inverse[cle]; t < debut_inverse[cle+1]; t++ ){
+				marquer_etat( &p, inverse[t], touches, &nb_touches );
+			}
+		}
+		for( i = 0; i < nb_touches; i++ ) separer_bloc( &p, touches[i] );
+	}
+
+	// Les blocs accessibles, numérotés par un parcours en largeur
+	numeros = xmalloc( N * sizeof(int) );
+	file = xmalloc( N * sizeof(int) );
+	for( i = 0; i < p.nb_blocs; i++ ) numeros[i] = -1;
+	initial = -1;
+	for( e = 0; e < n; e++ ){
+		if( TESTER_BIT( index->initiaux, e ) ) initial = e;
+	}
+	// Un langage vide donne un automate sans état, comme la
+	// déterminisation d'un automate sans état initial.
+	nb_numeros = 0;
+	if( initial >= 0 && p.bloc[initial] != p.bloc[puits] ){
+		numeros[ p.bloc[initial] ] = nb_numeros;
+		file[ nb_numeros++ ] = p.bloc[initial];
+	}
+	for( i = 0; i < nb_numeros; i++ ){
+		int b = file[i];
+		int representant = p.elements[ p.premier[b] ];
+		ajouter_etat( res, i );
+		if( TESTER_BIT( index->finaux, representant ) ){
+			ajouter_etat_final( res, i );
+		}
+		for( a = 0; a < s; a++ ){
+			int cible = p.bloc[ transitions[ representant * s + a ] ];
+			if( cible == p.bloc[puits] ) continue;
+			if( numeros[cible] < 0 ){
+				numeros[cible] = nb_numeros;
+				file[ nb_numeros++ ] = cible;
+			}
+			ajouter_transition( res, i, index->alphabet[a], numeros[cible] );
+		}
+	}
+	if( nb_numeros > 0 ) ajouter_etat_initial( res, 0 );
+
+	xfree( numeros );
+	xfree( file );
+	xfree( transitions );
+	xfree( debut_inverse );
+	xfree( inverse );
+	xfree( touches );
+	xfree( copie );
+	xfree( p.elements );
+	xfree( p.position );
+	xfree( p.bloc );
+	xfree( p.premier );
+	xfree( p.dernier );
+	xfree( p.marques );
+	xfree( p.en_attente );
+	xfree( p.attente );
+	liberer_index_automate( index );
+	return res;
+}
@@ -0,0 +1,83 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __DETERMINISATION_H__
+#define __DETERMINISATION_H__
+
+#include "automate.h"
+
+/**
+ * \brief Renvoie un automate déterministe qui reconnaît le même langage que
+ *        l'automate passé en paramètre (construction des sous-ensembles).
+ *
+ * Seuls les ensembles d'états accessibles sont construits, et l'automate
+ * obtenu n'est pas complété : l'ensemble vide n'est pas un état. Les états
+ * sont numérotés à partir de 0 dans l'ordre d'un parcours en largeur depuis
+ * l'état initial, qui essaie les lettres dans l'ordre croissant : l'état
+ * initial est 0. Si l'automate n'a pas d'état initial, le résultat n'a
+ * aucun état (seulement l'alphabet).
+ *
+ * \param automate Un automate
+ * \return Un automate déterministe
+ */
+Automate * creer_automate_deterministe( const Automate * automate );
+
+/**
+ * \brief Comme creer_automate_deterministe(), avec 'nb_fils' fils
+ *        d'exécution.
+ *
+ * Les fils se partagent les ensembles d'états à explorer par vol de
+ * travail, et les ensembles construits sont rangés dans une table de
+ * hachage découpée en fragments, chacun protégé par un verrou. Les états
+ * sont ensuite renumérotés comme dans la version séquentielle : le
+ * résultat est identique à celui de creer_automate_deterministe().
+ *
+ * \param automate Un automate
+ * \param nb_fils Le nombre de fils (tous les cœurs si nb_fils <= 0)
+ * \return Un automate déterministe
+ */
+Automate * creer_automate_deterministe_parallele(
+	const Automate * automate, int nb_fils
+);
+
+/**
+ * \brief Renvoie l'automate déterministe minimal qui reconnaît le même
+ *        langage que l'automate passé en paramètre.
+ *
+ * L'automate est d'abord déterminisé s'il ne l'est pas. Les classes d'états
+ * équivalents sont ensuite calculées par l'algorithme de Hopcroft, sur
+ * l'automate complété par un état puits. Les états inutiles (ceux qui sont
+ * équivalents à l'état puits, et ceux qui ne sont pas accessibles) sont
+ * supprimés.
+ *
+ * Les états sont numérotés comme par creer_automate_deterministe() : deux
+ * automates qui reconnaissent le même langage donnent donc le même automate
+ * minimal, aux lettres de l'alphabet près. Si le langage est vide (en
+ * particulier si l'automate n'a pas d'état initial), le résultat n'a aucun
+ * état, comme celui de creer_automate_deterministe() pour un automate sans
+ * état initial.
+ *
+ * \param automate Un automate
+ * \return L'automate minimal
+ */
+Automate * creer_automate_minimal( const Automate * automate );
+
+#endif
@@ -0,0 +1,262 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "dictionnaire.h"
+#include "hachage.h"
+#include "outils.h"
+
+#include <string.h>
+
+/*
+ * Les états définitifs sont numérotés dans l'ordre où ils sont construits, et
+ * leurs transitions sont rangées les unes à la suite des autres : celles de
+ * l'état e occupent les cases debut[e] à debut[e+1]-1 de 'lettres' et
+ * 'cibles'.
+ *
+ * Les états du chemin du dernier mot ne sont pas encore définitifs. Leurs
+ * transitions sont empilées dans 'pile' : celles de l'état de profondeur d
+ * commencent à base[d], et sont toujours en haut de la pile quand cet état
+ * quitte le chemin, car les états plus profonds l'ont quitté avant lui.
+ */
+typedef struct {
+	int nb_etats;
+	int capacite_etats;
+	int * debut;
+	char * finaux;
+
+	int nb_transitions;
+	int capacite_transitions;
+	char * lettres;
+	int * cibles;
+
+	// La table des états définitifs, par sondage linéaire (-1 : case vide)
+	int * registre;
+	size_t masque_registre;
+
+	// Le chemin du dernier mot
+	int profondeur_max;
+	int sommet;
+	int capacite_pile;
+	char * lettres_pile;
+	int * cibles_pile;
+	int * base;
+	char * finaux_chemin;
+} Dictionnaire;
+
+static uint64_t hacher_etat(
+	int final, const char * lettres, const int * cibles, int nb
+){
+	uint64_t h = hacher_64( final + 1 );
+	int i;
+	for( i = 0; i < nb; i++ ){
+		h = hacher_64(
+			h ^ ( ( (uint64_t) (unsigned char) lettres[i] << 32 ) | (uint32_t) cibles[i] )
+		);
+	}
+	return h;
+}
+
+static int meme_etat(
+	const Dictionnaire * d, int etat,
+	int final, const char * lettres, const int * cibles, int nb
+){
+	int debut = d->debut[etat];
+	return d->finaux[etat] == final
+		&& d->debut[etat+1] - debut == nb
+		&& memcmp( d->lettres + debut, lettres, nb ) == 0
+		&& memcmp( d->cibles + debut, cibles, nb * sizeof(int) ) == 0;
+}
+
+static void agrandir_registre( Dictionnaire * d ){
+	size_t nb_cases = 2 * ( d->masque_registre + 1 );
+	int e;
+	xfree( d->registre );
+	d->registre = xmalloc( nb_cases * sizeof(int) );
+	memset( d->registre, -1, nb_cases * sizeof(int) );
+	d->masque_registre = nb_cases - 1;
+	for( e = 0; e < d->nb_etats; e++ ){
+		int debut = d->debut[e], nb = d->debut[e+1] - debut;
+		size_t i = hacher_etat(
+			d->finaux[e], d->lettres + debut, d->cibles + debut, nb
+		) & d->masque_registre;
+		while( d->registre[i] >= 0 ) i = ( i + 1 ) & d->masque_registre;
+		d->registre[i] = e;
+	}
+}
+
+/* Renvoie le numéro de l'état définitif équivalent à l'état décrit, en le
+ * créant s'il n'existe pas encore.
+ */
+static int enregistrer_etat(
+	Dictionnaire * d, int final, const char * lettres, const int * cibles, int nb
+){
+	size_t i = hacher_etat( final, lettres, cibles, nb ) & d->masque_registre;
+	int e;
+	while( ( e = d->registre[i] ) >= 0 ){
+		if( meme_etat( d, e, final, lettres, cibles, nb ) ) return e;
+		i = ( i + 1 ) & d->masque_registre;
+	}
+
+	e = d->nb_etats++;
+	if( d->nb_etats >= d->capacite_etats ){
+		d->capacite_etats *= 2;
+		d->debut = xrealloc( d->debut, ( d->capacite_etats + 1 ) * sizeof(int) );
+		d->finaux = xrealloc( d->finaux, d->capacite_etats );
+	}
+	if( d->nb_transitions + nb > d->capacite_transitions ){
+		while( d->nb_transitions + nb > d->capacite_transitions ){
+			d->capacite_transitions *= 2;
+		}
+		d->lettres = xrealloc( d->lettres, d->capacite_transitions );
+		d->cibles = xrealloc( d->cibles, d->capacite_transitions * sizeof(int) );
+	}
+	memcpy( d->lettres + d->nb_transitions, lettres, nb );
+	memcpy( d->cibles + d->nb_transitions, cibles, nb * sizeof(int) );
+	d->nb_transitions += nb;
+	d->debut[ e + 1 ] = d->nb_transitions;
+	d->finaux[e] = final;
+	d->registre[i] = e;
+
+	if( 2 * (size_t) d->nb_etats > d->masque_registre ){
+		agrandir_registre( d );
+	}
+	return e;
+}
+
+static void empiler_transition( Dictionnaire * d, char lettre, int cible ){
+	if( d->sommet == d->capacite_pile ){
+		d->capacite_pile *= 2;
+		d->lettres_pile = xrealloc( d->lettres_pile, d->capacite_pile );
+		d->cibles_pile = xrealloc( d->cibles_pile, d->capacite_pile * sizeof(int) );
+	}
+	d->lettres_pile[ d->sommet ] = lettre;
+	d->cibles_pile[ d->sommet ] = cible;
+	d->sommet++;
+}
+
+static void agrandir_chemin( Dictionnaire * d, int profondeur ){
+	if( profondeur > d->profondeur_max ){
+		d->profondeur_max = 2 * profondeur;
+		d->base = xrealloc( d->base, ( d->profondeur_max + 1 ) * sizeof(int) );
+		d->finaux_chemin = xrealloc( d->finaux_chemin, d->profondeur_max + 1 );
+	}
+}
+
+/* Rend définitifs les états du chemin de profondeur strictement supérieure à
+ * 'profondeur'. Le chemin suit les lettres de 'mot', de longueur 'longueur'.
+ */
+static void figer_chemin(
+	Dictionnaire * d, const char * mot, int longueur, int profondeur
+){
+	int p;
+	for( p = longueur; p > profondeur; p-- ){
+		int base = d->base[p];
+		int e = enregistrer_etat(
+			d, d->finaux_chemin[p], d->lettres_pile + base,
+			d->cibles_pile + base, d->sommet - base
+		);
+		d->sommet = base;
+		empiler_transition( d, mot[ p - 1 ], e );
+	}
+}
+
+Automate * creer_automate_dictionnaire( const char ** mots, size_t nb_mots ){
+	Automate * res;
+	Dictionnaire d;
+	const char * precedent = "";
+	int longueur_precedente = 0;
+	size_t m;
+	int e, t, initial;
+
+	d.nb_etats = 0;
+	d.capacite_etats = 64;
+	d.debut = xmalloc( ( d.capacite_etats + 1 ) * sizeof(int) );
+	d.debut[0] = 0;
+	d.finaux = xmalloc( d.capacite_etats );
+	d.nb_transitions = 0;
+	d.capacite_transitions = 64;
+	d.lettres = xmalloc( d.capacite_transitions );
+	d.cibles = xmalloc( d.capacite_transitions * sizeof(int) );
+	d.masque_registre = 127;
+	d.registre = xmalloc( ( d.masque_registre + 1 ) * sizeof(int) );
+	memset( d.registre, -1, ( d.masque_registre + 1 ) * sizeof(int) );
+	d.profondeur_max = 0;
+	d.base = NULL;
+	d.finaux_chemin = NULL;
+	agrandir_chemin( &d, 32 );
+	d.sommet = 0;
+	d.capacite_pile = 64;
+	d.lettres_pile = xmalloc( d.capacite_pile );
+	d.cibles_pile = xmalloc( d.capacite_pile * sizeof(int) );
+	d.base[0] = 0;
+	d.finaux_chemin[0] = 0;
+
+	for( m = 0; m < nb_mots; m++ ){
+		const char * mot = mots[m];
+		int prefixe = 0, longueur, p;
+		int comparaison = strcmp( precedent, mot );
+
+		if( comparaison > 0 ){
+			ERREUR( "Les mots du dictionnaire doivent etre tries" );
+		}
+		if( comparaison == 0 && m > 0 ) continue;
+
+		while( precedent[prefixe] && precedent[prefixe] == mot[prefixe] ){
+			prefixe++;
+		}
+		figer_chemin( &d, precedent, longueur_precedente, prefixe );
+
+		longueur = prefixe + strlen( mot + prefixe );
+		agrandir_chemin( &d, longueur );
+		for( p = prefixe + 1; p <= longueur; p++ ){
+			d.base[p] = d.sommet;
+			d.finaux_chemin[p] = 0;
+		}
+		d.finaux_chemin[longueur] = 1;
+		precedent = mot;
+		longueur_precedente = longueur;
+	}
+	figer_chemin( &d, precedent, longueur_precedente, 0 );
+	initial = enregistrer_etat(
+		&d, d.finaux_chemin[0], d.lettres_pile, d.cibles_pile, d.sommet
+	);
+
+	res = creer_automate();
+	for( e = 0; e < d.nb_etats; e++ ){
+		ajouter_etat( res, e );
+		if( d.finaux[e] ) ajouter_etat_final( res, e );
+		for( t = d.debut[e]; t < d.debut[e+1]; t++ ){
+			ajouter_transition( res, e, d.lettres[t], d.cibles[t] );
+		}
+	}
+	ajouter_etat_initial( res, initial );
+
+	xfree( d.debut );
+	xfree( d.finaux );
+	xfree( d.lettres );
+	xfree( d.cibles );
+	xfree( d.registre );
+	xfree( d.base );
+	xfree( d.finaux_chemin );
+	xfree( d.lettres_pile );
+	xfree( d.cibles_pile );
+	return res;
+}
@@ -0,0 +1,54 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __DICTIONNAIRE_H__
+#define __DICTIONNAIRE_H__
+
+#include <stddef.h>
+
+#include "automate.h"
+
+/**
+ * \brief Renvoie l'automate minimal (déterministe et acyclique) qui reconnaît
+ *        exactement les mots d'une liste triée.
+ *
+ * Les mots doivent être rangés dans l'ordre croissant de strcmp() ; les
+ * doublons sont ignorés, et le programme s'arrête avec une erreur si l'ordre
+ * n'est pas respecté.
+ *
+ * L'automate est construit incrémentalement par l'algorithme de Daciuk :
+ * seul le chemin du dernier mot ajouté est modifiable, et chaque état qui
+ * quitte ce chemin est remplacé par un état équivalent déjà construit s'il en
+ * existe un (les états construits sont rangés dans une table de hachage
+ * indexée par leur langage à droite). La mémoire utilisée est donc
+ * proportionnelle à la taille de l'automate minimal, et non à la longueur
+ * totale des mots.
+ *
+ * Les états de l'automate sont numérotés à partir de 0 ; l'état initial
+ * porte le plus grand numéro.
+ *
+ * \param mots Les mots, triés
+ * \param nb_mots Le nombre de mots
+ * \return L'automate minimal
+ */
+Automate * creer_automate_dictionnaire( const char ** mots, size_t nb_mots );
+
+#endif
@@ -0,0 +1,255 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "echantillonnage.h"
+#include "comptage.h"
+#include "index_automate.h"
+#include "hachage.h"
+#include "outils.h"
+
+#include <pthread.h>
+
+struct _Echantillonneur {
+	Index_automate * index;
+	Table_comptes * table;
+	int initial;
+};
+
+static inline uint64_t rotation( uint64_t x, int k ){
+	return ( x << k ) | ( x >> ( 64 - k ) );
+}
+
+void initialiser_generateur_aleatoire(
+	Generateur_aleatoire * generateur, uint64_t graine
+){
+	int i;
+	for( i = 0; i < 4; i++ ){
+		graine += 0x9e3779b97f4a7c15ULL;
+		generateur->etat[i] = hacher_64( graine );
+	}
+}
+
+uint64_t tirer_aleatoire( Generateur_aleatoire * generateur ){
+	uint64_t * s = generateur->etat;
+	uint64_t res = rotation( s[1] * 5, 7 ) * 9;
+	uint64_t t = s[1] << 17;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotation( s[3], 45 );
+	return res;
+}
+
+/*
+ * Renvoie un entier uniforme dans [0, borne[. On rejette les tirages
+ * inférieurs à 2^k mod borne (k = 64 ou 128), pour que chaque reste soit
+ * obtenu le même nombre de fois.
+ */
+static Compte tirer_compte( Generateur_aleatoire * generateur, Compte borne ){
+	if( borne <= UINT64_MAX ){
+		uint64_t b = (uint64_t) borne;
+		uint64_t seuil = ( - b ) % b;
+		uint64_t x;
+		do{
+			x = tirer_aleatoire( generateur );
+		}while( x < seuil );
+		return x % b;
+	}else{
+		Compte seuil = ( - borne ) % borne;
+		Compte x;
+		do{
+			x = ( (Compte) tirer_aleatoire( generateur ) << 64 )
+				| tirer_aleatoire( generateur );
+		}while( x < seuil );
+		return x % borne;
+	}
+}
+
+Echantillonneur * creer_echantillonneur(
+	const Automate * automate, int longueur
+){
+	Echantillonneur * res = xmalloc( sizeof(Echantillonneur) );
+	int q;
+
+	res->index = creer_index_automate( automate );
+	if( ! index_est_deterministe( res->index ) ){
+		ERREUR( "L'echantillonnage demande un automate deterministe" );
+	}
+	res->table = creer_table_comptes( res->index, longueur );
+	res->initial = -1;
+	for( q = 0; q < res->index->nb_etats; q++ ){
+		if( TESTER_BIT( res->index->initiaux, q ) ) res->initial = q;
+	}
+	return res;
+}
+
+void liberer_echantillonneur( Echantillonneur * echantillonneur ){
+	if( echantillonneur ){
+		liberer_index_automate( echantillonneur->index );
+		liberer_table_comptes( echantillonneur->table );
+		xfree( echantillonneur );
+	}
+}
+
+int echantillonneur_est_vide( const Echantillonneur * echantillonneur ){
+	const Table_comptes * table = echantillonneur->table;
+	size_t case_initiale =
+		(size_t) table->longueur * table->nb_etats + echantillonneur->initial;
+	if( echantillonneur->initial < 0 ) return 1;
+	if( table->exacte ) return table->comptes[ case_initiale ] == 0;
+	return table->poids[ case_initiale ] == 0;
+}
+
+/*
+ * Écrit un mot de longueur table->longueur dans 'mot', sans '\0'. La
+ * longueur restante r diminue à chaque lettre ; depuis l'état q, la
+ * transition vers r' est choisie avec une probabilité proportionnelle au
+ * nombre de mots de longueur r-1 menant de r' à un état final.
+ */
+static void ecrire_mot(
+	const Echantillonneur * echantillonneur, Generateur_aleatoire * generateur,
+	char * mot
+){
+	const Index_automate * index = echantillonneur->index;
+	const Table_comptes * table = echantillonneur->table;
+	int n = table->nb_etats;
+	int q = echantillonneur->initial;
+	int r, t;
+
+	for( r = table->longueur; r > 0; r-- ){
+		int fin = index->debut[q+1];
+		int choix = -1;
+		if( table->exacte ){
+			const Compte * suivants = table->comptes + (size_t) ( r - 1 ) * n;
+			Compte x = tirer_compte(
+				generateur, table->comptes[ (size_t) r * n + q ]
+			);
+			for( t = index->debut[q]; t < fin; t++ ){
+				Compte c = suivants[ index->fins[t] ];
+				if( x < c ){
+					choix = t;
+					break;
+				}
+				x -= c;
+			}
+		}else{
+			const long double * suivants = table->poids + (size_t) ( r - 1 ) * n;
+			long double total = 0, x;
+			for( t = index->debut[q]; t < fin; t++ ){
+				total += suivants[ index->fins[t] ];
+			}
+			x = total * ( tirer_aleatoire( generateur ) >> 11 ) * 0x1.0p-53L;
+			for( t = index->debut[q]; t < fin; t++ ){
+				long double c = suivants[ index->fins[t] ];
+				if( c == 0 ) continue;
+				// Les erreurs d'arrondi peuvent faire dépasser la dernière
+				// transition possible : on la garde alors.
+				choix = t;
+				if( x < c ) break;
+				x -= c;
+			}
+		}
+		*mot++ = index->lettres[choix];
+		q = index->fins[choix];
+	}
+}
+
+int tirer_mot(
+	const Echantillonneur * echantillonneur, Generateur_aleatoire * generateur,
+	char * mot
+){
+	if( echantillonneur_est_vide( echantillonneur ) ) return 0;
+	ecrire_mot( echantillonneur, generateur, mot );
+	mot[ echantillonneur->table->longueur ] = '\0';
+	return 1;
+}
+
+size_t tirer_mots(
+	const Echantillonneur * echantillonneur, Generateur_aleatoire * generateur,
+	size_t nb_mots, char * tampon
+){
+	int longueur = echantillonneur->table->longueur;
+	size_t i;
+	if( echantillonneur_est_vide( echantillonneur ) ) return 0;
+	for( i = 0; i < nb_mots; i++ ){
+		ecrire_mot( echantillonneur, generateur, tampon );
+		tampon[ longueur ] = '\n';
+		tampon += longueur + 1;
+	}
+	return nb_mots * ( longueur + 1 );
+}
+
+typedef struct {
+	const Echantillonneur * echantillonneur;
+	Generateur_aleatoire generateur;
+	size_t nb_mots;
+	char * tampon;
+} Tranche_tirage;
+
+static void * tirer_tranche( void * data ){
+	Tranche_tirage * tranche = (Tranche_tirage *) data;
+	tirer_mots(
+		tranche->echantillonneur, &tranche->generateur, tranche->nb_mots,
+		tranche->tampon
+	);
+	return NULL;
+}
+
+size_t tirer_mots_en_parallele(
+	const Echantillonneur * echantillonneur, uint64_t graine, int nb_fils,
+	size_t nb_mots, char * tampon
+){
+	size_t taille_mot = echantillonneur->table->longueur + 1;
+	Tranche_tirage * tranches;
+	pthread_t * fils;
+	size_t debut = 0;
+	int i;
+
+	if( echantillonneur_est_vide( echantillonneur ) ) return 0;
+	if( nb_fils < 1 ) nb_fils = 1;
+	tranches = xmalloc( nb_fils * sizeof(Tranche_tirage) );
+	fils = xmalloc( nb_fils * sizeof(pthread_t) );
+	for( i = 0; i < nb_fils; i++ ){
+		size_t fin = nb_mots * ( i + 1 ) / nb_fils;
+		tranches[i].echantillonneur = echantillonneur;
+		initialiser_generateur_aleatoire(
+			&tranches[i].generateur, hacher_64( graine ) + i
+		);
+		tranches[i].nb_mots = fin - debut;
+		tranches[i].tampon = tampon + debut * taille_mot;
+		debut = fin;
+	}
+	// Le fil appelant traite la première tranche.
+	for( i = 1; i < nb_fils; i++ ){
+		if( pthread_create( &fils[i], NULL, tirer_tranche, &tranches[i] ) ){
+			ERREUR( "Impossible de creer un fil d'execution" );
+		}
+	}
+	tirer_tranche( &tranches[0] );
+	for( i = 1; i < nb_fils; i++ ){
+		pthread_join( fils[i], NULL );
+	}
+	xfree( tranches );
+	xfree( fils );
+	return nb_mots * taille_mot;
+}
@@ -0,0 +1,134 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __ECHANTILLONNAGE_H__
+#define __ECHANTILLONNAGE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "automate.h"
+
+/**
+ * \brief Un générateur pseudo-aléatoire (xoshiro256**).
+ *
+ * Un générateur ne doit pas être partagé entre plusieurs fils d'exécution :
+ * chaque fil utilise le sien.
+ */
+typedef struct {
+	uint64_t etat[4];
+} Generateur_aleatoire;
+
+/**
+ * \brief Initialise un générateur à partir d'une graine.
+ */
+void initialiser_generateur_aleatoire(
+	Generateur_aleatoire * generateur, uint64_t graine
+);
+
+/**
+ * \brief Renvoie 64 bits pseudo-aléatoires.
+ */
+uint64_t tirer_aleatoire( Generateur_aleatoire * generateur );
+
+/**
+ * \brief Un échantillonneur de mots d'une longueur donnée, reconnus par un
+ *        automate déterministe.
+ */
+typedef struct _Echantillonneur Echantillonneur;
+
+/**
+ * \brief Prépare le tirage uniforme de mots de longueur 'longueur' reconnus
+ *        par un automate déterministe.
+ *
+ * Les nombres de chemins de chaque longueur menant de chaque état à un état
+ * final sont calculés une fois pour toutes (voir creer_table_comptes()).
+ * Ensuite, chaque mot est tiré lettre par lettre, en choisissant chaque
+ * transition avec une probabilité proportionnelle au nombre de mots qu'elle
+ * permet de compléter : le tirage d'un mot coûte O(longueur) et tous les mots
+ * reconnus de cette longueur ont la même probabilité.
+ *
+ * Si les nombres de chemins dépassent 128 bits, les proportions sont
+ * calculées en flottants et le tirage n'est uniforme qu'à la précision de
+ * ces flottants près.
+ *
+ * Le programme s'arrête avec une erreur si l'automate n'est pas
+ * déterministe. L'échantillonneur ne dépend plus de l'automate une fois
+ * créé, et peut être utilisé par plusieurs fils d'exécution à la fois.
+ *
+ * \param automate Un automate déterministe
+ * \param longueur La longueur des mots à tirer
+ * \return L'échantillonneur, à libérer avec liberer_echantillonneur()
+ */
+Echantillonneur * creer_echantillonneur(
+	const Automate * automate, int longueur
+);
+
+void liberer_echantillonneur( Echantillonneur * echantillonneur );
+
+/**
+ * \brief Renvoie 1 si l'automate ne reconnaît aucun mot de la longueur de
+ *        l'échantillonneur, et 0 sinon.
+ */
+int echantillonneur_est_vide( const Echantillonneur * echantillonneur );
+
+/**
+ * \brief Tire un mot uniformément et l'écrit dans 'mot', suivi de '\0'.
+ *
+ * 'mot' doit pouvoir contenir longueur + 1 caractères.
+ *
+ * \return 1 si un mot a été tiré, 0 si aucun mot n'a cette longueur
+ */
+int tirer_mot(
+	const Echantillonneur * echantillonneur, Generateur_aleatoire * generateur,
+	char * mot
+);
+
+/**
+ * \brief Tire 'nb_mots' mots et les écrit les uns à la suite des autres dans
+ *        'tampon', chacun suivi d'un '\n'.
+ *
+ * 'tampon' doit pouvoir contenir nb_mots * ( longueur + 1 ) caractères ; il
+ * peut être écrit tel quel dans un fichier. Aucune allocation n'est faite.
+ *
+ * \return Le nombre de caractères écrits (0 si aucun mot n'a cette longueur)
+ */
+size_t tirer_mots(
+	const Echantillonneur * echantillonneur, Generateur_aleatoire * generateur,
+	size_t nb_mots, char * tampon
+);
+
+/**
+ * \brief Comme tirer_mots(), mais répartit le tirage sur 'nb_fils' fils
+ *        d'exécution.
+ *
+ * Chaque fil a son propre générateur, initialisé à partir de 'graine' et de
+ * son numéro, et remplit sa propre tranche du tampon. Pour une même graine
+ * et un même nombre de fils, le résultat est toujours le même.
+ *
+ * \return Le nombre de caractères écrits
+ */
+size_t tirer_mots_en_parallele(
+	const Echantillonneur * echantillonneur, uint64_t graine, int nb_fils,
+	size_t nb_mots, char * tampon
+);
+
+#endif
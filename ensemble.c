@@ -37,7 +37,9 @@ struct _Ensemble {
 };
 
 int* allouer_element( int val ){
-	int* result = (int*) xmalloc( sizeof(int) );
+	int* result = (int*) xmalloc_etiquete(
+		sizeof(int), ALLOCATION_ENSEMBLE
+	);
 	(*result) = val;
 	return result;
 }
@@ -83,7 +85,9 @@ Ensemble * creer_ensemble(
 	intptr_t (*copier_element)( const intptr_t elem ),
 	void (*supprimer_element)(intptr_t elem )
 ){
-	Ensemble * result = (Ensemble*) xmalloc( sizeof(Ensemble) );
+	Ensemble * result = (Ensemble*) xmalloc_etiquete(
+		sizeof(Ensemble), ALLOCATION_ENSEMBLE
+	);
 	result->table = creer_table(
 		comparer_element, copier_element, supprimer_element
 	);
@@ -105,6 +109,12 @@ void ajouter_element( Ensemble * ensemble, const intptr_t element ){
 }
 
 
+void ajouter_elements_tries(
+	Ensemble * ensemble, const intptr_t * elements, size_t nb
+){
+	add_table_triee( ensemble->table, elements, NULL, nb );
+}
+
 void action_ajouter_element( const intptr_t element, void* ens ){
 	ajouter_element( (Ensemble*) ens, element );
 }
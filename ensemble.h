@@ -78,6 +78,17 @@ void ajouter_element( Ensemble * ensemble, const intptr_t  element );
  */
 void ajouter_elements( Ensemble * ens1, const Ensemble * ens2 );
 
+/*
+ * Ajoute 'nb' éléments d'un coup à l'ensemble.
+ *
+ * Si l'ensemble est vide et que les éléments sont donnés par ordre
+ * strictement croissant, l'ensemble est construit en temps linéaire (voir
+ * add_table_triee()). Sinon, les éléments sont ajoutés un par un.
+ */
+void ajouter_elements_tries(
+	Ensemble * ensemble, const intptr_t * elements, size_t nb
+);
+
 /*
  * Retire un élément de l'ensemble
  *
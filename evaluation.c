@@ -20,101 +20,218 @@
 
 
 #include "automate.h"
+#include "langage.h"
+#include "comptage.h"
+#include "echantillonnage.h"
+#include "dictionnaire.h"
+#include "aho_corasick.h"
+#include "suffixe.h"
+#include "determinisation.h"
+#include "regex.h"
+#include "utf8.h"
+#include "sauvegarde.h"
+#include "format_texte.h"
+#include "generateur.h"
 #include "outils.h"
-#include "fifo.h"
+#include "parcours.h"
 
+#include <pthread.h>
 #include <signal.h>
-#include <errno.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
 
 #define BEGIN_TEST printf("\n================================================================================\nTest de %s() ...\n================================================================================\n", __FUNCTION__);
 
-Fifo* fifo = NULL;
-int nb_total_test = 0;
-int nb_test = 0;
+/*
+ * Les tests sont exécutés chacun dans un processus fils : une erreur de
+ * segmentation ou une boucle infinie n'atteint que le test en cause. Au
+ * plus 'nb_fils' tests s'exécutent à la fois. Chaque fils est limité en
+ * mémoire (RLIMIT_AS, sauf avec -m 0, par exemple sous AddressSanitizer
+ * qui réserve d'énormes plages d'adresses) et en temps (RLIMIT_CPU, et un
+ * délai réel au-delà duquel il est tué). Sa sortie est écrite dans un
+ * fichier temporaire, et recopiée d'un bloc quand le test se termine, dans
+ * l'ordre des tests.
+ */
+
+#define NB_TESTS_MAX 128
+
+typedef enum {
+	TEST_EN_ATTENTE,
+	TEST_EN_COURS,
+	TEST_TERMINE
+} Etat_test;
 
 typedef struct {
 	int (*test)();
+	const char * nom;
+	Etat_test etat;
+	pid_t fils;
+	FILE * sortie;
+	double debut;
+	double duree;
+	long rss_max_ko;
+	int statut;
+	int delai_depasse;
 } Test;
 
-Test* creer_test( int (*test)() ){
-	Test* res = xmalloc( sizeof(Test) );
-	res->test = test;
-	return res;
+static Test tests[ NB_TESTS_MAX ];
+static int nb_tests = 0;
+
+typedef struct {
+	int nb_fils;
+	double delai;
+	long memoire_mo;
+	const char * filtre;
+} Options_tests;
+
+static double maintenant(){
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	return t.tv_sec + 1e-9 * t.tv_nsec;
 }
 
-void liberer_test( Test* test ){
-	xfree( test );
+#define ajouter_test( test ) enregistrer_test( (test), #test )
+
+void enregistrer_test( int (*test)(), const char * nom ){
+	if( nb_tests == NB_TESTS_MAX ) ERREUR( "Trop de tests" );
+	tests[ nb_tests ].test = test;
+	tests[ nb_tests ].nom = nom;
+	tests[ nb_tests ].etat = TEST_EN_ATTENTE;
+	nb_tests++;
 }
 
-void start_or_continue_test(){
-	while( ! est_vide(fifo) ){
-		Test* data = (Test*) retirer_fifo( fifo );
-		int (*test)();
-		test = data->test;
-		liberer_test( data );
-		nb_total_test += 1;
-		int res = test();
-		printf("================================================================================\n");
-		if(res){
-			printf("... \033[32mvalidé.\033[0m\n");
-		}else{
-			printf("... \033[31mECHEC !\033[0m\n");
+static void demarrer_test( Test * t, const Options_tests * options ){
+	t->sortie = tmpfile();
+	if( ! t->sortie ) ERREUR( "tmpfile() a echoue" );
+	fflush( stdout );
+	t->debut = maintenant();
+	t->fils = fork();
+	if( t->fils < 0 ) ERREUR( "fork() a echoue" );
+	if( t->fils == 0 ){
+		struct rlimit limite;
+		dup2( fileno( t->sortie ), STDOUT_FILENO );
+		dup2( fileno( t->sortie ), STDERR_FILENO );
+		setvbuf( stdout, NULL, _IOLBF, 0 );
+		if( options->memoire_mo > 0 ){
+			limite.rlim_cur = limite.rlim_max = (rlim_t) options->memoire_mo << 20;
+			setrlimit( RLIMIT_AS, &limite );
 		}
-		printf("================================================================================\n\n");
-		nb_test += res;
+		limite.rlim_cur = limite.rlim_max = (rlim_t) options->delai + 1;
+		setrlimit( RLIMIT_CPU, &limite );
+		exit( t->test() ? EXIT_SUCCESS : EXIT_FAILURE );
 	}
-	liberer_fifo( fifo );
-	printf( "\n" );
-	printf( "\n Nb de tests effectués : %d", nb_total_test);
-	printf( "\n Nb de tests validés : \033[32m%d\033[0m", nb_test);
-	printf( "\n Nb de tests ratés : \033[31m%d\033[0m", nb_total_test - nb_test);
-	printf( "\n" );
-	exit( nb_test );
+	t->etat = TEST_EN_COURS;
 }
 
-void set_all_sigactions();
+static Test * trouver_test_du_fils( pid_t fils ){
+	int i;
+	for( i = 0; i < nb_tests; i++ ){
+		if( tests[i].etat == TEST_EN_COURS && tests[i].fils == fils ){
+			return tests + i;
+		}
+	}
+	return NULL;
+}
 
-void execute_on_sigfault( int signal ){
+/* Recopie la sortie d'un test terminé, suivie de son verdict. Renvoie 1 si
+ * le test est validé.
+ */
+static int afficher_test( Test * t ){
+	char tampon[4096];
+	size_t lus;
+	int valide = ! t->delai_depasse
+		&& WIFEXITED( t->statut ) && WEXITSTATUS( t->statut ) == EXIT_SUCCESS;
+
+	rewind( t->sortie );
+	while( ( lus = fread( tampon, 1, sizeof(tampon), t->sortie ) ) > 0 ){
+		fwrite( tampon, 1, lus, stdout );
+	}
+	fclose( t->sortie );
 	printf("================================================================================\n");
-	printf("... \033[31mECHEC ! Le test a fait une erreur de segmentation.\033[0m\n");
+	if( valide ){
+		printf("... \033[32mvalidé.\033[0m");
+	}else if( t->delai_depasse ){
+		printf("... \033[31mECHEC ! Le test a dépassé le délai.\033[0m");
+	}else if( WIFSIGNALED( t->statut ) ){
+		printf(
+			"... \033[31mECHEC ! Le test a reçu le signal %d (%s).\033[0m",
+			WTERMSIG( t->statut ), strsignal( WTERMSIG( t->statut ) )
+		);
+	}else{
+		printf("... \033[31mECHEC !\033[0m");
+	}
+	printf( " (%s : %.2f s, %ld Ko)\n", t->nom, t->duree, t->rss_max_ko );
 	printf("================================================================================\n\n");
-
-	set_all_sigactions();
-
-	start_or_continue_test();
+	return valide;
 }
 
-void ajouter_test( int (*test)() ){
-	ajouter_fifo( fifo, (intptr_t) creer_test( test ) );
-}
-
-
-void set_sigaction( int signum, void (*execute_on_signal)( int signal ) ){
-
-	struct sigaction action;
-
-	int res = sigaction( signum, NULL, &action );
+/* Exécute les tests enregistrés dont le nom contient le filtre, et renvoie
+ * le nombre de tests ratés.
+ */
+static int executer_tests( const Options_tests * options ){
+	int nb_en_cours = 0, prochain = 0, a_afficher = 0;
+	int nb_effectues = 0, nb_valides = 0;
+
+	while( prochain < nb_tests || nb_en_cours > 0 ){
+		struct rusage utilisation;
+		int statut, i;
+		pid_t fils;
+
+		while( prochain < nb_tests && nb_en_cours < options->nb_fils ){
+			if( strstr( tests[ prochain ].nom, options->filtre ) ){
+				demarrer_test( tests + prochain, options );
+				nb_en_cours++;
+			}else{
+				tests[ prochain ].etat = TEST_TERMINE;
+				tests[ prochain ].sortie = NULL;
+			}
+			prochain++;
+		}
 
-	if( res != 0 ){
-		fprintf(stderr, "Erreur pour installer le signal : %d \n" , errno );
-	}    
+		fils = wait4( -1, &statut, WNOHANG, &utilisation );
+		if( fils > 0 ){
+			Test * t = trouver_test_du_fils( fils );
+			if( t ){
+				t->duree = maintenant() - t->debut;
+				t->statut = statut;
+				t->rss_max_ko = utilisation.ru_maxrss;
+				t->etat = TEST_TERMINE;
+				nb_en_cours--;
+			}
+		}else{
+			struct timespec attente = { 0, 1000000 };
+			double instant = maintenant();
+			for( i = 0; i < nb_tests; i++ ){
+				Test * t = tests + i;
+				if( t->etat == TEST_EN_COURS && ! t->delai_depasse
+					&& instant - t->debut > options->delai
+				){
+					t->delai_depasse = 1;
+					kill( t->fils, SIGKILL );
+				}
+			}
+			nanosleep( &attente, NULL );
+		}
 
-	if( action.sa_handler != SIG_IGN ){
-		action.sa_handler = execute_on_signal;
-		action.sa_flags =  SA_RESTART | SA_NODEFER;
-		sigemptyset (&action.sa_mask);
-		sigaction(signum, &action, NULL);
+		while( a_afficher < nb_tests && tests[ a_afficher ].etat == TEST_TERMINE ){
+			if( tests[ a_afficher ].sortie ){
+				nb_effectues++;
+				nb_valides += afficher_test( tests + a_afficher );
+			}
+			a_afficher++;
+		}
+		fflush( stdout );
 	}
-}
-
-void set_all_sigactions(){
-
-	set_sigaction( SIGILL, execute_on_sigfault );
-	set_sigaction( SIGFPE, execute_on_sigfault );
-	set_sigaction( SIGSEGV, execute_on_sigfault );
-	set_sigaction( SIGBUS, execute_on_sigfault );
-	set_sigaction( SIGTRAP, execute_on_sigfault );
 
+	printf( "\n" );
+	printf( "\n Nb de tests effectués : %d", nb_effectues);
+	printf( "\n Nb de tests validés : \033[32m%d\033[0m", nb_valides);
+	printf( "\n Nb de tests ratés : \033[31m%d\033[0m", nb_effectues - nb_valides);
+	printf( "\n" );
+	return nb_effectues - nb_valides;
 }
 
 int test_creer_automate(){
@@ -522,20 +639,1482 @@ int test_automate_vide(){
 
 }
 
-int main(){
-	nb_test = 0;
-	nb_total_test = 0;
-	fifo = creer_fifo();
+int test_melange(){
+	BEGIN_TEST;
+
+	int result = 1;
+
+	Automate * automate1 = mot_to_automate( "ab" );
+	Automate * automate2 = mot_to_automate( "c" );
+	Automate * melange = creer_automate_du_melange( automate1, automate2 );
+
+	TEST(
+		1
+		&& melange
+		&& taille_ensemble( get_etats( melange ) ) == 6
+		&& le_mot_est_reconnu( melange, "abc" )
+		&& le_mot_est_reconnu( melange, "acb" )
+		&& le_mot_est_reconnu( melange, "cab" )
+		&& ! le_mot_est_reconnu( melange, "ab" )
+		&& ! le_mot_est_reconnu( melange, "bac" )
+		&& ! le_mot_est_reconnu( melange, "abcc" )
+		, result
+	);
+
+	TEST(
+		1
+		&& le_mot_est_reconnu_par_le_melange( automate1, automate2, "abc" )
+		&& le_mot_est_reconnu_par_le_melange( automate1, automate2, "acb" )
+		&& le_mot_est_reconnu_par_le_melange( automate1, automate2, "cab" )
+		&& ! le_mot_est_reconnu_par_le_melange( automate1, automate2, "c" )
+		&& ! le_mot_est_reconnu_par_le_melange( automate1, automate2, "bca" )
+		&& ! le_mot_est_reconnu_par_le_melange( automate1, automate2, "abcc" )
+		, result
+	);
+
+	TEST( ! creer_automate_du_melange_borne( automate1, automate2, 5 ), result );
+
+	liberer_automate( melange );
+	liberer_automate( automate1 );
+	liberer_automate( automate2 );
+
+	return result;
+}
+
+int test_produit(){
+	BEGIN_TEST;
+
+	int result = 1;
+
+	// a*b et ab*
+	Automate * automate1 = creer_automate();
+	ajouter_transition( automate1, 0, 'a', 0 );
+	ajouter_transition( automate1, 0, 'b', 1 );
+	ajouter_etat_initial( automate1, 0 );
+	ajouter_etat_final( automate1, 1 );
+
+	Automate * automate2 = creer_automate();
+	ajouter_transition( automate2, 0, 'a', 1 );
+	ajouter_transition( automate2, 1, 'b', 1 );
+	ajouter_etat_initial( automate2, 0 );
+	ajouter_etat_final( automate2, 1 );
+
+	Automate * inter = creer_automate_produit(
+		automate1, automate2, PRODUIT_INTERSECTION
+	);
+	Automate * uni = creer_automate_produit(
+		automate1, automate2, PRODUIT_UNION
+	);
+	Automate * diff = creer_automate_produit(
+		automate1, automate2, PRODUIT_DIFFERENCE
+	);
+	Automate * sym = creer_automate_produit(
+		automate1, automate2, PRODUIT_DIFFERENCE_SYMETRIQUE
+	);
+
+	TEST(
+		1
+		&& le_mot_est_reconnu( inter, "ab" )
+		&& ! le_mot_est_reconnu( inter, "aab" )
+		&& ! le_mot_est_reconnu( inter, "abb" )
+		&& ! le_mot_est_reconnu( inter, "a" )
+		, result
+	);
+	TEST(
+		1
+		&& le_mot_est_reconnu( uni, "ab" )
+		&& le_mot_est_reconnu( uni, "aab" )
+		&& le_mot_est_reconnu( uni, "abb" )
+		&& le_mot_est_reconnu( uni, "a" )
+		&& le_mot_est_reconnu( uni, "b" )
+		&& ! le_mot_est_reconnu( uni, "ba" )
+		&& ! le_mot_est_reconnu( uni, "" )
+		, result
+	);
+	TEST(
+		1
+		&& ! le_mot_est_reconnu( diff, "ab" )
+		&& le_mot_est_reconnu( diff, "aab" )
+		&& le_mot_est_reconnu( diff, "b" )
+		&& ! le_mot_est_reconnu( diff, "abb" )
+		, result
+	);
+	TEST(
+		1
+		&& ! le_mot_est_reconnu( sym, "ab" )
+		&& le_mot_est_reconnu( sym, "aab" )
+		&& le_mot_est_reconnu( sym, "abb" )
+		&& le_mot_est_reconnu( sym, "a" )
+		&& ! le_mot_est_reconnu( sym, "ba" )
+		, result
+	);
+	TEST(
+		1
+		&& le_mot_est_reconnu_par_le_produit(
+			automate1, automate2, "ab", PRODUIT_INTERSECTION )
+		&& ! le_mot_est_reconnu_par_le_produit(
+			automate1, automate2, "aab", PRODUIT_INTERSECTION )
+		&& le_mot_est_reconnu_par_le_produit(
+			automate1, automate2, "abb", PRODUIT_UNION )
+		&& ! le_mot_est_reconnu_par_le_produit(
+			automate1, automate2, "ba", PRODUIT_UNION )
+		&& le_mot_est_reconnu_par_le_produit(
+			automate1, automate2, "b", PRODUIT_DIFFERENCE )
+		&& ! le_mot_est_reconnu_par_le_produit(
+			automate1, automate2, "ab", PRODUIT_DIFFERENCE_SYMETRIQUE )
+		, result
+	);
+	TEST(
+		1
+		&& ! le_produit_est_vide( automate1, automate2, PRODUIT_INTERSECTION )
+		&& ! le_produit_est_vide( automate1, automate2, PRODUIT_DIFFERENCE )
+		&& le_produit_est_vide( inter, automate2, PRODUIT_DIFFERENCE )
+		&& le_produit_est_vide( automate1, automate1, PRODUIT_DIFFERENCE_SYMETRIQUE )
+		, result
+	);
+
+	liberer_automate( inter );
+	liberer_automate( uni );
+	liberer_automate( diff );
+	liberer_automate( sym );
+	liberer_automate( automate1 );
+	liberer_automate( automate2 );
+
+	return result;
+}
+
+int test_inclusion_equivalence(){
+	BEGIN_TEST;
+
+	int result = 1;
+	int inclus, equivalents;
+	char * mot = NULL;
+
+	// ab* de façon déterministe ...
+	Automate * automate1 = creer_automate();
+	ajouter_transition( automate1, 0, 'a', 1 );
+	ajouter_transition( automate1, 1, 'b', 1 );
+	ajouter_etat_initial( automate1, 0 );
+	ajouter_etat_final( automate1, 1 );
+
+	// ... et non déterministe : a(b+bb)*
+	Automate * automate2 = creer_automate();
+	ajouter_transition( automate2, 0, 'a', 1 );
+	ajouter_transition( automate2, 1, 'b', 1 );
+	ajouter_transition( automate2, 1, 'b', 2 );
+	ajouter_transition( automate2, 2, 'b', 1 );
+	ajouter_etat_initial( automate2, 0 );
+	ajouter_etat_final( automate2, 1 );
+
+	Automate * ab = mot_to_automate( "ab" );
+
+	// a*b
+	Automate * automate3 = creer_automate();
+	ajouter_transition( automate3, 0, 'a', 0 );
+	ajouter_transition( automate3, 0, 'b', 1 );
+	ajouter_etat_initial( automate3, 0 );
+	ajouter_etat_final( automate3, 1 );
+
+	TEST(
+		1
+		&& inclusion_langage( automate1, automate2, NULL )
+		&& inclusion_langage( automate2, automate1, NULL )
+		&& equivalence_langage( automate1, automate2, NULL )
+		&& inclusion_langage( ab, automate2, NULL )
+		, result
+	);
+
+	inclus = inclusion_langage( automate2, ab, &mot );
+	TEST( ! inclus, result );
+	TEST(
+		mot
+		&& strcmp( mot, "a" ) == 0
+		, result
+	);
+	if( mot ) xfree( mot );
+	mot = NULL;
+
+	equivalents = equivalence_langage( automate1, automate3, &mot );
+	TEST( ! equivalents, result );
+	TEST(
+		mot
+		&& le_mot_est_reconnu( automate1, mot )
+		!= le_mot_est_reconnu( automate3, mot )
+		, result
+	);
+	if( mot ) xfree( mot );
+	mot = NULL;
+
+	equivalents = equivalence_langage( automate2, automate3, &mot );
+	TEST( ! equivalents, result );
+	TEST(
+		mot
+		&& le_mot_est_reconnu( automate2, mot )
+		!= le_mot_est_reconnu( automate3, mot )
+		, result
+	);
+	if( mot ) xfree( mot );
+
+	liberer_automate( automate1 );
+	liberer_automate( automate2 );
+	liberer_automate( automate3 );
+	liberer_automate( ab );
+
+	return result;
+}
+
+int test_plus_court_mot(){
+	BEGIN_TEST;
+
+	int result = 1;
+	char * mot;
+
+	Automate * automate = creer_automate();
+	ajouter_transition( automate, 0, 'b', 1 );
+	ajouter_transition( automate, 1, 'b', 2 );
+	ajouter_transition( automate, 2, 'b', 3 );
+	ajouter_transition( automate, 0, 'c', 4 );
+	ajouter_transition( automate, 4, 'a', 3 );
+	ajouter_transition( automate, 5, 'a', 6 );
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, 3 );
+	ajouter_etat_final( automate, 6 );
+
+	mot = plus_court_mot_reconnu( automate );
+	TEST( mot && strcmp( mot, "ca" ) == 0, result );
+	if( mot ) xfree( mot );
+	TEST( ! langage_est_vide( automate ), result );
+
+	Automate * vide = creer_automate();
+	ajouter_transition( vide, 0, 'a', 1 );
+	ajouter_transition( vide, 2, 'a', 3 );
+	ajouter_etat_initial( vide, 0 );
+	ajouter_etat_final( vide, 3 );
+
+	TEST( langage_est_vide( vide ), result );
+	TEST( plus_court_mot_reconnu( vide ) == NULL, result );
+
+	ajouter_etat_initial( vide, 3 );
+	mot = plus_court_mot_reconnu( vide );
+	TEST( mot && strcmp( mot, "" ) == 0, result );
+	if( mot ) xfree( mot );
+
+	liberer_automate( automate );
+	liberer_automate( vide );
+
+	return result;
+}
+
+int test_comptage(){
+	BEGIN_TEST;
+
+	int result = 1;
+	char tampon[TAILLE_CHAINE_COMPTE];
+
+	Automate * tous = creer_automate();
+	ajouter_transition( tous, 0, 'a', 0 );
+	ajouter_transition( tous, 0, 'b', 0 );
+	ajouter_etat_initial( tous, 0 );
+	ajouter_etat_final( tous, 0 );
+
+	TEST( compter_mots( tous, 0 ) == 1, result );
+	TEST( compter_mots( tous, 10 ) == 1024, result );
+	TEST( compter_mots_au_plus( tous, 10 ) == 2047, result );
+	TEST(
+		strcmp(
+			compte_vers_chaine( compter_mots( tous, 100 ), tampon ),
+			"1267650600228229401496703205376"
+		) == 0, result
+	);
+	TEST( compter_mots( tous, 200 ) == COMPTE_MAX, result );
+	TEST(
+		compter_mots_modulo( tous, 1000000000000000000ULL, 1000000007 )
+		== 719476260, result
+	);
+	TEST(
+		compter_mots_au_plus_modulo( tous, 1000000000000000000ULL, 1000000007 )
+		== 438952512, result
+	);
+
+	// Les mots sans facteur "bb"
+	Automate * sans_bb = creer_automate();
+	ajouter_transition( sans_bb, 0, 'a', 0 );
+	ajouter_transition( sans_bb, 0, 'b', 1 );
+	ajouter_transition( sans_bb, 1, 'a', 0 );
+	ajouter_etat_initial( sans_bb, 0 );
+	ajouter_etat_final( sans_bb, 0 );
+	ajouter_etat_final( sans_bb, 1 );
+
+	TEST( compter_mots( sans_bb, 10 ) == 144, result );
+	TEST( compter_mots_au_plus( sans_bb, 10 ) == 375, result );
+	TEST(
+		compter_mots_modulo( sans_bb, 1000000000000000000ULL, 1000000007 )
+		== 889840849, result
+	);
+	TEST(
+		compter_mots_au_plus_modulo( sans_bb, 1000000000000000000ULL, 1000000007 )
+		== 459739078, result
+	);
+
+	Automate * fini = creer_automate();
+	ajouter_transition( fini, 0, 'a', 1 );
+	ajouter_transition( fini, 1, 'b', 2 );
+	ajouter_etat_initial( fini, 0 );
+	ajouter_etat_final( fini, 2 );
+
+	TEST( compter_mots( fini, 2 ) == 1, result );
+	TEST( compter_mots( fini, 3 ) == 0, result );
+	TEST( compter_mots_au_plus( fini, 1000000000000000000ULL ) == 1, result );
+
+	// À la longueur maximale, longueur + 1 dépasse 64 bits
+	Automate * unaire = creer_automate();
+	ajouter_transition( unaire, 0, 'a', 0 );
+	ajouter_etat_initial( unaire, 0 );
+	ajouter_etat_final( unaire, 0 );
+
+	TEST( compter_mots_au_plus( unaire, UINT64_MAX ) == (Compte) UINT64_MAX + 1, result );
+	TEST( compter_mots_au_plus_modulo( unaire, UINT64_MAX, 1000 ) == 616, result );
+	TEST( compter_mots_au_plus( tous, UINT64_MAX ) == COMPTE_MAX, result );
+	TEST( compter_mots_au_plus( sans_bb, UINT64_MAX ) == COMPTE_MAX, result );
+	TEST(
+		compter_mots_au_plus_modulo( tous, UINT64_MAX, 1000000007 )
+		== 963061528, result
+	);
+	TEST( compter_mots_au_plus( fini, UINT64_MAX ) == 1, result );
+	TEST( compter_mots( fini, UINT64_MAX ) == 0, result );
+
+	liberer_automate( tous );
+	liberer_automate( sans_bb );
+	liberer_automate( fini );
+	liberer_automate( unaire );
+
+	return result;
+}
+
+int test_echantillonnage(){
+	BEGIN_TEST;
+
+	int result = 1;
+	char mot[41];
+	int apparitions[64];
+	int i, j;
+
+	// Les mots sans facteur "bb" : il y en a 21 de longueur 6.
+	Automate * sans_bb = creer_automate();
+	ajouter_transition( sans_bb, 0, 'a', 0 );
+	ajouter_transition( sans_bb, 0, 'b', 1 );
+	ajouter_transition( sans_bb, 1, 'a', 0 );
+	ajouter_etat_initial( sans_bb, 0 );
+	ajouter_etat_final( sans_bb, 0 );
+	ajouter_etat_final( sans_bb, 1 );
+
+	Echantillonneur * e = creer_echantillonneur( sans_bb, 6 );
+	Generateur_aleatoire generateur;
+	initialiser_generateur_aleatoire( &generateur, 42 );
+	TEST( ! echantillonneur_est_vide( e ), result );
+
+	memset( apparitions, 0, sizeof(apparitions) );
+	for( i = 0; i < 4200; i++ ){
+		int code = 0;
+		TEST( tirer_mot( e, &generateur, mot ), result );
+		TEST( strlen( mot ) == 6 && le_mot_est_reconnu( sans_bb, mot ), result );
+		for( j = 0; j < 6; j++ ) code = 2 * code + ( mot[j] == 'b' );
+		apparitions[code]++;
+	}
+	// Chaque mot est tiré en moyenne 200 fois.
+	for( i = 0, j = 0; i < 64; i++ ){
+		if( apparitions[i] ){
+			j++;
+			TEST( apparitions[i] > 100 && apparitions[i] < 300, result );
+		}
+	}
+	TEST( j == 21, result );
+
+	size_t nb_mots = 1000;
+	char * tampon = xmalloc( nb_mots * 7 );
+	TEST( tirer_mots_en_parallele( e, 7, 4, nb_mots, tampon ) == nb_mots * 7, result );
+	for( i = 0; i < nb_mots; i++ ){
+		TEST( tampon[ 7 * i + 6 ] == '\n', result );
+		tampon[ 7 * i + 6 ] = '\0';
+		TEST( le_mot_est_reconnu( sans_bb, tampon + 7 * i ), result );
+	}
+	xfree( tampon );
+	liberer_echantillonneur( e );
+
+	// Les nombres de mots dépassent 128 bits : tirage approché.
+	Automate * tous = creer_automate();
+	for( i = 0; i < 26; i++ ) ajouter_transition( tous, 0, 'a' + i, 0 );
+	ajouter_transition( tous, 0, '#', 1 );
+	ajouter_etat_initial( tous, 0 );
+	ajouter_etat_final( tous, 1 );
+	e = creer_echantillonneur( tous, 40 );
+	TEST( tirer_mot( e, &generateur, mot ), result );
+	TEST( strlen( mot ) == 40 && le_mot_est_reconnu( tous, mot ), result );
+	liberer_echantillonneur( e );
+
+	e = creer_echantillonneur( tous, 0 );
+	TEST( echantillonneur_est_vide( e ), result );
+	TEST( ! tirer_mot( e, &generateur, mot ), result );
+	liberer_echantillonneur( e );
+
+	liberer_automate( sans_bb );
+	liberer_automate( tous );
+
+	return result;
+}
+
+int test_enumeration(){
+	BEGIN_TEST;
+
+	int result = 1;
+	const char * attendus[] = { "", "a", "b", "aa", "ab", "ba", "aaa", "aab" };
+	const char * mot;
+	int i;
+
+	Automate * sans_bb = creer_automate();
+	ajouter_transition( sans_bb, 0, 'a', 0 );
+	ajouter_transition( sans_bb, 0, 'b', 1 );
+	ajouter_transition( sans_bb, 1, 'a', 0 );
+	ajouter_etat_initial( sans_bb, 0 );
+	ajouter_etat_final( sans_bb, 0 );
+	ajouter_etat_final( sans_bb, 1 );
+
+	Enumerateur * e = creer_enumerateur( sans_bb );
+	for( i = 0; i < 8; i++ ){
+		mot = mot_suivant( e );
+		TEST( mot && strcmp( mot, attendus[i] ) == 0, result );
+	}
+	// Il y a 375 mots de longueur au plus 10.
+	for( i = 8; i < 375; i++ ) mot = mot_suivant( e );
+	TEST( mot && strcmp( mot, "bababababa" ) == 0, result );
+	mot = mot_suivant( e );
+	TEST( mot && strcmp( mot, "aaaaaaaaaaa" ) == 0, result );
+	liberer_enumerateur( e );
+
+	// Un langage fini, et un état inaccessible qui boucle
+	Automate * fini = creer_automate();
+	ajouter_transition( fini, 0, 'c', 1 );
+	ajouter_transition( fini, 1, 'a', 2 );
+	ajouter_transition( fini, 0, 'b', 2 );
+	ajouter_transition( fini, 0, 'a', 3 );
+	ajouter_transition( fini, 3, 'b', 2 );
+	ajouter_transition( fini, 4, 'a', 4 );
+	ajouter_etat_initial( fini, 0 );
+	ajouter_etat_final( fini, 2 );
+	ajouter_etat_final( fini, 4 );
+
+	e = creer_enumerateur( fini );
+	mot = mot_suivant( e );
+	TEST( mot && strcmp( mot, "b" ) == 0, result );
+	mot = mot_suivant( e );
+	TEST( mot && strcmp( mot, "ab" ) == 0, result );
+	mot = mot_suivant( e );
+	TEST( mot && strcmp( mot, "ca" ) == 0, result );
+	TEST( mot_suivant( e ) == NULL, result );
+	TEST( mot_suivant( e ) == NULL, result );
+	liberer_enumerateur( e );
+
+	// Des longueurs sans mot
+	Automate * trois = creer_automate();
+	ajouter_transition( trois, 0, 'a', 1 );
+	ajouter_transition( trois, 1, 'a', 2 );
+	ajouter_transition( trois, 2, 'a', 0 );
+	ajouter_etat_initial( trois, 0 );
+	ajouter_etat_final( trois, 0 );
+
+	e = creer_enumerateur( trois );
+	mot = mot_suivant( e );
+	TEST( mot && strcmp( mot, "" ) == 0, result );
+	mot = mot_suivant( e );
+	TEST( mot && strcmp( mot, "aaa" ) == 0, result );
+	for( i = 0; i < 20; i++ ) mot = mot_suivant( e );
+	TEST( mot && strlen( mot ) == 63, result );
+	liberer_enumerateur( e );
+
+	Automate * vide = creer_automate();
+	e = creer_enumerateur( vide );
+	TEST( mot_suivant( e ) == NULL, result );
+	liberer_enumerateur( e );
+
+	liberer_automate( sans_bb );
+	liberer_automate( fini );
+	liberer_automate( trois );
+	liberer_automate( vide );
+
+	return result;
+}
+
+int test_dictionnaire(){
+	BEGIN_TEST;
+
+	int result = 1;
+	const char * mots[] = { "tap", "taps", "taps", "top", "tops" };
+	char ** binaires;
+	int i, j;
+
+	Automate * dictionnaire = creer_automate_dictionnaire( mots, 5 );
+	// t(a|o)p(s)? : 5 états
+	TEST( taille_ensemble( get_etats( dictionnaire ) ) == 5, result );
+	TEST( le_mot_est_reconnu( dictionnaire, "tap" ), result );
+	TEST( le_mot_est_reconnu( dictionnaire, "tops" ), result );
+	TEST( ! le_mot_est_reconnu( dictionnaire, "ta" ), result );
+	TEST( ! le_mot_est_reconnu( dictionnaire, "" ), result );
+
+	// Les 1024 mots de longueur 10 sur {a,b} : 11 états
+	binaires = xmalloc( 1024 * sizeof(char*) );
+	for( i = 0; i < 1024; i++ ){
+		binaires[i] = xmalloc( 11 );
+		for( j = 0; j < 10; j++ ){
+			binaires[i][j] = ( i >> ( 9 - j ) ) & 1 ? 'b' : 'a';
+		}
+		binaires[i][10] = '\0';
+	}
+	Automate * tous = creer_automate_dictionnaire( (const char **) binaires, 1024 );
+	TEST( taille_ensemble( get_etats( tous ) ) == 11, result );
+	TEST( le_mot_est_reconnu( tous, "abbabaabab" ), result );
+	TEST( ! le_mot_est_reconnu( tous, "abbabaaba" ), result );
+	for( i = 0; i < 1024; i++ ) xfree( binaires[i] );
+	xfree( binaires );
+
+	const char * avec_vide[] = { "", "a", "ab" };
+	Automate * prefixes = creer_automate_dictionnaire( avec_vide, 3 );
+	TEST( taille_ensemble( get_etats( prefixes ) ) == 3, result );
+	TEST( le_mot_est_reconnu( prefixes, "" ), result );
+	TEST( le_mot_est_reconnu( prefixes, "ab" ), result );
+	TEST( ! le_mot_est_reconnu( prefixes, "b" ), result );
+
+	Automate * vide = creer_automate_dictionnaire( NULL, 0 );
+	TEST( langage_est_vide( vide ), result );
+
+	liberer_automate( dictionnaire );
+	liberer_automate( tous );
+	liberer_automate( prefixes );
+	liberer_automate( vide );
+
+	return result;
+}
+
+typedef struct {
+	int motifs[8];
+	size_t fins[8];
+	int nb;
+} Occurrences;
+
+void action_noter_occurrence( int motif, size_t fin, void * data ){
+	Occurrences * o = (Occurrences *) data;
+	if( o->nb < 8 ){
+		o->motifs[ o->nb ] = motif;
+		o->fins[ o->nb ] = fin;
+	}
+	o->nb++;
+}
+
+int test_aho_corasick(){
+	BEGIN_TEST;
+
+	int result = 1;
+	const char * motifs[] = { "he", "she", "his", "hers" };
+	Occurrences o;
+	size_t nb;
+
+	Aho_corasick * ac = creer_aho_corasick( motifs, 4 );
+	TEST( nb_etats_aho_corasick( ac ) == 10, result );
+
+	o.nb = 0;
+	nb = chercher_motifs( ac, "ushers", 6, action_noter_occurrence, &o );
+	TEST( nb == 3 && o.nb == 3, result );
+	TEST( o.motifs[0] == 1 && o.fins[0] == 4, result );
+	TEST( o.motifs[1] == 0 && o.fins[1] == 4, result );
+	TEST( o.motifs[2] == 3 && o.fins[2] == 6, result );
+	TEST( chercher_motifs( ac, "hishe", 5, NULL, NULL ) == 3, result );
+	TEST( contient_un_motif( ac, "xxhixhs", 7 ) == 0, result );
+	TEST( contient_un_motif( ac, "xxhisx", 6 ) == 1, result );
+
+	Automate * suffixes = aho_corasick_vers_automate( ac, NULL, 0 );
+	TEST( le_mot_est_reconnu( suffixes, "shers" ), result );
+	TEST( ! le_mot_est_reconnu( suffixes, "sher" ), result );
+	TEST( le_mot_est_reconnu( suffixes, "hhe" ), result );
+
+	Ensemble * alphabet = creer_ensemble( NULL, NULL, NULL );
+	ajouter_element( alphabet, 'x' );
+	Automate * facteurs = aho_corasick_vers_automate( ac, alphabet, 1 );
+	TEST( le_mot_est_reconnu( facteurs, "xhisxx" ), result );
+	TEST( ! le_mot_est_reconnu( facteurs, "xhxsx" ), result );
+	TEST( le_mot_est_reconnu( facteurs, "xsher" ), result );
+
+	liberer_ensemble( alphabet );
+	liberer_automate( suffixes );
+	liberer_automate( facteurs );
+	liberer_aho_corasick( ac );
+
+	return result;
+}
+
+int test_automate_suffixes(){
+	BEGIN_TEST;
+
+	int result = 1;
+	const char * mot = "abcbc";
+
+	Automate_suffixes * sa = creer_automate_suffixes();
+	for( ; *mot; mot++ ) ajouter_lettre_suffixe( sa, *mot );
+
+	// Au plus 2n - 1 états
+	TEST( nb_etats_suffixes( sa ) <= 9, result );
+	TEST( est_facteur( sa, "" ), result );
+	TEST( est_facteur( sa, "bcb" ), result );
+	TEST( est_facteur( sa, "abcbc" ), result );
+	TEST( ! est_facteur( sa, "cc" ), result );
+	TEST( ! est_facteur( sa, "abcbcb" ), result );
+	TEST( est_suffixe( sa, "bc" ), result );
+	TEST( est_suffixe( sa, "" ), result );
+	TEST( ! est_suffixe( sa, "bcb" ), result );
+
+	Automate * w = mot_to_automate( "abcbc" );
+	Automate * facteurs = creer_automate_des_facteurs( w );
+	Automate * suffixes = creer_automate_des_suffixes( w );
+	Automate * dawg_facteurs = automate_suffixes_vers_automate( sa, 1 );
+	Automate * dawg_suffixes = automate_suffixes_vers_automate( sa, 0 );
+	TEST( equivalence_langage( dawg_facteurs, facteurs, NULL ), result );
+	TEST( equivalence_langage( dawg_suffixes, suffixes, NULL ), result );
+
+	// L'automate reste correct quand le texte s'allonge.
+	ajouter_lettre_suffixe( sa, 'a' );
+	TEST( est_facteur( sa, "bca" ), result );
+	TEST( est_suffixe( sa, "ca" ), result );
+	TEST( ! est_suffixe( sa, "bc" ), result );
+
+	liberer_automate( w );
+	liberer_automate( facteurs );
+	liberer_automate( suffixes );
+	liberer_automate( dawg_facteurs );
+	liberer_automate( dawg_suffixes );
+	liberer_automate_suffixes( sa );
+
+	sa = creer_automate_suffixes_mot( "aaaaaaaaaa" );
+	TEST( nb_etats_suffixes( sa ) == 11, result );
+	TEST( est_suffixe( sa, "aaa" ), result );
+	liberer_automate_suffixes( sa );
+
+	return result;
+}
+
+int test_expression_rationnelle(){
+	BEGIN_TEST;
+
+	int result = 1;
+	Temps_compilation temps;
+
+	Automate * glushkov = expression_vers_automate( "(a|b)*abb" );
+	Automate * thompson = expression_vers_automate_par(
+		"(a|b)*abb", CONSTRUCTION_THOMPSON
+	);
+	TEST( glushkov && thompson, result );
+	TEST( taille_ensemble( get_etats( glushkov ) ) == 6, result );
+	TEST( le_mot_est_reconnu( glushkov, "babb" ), result );
+	TEST( ! le_mot_est_reconnu( glushkov, "abab" ), result );
+	TEST( equivalence_langage( glushkov, thompson, NULL ), result );
+
+	Automate * deterministe = creer_automate_deterministe( glushkov );
+	TEST( est_deterministe( deterministe ), result );
+	TEST( equivalence_langage( deterministe, glushkov, NULL ), result );
+	Automate * minimal = creer_automate_minimal( thompson );
+	TEST( taille_ensemble( get_etats( minimal ) ) == 4, result );
+	TEST( equivalence_langage( minimal, glushkov, NULL ), result );
+
+	Automate * classes = expression_vers_automate( "[a-c]+x?|\\*[^a-y]" );
+	TEST( le_mot_est_reconnu( classes, "abcx" ), result );
+	TEST( le_mot_est_reconnu( classes, "*z" ), result );
+	TEST( le_mot_est_reconnu( classes, "ax" ), result );
+	TEST( ! le_mot_est_reconnu( classes, "*" ), result );
+	TEST( ! le_mot_est_reconnu( classes, "x" ), result );
+
+	Automate * vide = expression_vers_automate( "a|" );
+	TEST( le_mot_est_reconnu( vide, "" ), result );
+	TEST( le_mot_est_reconnu( vide, "a" ), result );
+
+	TEST( expression_vers_automate( "(a" ) == NULL, result );
+	TEST( expression_vers_automate( "a)" ) == NULL, result );
+	TEST( expression_vers_automate( "*a" ) == NULL, result );
+	TEST( expression_vers_automate( "[]" ) == NULL, result );
+	TEST( expression_vers_automate( "[z-a]" ) == NULL, result );
+	TEST( expression_vers_automate( "a\\" ) == NULL, result );
+
+	Automate_compile * compile = compiler_expression(
+		"(ab|ba)*c?", CONSTRUCTION_GLUSHKOV, &temps
+	);
+	TEST( compile && compile->nb_etats == 4, result );
+	TEST( reconnait_compile( compile, "abbac", 5 ), result );
+	TEST( reconnait_compile( compile, "", 0 ), result );
+	TEST( ! reconnait_compile( compile, "abb", 3 ), result );
+	TEST( temps.analyse >= 0 && temps.minimisation >= 0, result );
+	liberer_automate_compile( compile );
+
+	// Les octets hors de l'alphabet, les lettres et les chiffres
+	compile = compiler_expression( "[a-z]+[0-9]", CONSTRUCTION_GLUSHKOV, NULL );
+	TEST( compile->nb_classes == 3, result );
+	TEST( compile->classes['a'] == compile->classes['q'], result );
+	TEST( compile->classes['0'] != compile->classes['q'], result );
+	TEST( compile->classes['#'] == 0, result );
+	TEST( reconnait_compile( compile, "abc7", 4 ), result );
+	TEST( ! reconnait_compile( compile, "ab#7", 4 ), result );
+	TEST( ! reconnait_compile( compile, "7", 1 ), result );
+	liberer_automate_compile( compile );
+
+	liberer_automate( glushkov );
+	liberer_automate( thompson );
+	liberer_automate( deterministe );
+	liberer_automate( minimal );
+	liberer_automate( classes );
+	liberer_automate( vide );
+
+	return result;
+}
+
+int test_utf8(){
+	BEGIN_TEST;
+
+	int result = 1;
+	char octets[LONGUEUR_MAX_UTF8 + 1];
+	uint32_t code_point;
+
+	TEST( encoder_utf8( 0x20AC, octets ) == 3, result );
+	TEST( memcmp( octets, "\xe2\x82\xac", 3 ) == 0, result );
+	TEST( encoder_utf8( 0xD800, octets ) == 0, result );
+	TEST( encoder_utf8( 0x110000, octets ) == 0, result );
+	TEST( decoder_utf8( "\xf0\x9f\x98\x80", &code_point ) == 4, result );
+	TEST( code_point == 0x1F600, result );
+	TEST( decoder_utf8( "\xc0\x80", &code_point ) == 0, result );
+	TEST( decoder_utf8( "\xed\xa0\x80", &code_point ) == 0, result );
+	TEST( decoder_utf8( "\xe2\x82", &code_point ) == 0, result );
+
+	// Les lettres sont ordonnées comme des octets non signés
+	const char * mots[] = { "az", "a\xe9" };
+	Automate * dictionnaire = creer_automate_dictionnaire( mots, 2 );
+	Enumerateur * enumerateur = creer_enumerateur( dictionnaire );
+	const char * premier = mot_suivant( enumerateur );
+	TEST( strcmp( premier, "az" ) == 0, result );
+	const char * second = mot_suivant( enumerateur );
+	TEST( strcmp( second, "a\xe9" ) == 0, result );
+	const char * fin = mot_suivant( enumerateur );
+	TEST( fin == NULL, result );
+	liberer_enumerateur( enumerateur );
+	liberer_automate( dictionnaire );
+
+	// Tous les points de code, entre les états 0 et 1
+	Automate * tous = creer_automate();
+	ajouter_etat_initial( tous, 0 );
+	ajouter_etat_final( tous, 1 );
+	int etat_libre = ajouter_intervalle_utf8( tous, 0, 0, CODE_POINT_MAX, 1, 2 );
+	TEST( etat_libre > 2, result );
+	Automate_compile * compile = compiler_automate( tous );
+	uint32_t exemples[] = { 0, 'a', 0x7F, 0x80, 0x7FF, 0x800, 0xD7FF, 0xE000,
+		0xFFFF, 0x10000, 0x10FFFF };
+	size_t i;
+	int tous_reconnus = 1;
+	for( i = 0; i < sizeof(exemples) / sizeof(exemples[0]); i++ ){
+		int longueur = encoder_utf8( exemples[i], octets );
+		tous_reconnus &= reconnait_compile( compile, octets, longueur );
+	}
+	TEST( tous_reconnus, result );
+	TEST( ! reconnait_compile( compile, "\xc0\x80", 2 ), result );
+	TEST( ! reconnait_compile( compile, "\xed\xa0\x80", 3 ), result );
+	TEST( ! reconnait_compile( compile, "\xf4\x90\x80\x80", 4 ), result );
+	TEST( ! reconnait_compile( compile, "\x80", 1 ), result );
+	liberer_automate_compile( compile );
+	liberer_automate( tous );
+
+	// Expressions rationnelles sur des points de code
+	compile = compiler_expression(
+		"[\xc3\xa0-\xc3\xbf]+|\xe2\x82\xac*", CONSTRUCTION_GLUSHKOV, NULL
+	);
+	TEST( compile != NULL, result );
+	TEST( reconnait_compile( compile, "\xc3\xa9\xc3\xa7", 4 ), result );
+	TEST( reconnait_compile( compile, "\xe2\x82\xac\xe2\x82\xac", 6 ), result );
+	TEST( ! reconnait_compile( compile, "e", 1 ), result );
+	TEST( ! reconnait_compile( compile, "\xc3\x80", 2 ), result );
+	liberer_automate_compile( compile );
+
+	compile = compiler_expression( "[^a]", CONSTRUCTION_THOMPSON, NULL );
+	TEST( reconnait_compile( compile, "b", 1 ), result );
+	TEST( reconnait_compile( compile, "\xe2\x82\xac", 3 ), result );
+	TEST( reconnait_compile( compile, "\xf4\x8f\xbf\xbf", 4 ), result );
+	TEST( ! reconnait_compile( compile, "a", 1 ), result );
+	TEST( ! reconnait_compile( compile, "\xed\xa0\x80", 3 ), result );
+	liberer_automate_compile( compile );
+
+	TEST( expression_vers_automate( "\xc3" ) == NULL, result );
+	TEST( expression_vers_automate( "[\xff]" ) == NULL, result );
+
+	return result;
+}
+
+int test_sauvegarde(){
+	BEGIN_TEST;
+
+	int result = 1;
+	char fichier[] = "/tmp/automate_XXXXXX";
+	int descripteur = mkstemp( fichier );
+	TEST( descripteur >= 0, result );
+	close( descripteur );
+
+	// Un automate non déterministe, avec des noms d'états quelconques
+	Automate * automate = creer_automate();
+	ajouter_lettre( automate, 'c' );
+	ajouter_transition( automate, -3, 'a', 7 );
+	ajouter_transition( automate, -3, 'a', 12 );
+	ajouter_transition( automate, 7, 'b', 12 );
+	ajouter_transition( automate, 12, (char) 0xe9, -3 );
+	ajouter_etat( automate, 40 );
+	ajouter_etat_initial( automate, -3 );
+	ajouter_etat_final( automate, 12 );
+	TEST( sauver_automate( automate, fichier ), result );
+	Automate * charge = charger_automate( fichier );
+	TEST( charge != NULL, result );
+	TEST( taille_ensemble( get_etats( charge ) ) == 4, result );
+	TEST( est_un_etat_de_l_automate( charge, 40 ), result );
+	TEST( taille_ensemble( get_alphabet( charge ) ) == 4, result );
+	TEST( est_une_lettre_de_l_automate( charge, 'c' ), result );
+	TEST( est_un_etat_initial_de_l_automate( charge, -3 ), result );
+	TEST( est_un_etat_final_de_l_automate( charge, 12 ), result );
+	TEST( est_une_transition_de_l_automate( charge, 12, (char) 0xe9, -3 ), result );
+	TEST( equivalence_langage( charge, automate, NULL ), result );
+	// Pas de table compilée pour un automate non déterministe
+	Automate_compile * projete = projeter_automate_compile( fichier );
+	TEST( projete == NULL, result );
+	liberer_automate( charge );
+	liberer_automate( automate );
+
+	Automate * deterministe = expression_vers_automate( "(ab|ba)*c?" );
+	Automate * minimal = creer_automate_minimal( deterministe );
+	TEST( sauver_automate( minimal, fichier ), result );
+	projete = projeter_automate_compile( fichier );
+	TEST( projete != NULL && projete->projection != NULL, result );
+	TEST( projete->nb_etats == 4, result );
+	TEST( reconnait_compile( projete, "abbac", 5 ), result );
+	TEST( reconnait_compile( projete, "", 0 ), result );
+	TEST( ! reconnait_compile( projete, "abb", 3 ), result );
+	liberer_automate_compile( projete );
+	charge = charger_automate( fichier );
+	TEST( equivalence_langage( charge, deterministe, NULL ), result );
+	liberer_automate( charge );
+	liberer_automate( minimal );
+	liberer_automate( deterministe );
+
+	// Un fichier tronqué ou d'un autre format est refusé
+	TEST( truncate( fichier, 100 ) == 0, result );
+	charge = charger_automate( fichier );
+	TEST( charge == NULL, result );
+	FILE * f = fopen( fichier, "w" );
+	fputs( "pas un automate", f );
+	fclose( f );
+	projete = projeter_automate_compile( fichier );
+	TEST( projete == NULL, result );
+	unlink( fichier );
+	charge = charger_automate( fichier );
+	TEST( charge == NULL, result );
+
+	return result;
+}
+
+int test_format_texte(){
+	BEGIN_TEST;
+
+	int result = 1;
+	int ligne;
+
+	// Des transitions dans le désordre, avec des doublons
+	int origines[] = { 2, -1, 2, -1, 2 };
+	char lettres[] = { 'b', ' ', '\\', ' ', 'b' };
+	int fins[] = { 2, 7, -1, 2, 2 };
+	Automate * automate = creer_automate();
+	ajouter_transitions_en_bloc( automate, origines, lettres, fins, 5 );
+	ajouter_etat( automate, 40 );
+	ajouter_lettre( automate, (char) 0xe9 );
+	ajouter_etat_initial( automate, -1 );
+	ajouter_etat_final( automate, 2 );
+	TEST( taille_ensemble( get_etats( automate ) ) == 4, result );
+	TEST( taille_ensemble( get_alphabet( automate ) ) == 4, result );
+	TEST( est_une_transition_de_l_automate( automate, -1, ' ', 7 ), result );
+	TEST( est_une_transition_de_l_automate( automate, 2, '\\', -1 ), result );
+	TEST( le_mot_est_reconnu( automate, " bb\\ " ), result );
+
+	char * texte = NULL;
+	size_t longueur = 0;
+	FILE * f = open_memstream( &texte, &longueur );
+	int ecrit = ecrire_automate( automate, f );
+	fclose( f );
+	TEST( ecrit, result );
+	Automate * relu = lire_automate( texte, longueur, &ligne );
+	TEST( relu != NULL && ligne == 0, result );
+	TEST( taille_ensemble( get_etats( relu ) ) == 4, result );
+	TEST( est_un_etat_de_l_automate( relu, 40 ), result );
+	TEST( est_une_lettre_de_l_automate( relu, (char) 0xe9 ), result );
+	TEST( est_un_etat_initial_de_l_automate( relu, -1 ), result );
+	TEST( equivalence_langage( relu, automate, NULL ), result );
+	free( texte );
+	liberer_automate( relu );
+
+	const char * lignes_ecrites = "# un commentaire\r\n"
+		"automate 1\r\n"
+		"\n"
+		"initiaux 0\n"
+		"  0 a 1\t\n"
+		"1 \\x5c 1\n"
+		"finaux 1";
+	relu = lire_automate( lignes_ecrites, strlen( lignes_ecrites ), &ligne );
+	TEST( relu != NULL && ligne == 0, result );
+	TEST( le_mot_est_reconnu( relu, "a\\\\" ), result );
+	liberer_automate( relu );
+
+	const char * faux[] = {
+		"0 a 1\n",
+		"automate 2\n",
+		"automate 1\n0 a\n",
+		"automate 1\n0 ab 1\n",
+		"automate 1\n# ok\n0 a 1\n0 \\x4 1\n",
+		"automate 1\netats 1 x\n",
+		"automate 1\n0 a 99999999999\n"
+	};
+	int lignes[] = { 1, 1, 2, 2, 4, 2, 2 };
+	size_t i;
+	int erreurs_detectees = 1;
+	for( i = 0; i < sizeof(faux) / sizeof(faux[0]); i++ ){
+		relu = lire_automate( faux[i], strlen( faux[i] ), &ligne );
+		erreurs_detectees &= ( relu == NULL && ligne == lignes[i] );
+	}
+	TEST( erreurs_detectees, result );
+
+	f = open_memstream( &texte, &longueur );
+	ecrit = ecrire_automate_dot( automate, f );
+	fclose( f );
+	TEST( ecrit, result );
+	TEST( strncmp( texte, "digraph automate {", 18 ) == 0, result );
+	TEST( strstr( texte, "\t\"2\" [shape=doublecircle];\n" ) != NULL, result );
+	TEST( strstr( texte, "\t\"initial -1\" -> \"-1\";\n" ) != NULL, result );
+	TEST( strstr( texte, "\t\"2\" -> \"-1\" [label=\"\\\\x5c\"];\n" ) != NULL, result );
+	TEST( strcmp( texte + longueur - 2, "}\n" ) == 0, result );
+	free( texte );
+
+	liberer_automate( automate );
+
+	return result;
+}
+
+int test_generateur(){
+	BEGIN_TEST;
+
+	int result = 1;
+	int i, identiques, corrects, nb_reconnus;
+
+	// Une même graine donne le même automate
+	Parametres_generateur p;
+	initialiser_parametres_generateur( &p );
+	p.nb_etats = 2000;
+	p.taille_alphabet = 3;
+	p.degre_moyen = 3;
+	p.densite_initiaux = 0.01;
+	Index_automate * index = generer_index_aleatoire( &p );
+	Index_automate * meme = generer_index_aleatoire( &p );
+	identiques = index->nb_transitions == meme->nb_transitions
+		&& memcmp( index->fins, meme->fins, index->nb_transitions * sizeof(int) ) == 0
+		&& memcmp( index->lettres, meme->lettres, index->nb_transitions ) == 0
+		&& memcmp( index->finaux, meme->finaux, ( NB_MOTS_BITS( 2000 ) + 1 ) * sizeof(uint64_t) ) == 0;
+	TEST( identiques, result );
+	// Seuls les doublons, rares, sont retirés
+	TEST( index->nb_transitions <= 3 * 2000, result );
+	TEST( index->nb_transitions >= 3 * 2000 * 95 / 100, result );
+	TEST( TESTER_BIT( index->initiaux, 0 ), result );
+	liberer_index_automate( meme );
+
+	// Les mots annoncés comme reconnus le sont
+	Automate * automate = generer_automate_aleatoire( &p );
+	Parametres_mots pm = { 200, 0.5, LOI_GEOMETRIQUE, 6, 7 };
+	Charge_mots * charge = generer_charge_mots( index, &pm );
+	corrects = 1;
+	nb_reconnus = 0;
+	for( i = 0; i < charge->nb_mots; i++ ){
+		nb_reconnus += charge->reconnus[i];
+		if( le_mot_est_reconnu( automate, charge->mots[i] ) != charge->reconnus[i] ){
+			corrects = 0;
+		}
+	}
+	TEST( corrects, result );
+	TEST( nb_reconnus >= 70 && nb_reconnus < charge->nb_mots, result );
+	liberer_charge_mots( charge );
+	liberer_automate( automate );
+	liberer_index_automate( index );
+
+	// Un automate déterministe, et des mots de longueur constante
+	p.deterministe = 1;
+	p.loi_degre = LOI_UNIFORME;
+	p.degre_moyen = 2;
+	automate = generer_automate_aleatoire( &p );
+	TEST( est_deterministe( automate ), result );
+	index = creer_index_automate( automate );
+	Automate_compile * compile = compiler_automate( automate );
+	pm.loi_longueur = LOI_CONSTANTE;
+	pm.proportion_reconnus = 1;
+	charge = generer_charge_mots( index, &pm );
+	corrects = 1;
+	for( i = 0; i < charge->nb_mots; i++ ){
+		if( ! charge->reconnus[i]
+			|| ! reconnait_compile( compile, charge->mots[i], strlen( charge->mots[i] ) )
+			|| strlen( charge->mots[i] ) < 6
+		){
+			corrects = 0;
+		}
+	}
+	TEST( corrects, result );
+	liberer_charge_mots( charge );
+	liberer_automate_compile( compile );
+	liberer_index_automate( index );
+	liberer_automate( automate );
+
+	// Sans alphabet, seul le mot vide peut être produit
+	automate = creer_automate();
+	ajouter_etat_initial( automate, 0 );
+	ajouter_etat_final( automate, 0 );
+	index = creer_index_automate( automate );
+	charge = generer_charge_mots( index, &pm );
+	corrects = 1;
+	for( i = 0; i < charge->nb_mots; i++ ){
+		if( charge->mots[i][0] != '\0' || ! charge->reconnus[i] ) corrects = 0;
+	}
+	TEST( corrects, result );
+	liberer_charge_mots( charge );
+	pm.proportion_reconnus = 0;
+	charge = generer_charge_mots( index, &pm );
+	corrects = 1;
+	for( i = 0; i < charge->nb_mots; i++ ){
+		if( charge->mots[i][0] != '\0' || ! charge->reconnus[i] ) corrects = 0;
+	}
+	TEST( corrects, result );
+	liberer_charge_mots( charge );
+	liberer_index_automate( index );
+	liberer_automate( automate );
+
+	return result;
+}
+
+int test_compteurs_allocations(){
+	BEGIN_TEST;
+
+	int result = 1;
+	int s;
+	Releve_allocations avant, apres, difference;
+
+	// Une opération qui libère tout ce qu'elle alloue ne laisse aucun
+	// octet vivant, quel que soit le mode de compilation.
+	Automate * automate = mot_to_automate( "abc" );
+	relever_allocations( &avant );
+	Ensemble * atteints = delta_star( automate, get_initiaux( automate ), "ab" );
+	liberer_ensemble( atteints );
+	Automate * copie = copier_automate( automate );
+	liberer_automate( copie );
+	relever_allocations( &apres );
+	difference_allocations( &avant, &apres, &difference );
+	for( s = 0; s < NB_SOUS_SYSTEMES_ALLOCATION; s++ ){
+		Compteurs_allocation * c = &difference.sous_systemes[s];
+		TEST( c->octets_vivants == 0, result );
+		TEST( c->allocations == c->liberations, result );
+		TEST( c->pic_octets >= 0, result );
+	}
+#ifdef COMPTER_ALLOCATIONS
+	TEST( difference.sous_systemes[ ALLOCATION_ENSEMBLE ].allocations > 0, result );
+	TEST( difference.sous_systemes[ ALLOCATION_AUTOMATE ].pic_octets > 0, result );
+#endif
+	liberer_automate( automate );
+
+	return result;
+}
+
+int test_stress_grand_automate(){
+	BEGIN_TEST;
+
+	int result = 1;
+	int i, corrects;
+
+	// Un automate déterministe d'environ 400 000 transitions, chargé en
+	// bloc, compilé, puis interrogé sur une charge de mots.
+	Parametres_generateur p;
+	initialiser_parametres_generateur( &p );
+	p.nb_etats = 100000;
+	p.taille_alphabet = 8;
+	p.loi_degre = LOI_UNIFORME;
+	p.degre_moyen = 4;
+	p.deterministe = 1;
+	p.densite_finaux = 0.05;
+	Index_automate * genere = generer_index_aleatoire( &p );
+	Automate * automate = generer_automate_aleatoire( &p );
+	Index_automate * index = creer_index_automate( automate );
+	TEST( index->nb_transitions == genere->nb_transitions, result );
+	TEST( index->nb_etats == genere->nb_etats, result );
+
+	Automate_compile * compile = compiler_automate( automate );
+	Parametres_mots pm = { 10000, 0.5, LOI_GEOMETRIQUE, 20, 11 };
+	Charge_mots * charge = generer_charge_mots( genere, &pm );
+	corrects = 1;
+	for( i = 0; i < charge->nb_mots; i++ ){
+		int reconnu = reconnait_compile(
+			compile, charge->mots[i], strlen( charge->mots[i] )
+		);
+		if( reconnu != charge->reconnus[i] ) corrects = 0;
+	}
+	TEST( corrects, result );
+
+	liberer_charge_mots( charge );
+	liberer_automate_compile( compile );
+	liberer_index_automate( index );
+	liberer_index_automate( genere );
+	liberer_automate( automate );
+
+	return result;
+}
+
+int test_determinisation_parallele(){
+	BEGIN_TEST;
+
+	int result = 1;
+	int graine, nb_fils, identiques;
+	int liste_fils[] = { 1, 2, 3, 8 };
+
+	// Le résultat est le même qu'en séquentiel, état par état, quel que
+	// soit le nombre de fils.
+	for( graine = 1; graine <= 4; graine++ ){
+		Parametres_generateur p;
+		initialiser_parametres_generateur( &p );
+		p.nb_etats = 40 + 20 * graine;
+		p.taille_alphabet = 2 + graine % 2;
+		p.degre_moyen = 2;
+		p.densite_initiaux = 0.2;
+		p.densite_finaux = 0.3;
+		p.graine = graine;
+		Automate * automate = generer_automate_aleatoire( &p );
+		Automate * sequentiel = creer_automate_deterministe( automate );
+		Index_automate * attendu = creer_index_automate( sequentiel );
+		for( nb_fils = 0; nb_fils < 4; nb_fils++ ){
+			Automate * parallele = creer_automate_deterministe_parallele(
+				automate, liste_fils[ nb_fils ]
+			);
+			Index_automate * obtenu = creer_index_automate( parallele );
+			identiques = obtenu->nb_etats == attendu->nb_etats
+				&& obtenu->nb_transitions == attendu->nb_transitions
+				&& memcmp(
+					obtenu->debut, attendu->debut,
+					( attendu->nb_etats + 1 ) * sizeof(int)
+				) == 0
+				&& memcmp(
+					obtenu->lettres, attendu->lettres, attendu->nb_transitions
+				) == 0
+				&& memcmp(
+					obtenu->fins, attendu->fins,
+					attendu->nb_transitions * sizeof(int)
+				) == 0
+				&& memcmp(
+					obtenu->finaux, attendu->finaux,
+					NB_MOTS_BITS( attendu->nb_etats ) * sizeof(uint64_t)
+				) == 0
+				&& est_deterministe( parallele );
+			TEST( identiques, result );
+			liberer_index_automate( obtenu );
+			liberer_automate( parallele );
+		}
+		liberer_index_automate( attendu );
+		liberer_automate( sequentiel );
+		liberer_automate( automate );
+	}
+
+	// Un automate sans transition
+	Automate * automate = mot_to_automate( "" );
+	Automate * parallele = creer_automate_deterministe_parallele( automate, 4 );
+	TEST( le_mot_est_reconnu( parallele, "" ), result );
+	TEST( ! le_mot_est_reconnu( parallele, "a" ), result );
+	liberer_automate( parallele );
+	liberer_automate( automate );
+
+	// Un automate sans état initial : aucun état, mais le même alphabet
+	automate = creer_automate();
+	ajouter_transition( automate, 1, 'a', 2 );
+	ajouter_etat_final( automate, 2 );
+	Automate * sequentiel = creer_automate_deterministe( automate );
+	parallele = creer_automate_deterministe_parallele( automate, 2 );
+	TEST( taille_ensemble( get_etats( sequentiel ) ) == 0, result );
+	TEST( taille_ensemble( get_initiaux( sequentiel ) ) == 0, result );
+	TEST( est_une_lettre_de_l_automate( sequentiel, 'a' ), result );
+	TEST( taille_ensemble( get_etats( parallele ) ) == 0, result );
+	TEST( taille_ensemble( get_initiaux( parallele ) ) == 0, result );
+	TEST( est_une_lettre_de_l_automate( parallele, 'a' ), result );
+	Automate * minimal = creer_automate_minimal( automate );
+	TEST( taille_ensemble( get_etats( minimal ) ) == 0, result );
+	TEST( taille_ensemble( get_initiaux( minimal ) ) == 0, result );
+	liberer_automate( minimal );
+	liberer_automate( sequentiel );
+	liberer_automate( parallele );
+	liberer_automate( automate );
+
+	// Avec un état initial mais un langage vide, seul le minimal n'a aucun
+	// état
+	automate = creer_automate();
+	ajouter_transition( automate, 0, 'a', 1 );
+	ajouter_etat_initial( automate, 0 );
+	sequentiel = creer_automate_deterministe( automate );
+	minimal = creer_automate_minimal( automate );
+	TEST( taille_ensemble( get_initiaux( sequentiel ) ) == 1, result );
+	TEST( taille_ensemble( get_etats( minimal ) ) == 0, result );
+	TEST( taille_ensemble( get_initiaux( minimal ) ) == 0, result );
+	liberer_automate( minimal );
+	liberer_automate( sequentiel );
+	liberer_automate( automate );
+
+	return result;
+}
+
+int test_parcours_largeur(){
+	BEGIN_TEST;
+
+	int result = 1;
+	int graine, nb_fils, i, identiques;
+	int liste_fils[] = { 1, 3 };
+
+	// Des graphes assez denses pour que le parcours monte
+	for( graine = 1; graine <= 3; graine++ ){
+		Parametres_generateur p;
+		initialiser_parametres_generateur( &p );
+		p.nb_etats = 20000;
+		p.taille_alphabet = 3;
+		p.degre_moyen = graine == 1 ? 1.1 : 2 * graine;
+		p.densite_finaux = 0.001;
+		p.graine = graine;
+		Automate * automate = generer_automate_aleatoire( &p );
+		Index_automate * index = creer_index_automate( automate );
+		Index_automate * miroir = creer_index_miroir( index );
+		size_t nb_mots = NB_MOTS_BITS( index->nb_etats );
+		uint64_t * attendu = xmalloc( nb_mots * sizeof(uint64_t) );
+
+		// Les états accessibles, comparés à etats_accessibles()
+		Ensemble * accessibles = etats_accessibles( automate, index->noms[0] );
+		memset( attendu, 0, nb_mots * sizeof(uint64_t) );
+		MARQUER_BIT( attendu, 0 );
+		for( i = 0; i < index->nb_etats; i++ ){
+			if( est_dans_l_ensemble( accessibles, index->noms[i] ) ){
+				MARQUER_BIT( attendu, i );
+			}
+		}
+		liberer_ensemble( accessibles );
+		for( nb_fils = 0; nb_fils < 2; nb_fils++ ){
+			uint64_t * obtenu = etats_accessibles_index(
+				index, nb_fils ? miroir : NULL, liste_fils[ nb_fils ]
+			);
+			identiques = memcmp( obtenu, attendu, nb_mots * sizeof(uint64_t) ) == 0;
+			TEST( identiques, result );
+			xfree( obtenu );
+		}
+
+		// Les états co-accessibles, comparés à un parcours toujours
+		// descendant de l'index miroir
+		parcourir_en_largeur( miroir, NULL, index->finaux, attendu, 1 );
+		for( nb_fils = 0; nb_fils < 2; nb_fils++ ){
+			uint64_t * obtenu = etats_co_accessibles_index(
+				index, miroir, liste_fils[ nb_fils ]
+			);
+			identiques = memcmp( obtenu, attendu, nb_mots * sizeof(uint64_t) ) == 0;
+			TEST( identiques, result );
+			xfree( obtenu );
+		}
+
+		xfree( attendu );
+		liberer_index_automate( miroir );
+		liberer_index_automate( index );
+		liberer_automate( automate );
+	}
+
+	// L'automate émondé : 4 n'est pas accessible, 3 pas co-accessible
+	Automate * automate = creer_automate();
+	ajouter_transition( automate, 1, 'a', 2 );
+	ajouter_transition( automate, 2, 'b', 1 );
+	ajouter_transition( automate, 2, 'a', 3 );
+	ajouter_transition( automate, 4, 'c', 2 );
+	ajouter_etat_initial( automate, 1 );
+	ajouter_etat_final( automate, 2 );
+	Automate * emonde = automate_emonde( automate, 2 );
+	TEST( taille_ensemble( get_etats( emonde ) ) == 2, result );
+	TEST( est_dans_l_ensemble( get_etats( emonde ), 1 ), result );
+	TEST( est_dans_l_ensemble( get_etats( emonde ), 2 ), result );
+	TEST( est_une_transition_de_l_automate( emonde, 1, 'a', 2 ), result );
+	TEST( est_une_transition_de_l_automate( emonde, 2, 'b', 1 ), result );
+	TEST( ! est_une_transition_de_l_automate( emonde, 2, 'a', 3 ), result );
+	TEST( est_un_etat_final_de_l_automate( emonde, 2 ), result );
+	TEST( le_mot_est_reconnu( emonde, "aba" ), result );
+	liberer_automate( emonde );
+	liberer_automate( automate );
+
+	return result;
+}
+
+/* Un fil qui relit toute une charge de mots sur un automate gelé. */
+typedef struct {
+	const Automate * automate;
+	const Charge_mots * charge;
+	int nb_erreurs;
+} Lecteur_gele;
+
+static void * lire_automate_gele( void * donnees ){
+	Lecteur_gele * l = donnees;
+	int i;
+	for( i = 0; i < l->charge->nb_mots; i++ ){
+		if( le_mot_est_reconnu( l->automate, l->charge->mots[i] )
+			!= l->charge->reconnus[i]
+		){
+			l->nb_erreurs++;
+		}
+	}
+	return NULL;
+}
+
+static void compter_transition_gelee( int origine, char lettre, int fin, void* data ){
+	const Automate ** automates = data;
+	if( ! est_une_transition_de_l_automate( automates[0], origine, lettre, fin ) ){
+		automates[1] = NULL;
+	}
+}
+
+int test_automate_gele(){
+	BEGIN_TEST;
+
+	int result = 1;
+	int deterministe, i, identiques, statut;
+	pid_t fils;
+
+	for( deterministe = 0; deterministe < 2; deterministe++ ){
+		Parametres_generateur p;
+		initialiser_parametres_generateur( &p );
+		p.nb_etats = 500;
+		p.taille_alphabet = 3;
+		p.degre_moyen = 2;
+		p.densite_initiaux = deterministe ? 0 : 0.02;
+		p.deterministe = deterministe;
+		p.graine = 5 + deterministe;
+		Automate * automate = generer_automate_aleatoire( &p );
+		Automate * copie = copier_automate( automate );
+		Index_automate * index = creer_index_automate( automate );
+		Parametres_mots pm = { 300, 0.5, LOI_GEOMETRIQUE, 8, 9 };
+		Charge_mots * charge = generer_charge_mots( index, &pm );
+		geler_automate( automate );
+		TEST( est_gele( automate ), result );
+		TEST( ! est_gele( copie ), result );
+
+		// Les lectures donnent les mêmes résultats qu'avant le gel
+		Lecteur_gele lecteurs[4];
+		pthread_t fils_lecteurs[4];
+		for( i = 0; i < 4; i++ ){
+			lecteurs[i].automate = automate;
+			lecteurs[i].charge = charge;
+			lecteurs[i].nb_erreurs = 0;
+			pthread_create( &fils_lecteurs[i], NULL, lire_automate_gele, &lecteurs[i] );
+		}
+		for( i = 0; i < 4; i++ ){
+			pthread_join( fils_lecteurs[i], NULL );
+			TEST( lecteurs[i].nb_erreurs == 0, result );
+		}
+		identiques = 1;
+		for( i = 0; i < index->nb_etats; i += 7 ){
+			Ensemble * etats = creer_ensemble( NULL, NULL, NULL );
+			ajouter_element( etats, index->noms[i] );
+			ajouter_element( etats, index->noms[ ( 3 * i ) % index->nb_etats ] );
+			Ensemble * attendu = delta( copie, etats, 'a' + i % 3 );
+			Ensemble * obtenu = delta( automate, etats, 'a' + i % 3 );
+			if( comparer_ensemble( attendu, obtenu ) ) identiques = 0;
+			liberer_ensemble( attendu );
+			liberer_ensemble( obtenu );
+			liberer_ensemble( etats );
+		}
+		TEST( identiques, result );
+		const Automate * automates[2] = { automate, copie };
+		pour_toute_transition( copie, compter_transition_gelee, automates );
+		TEST( automates[1] != NULL, result );
+		TEST( ! est_une_transition_de_l_automate( automate, index->noms[0], 'z', index->noms[0] ), result );
+		TEST( ! est_une_transition_de_l_automate( automate, -1, 'a', index->noms[0] ), result );
+
+		liberer_charge_mots( charge );
+		liberer_index_automate( index );
+		liberer_automate( copie );
+		liberer_automate( automate );
+	}
+
+	// Un automate gelé refuse d'être modifié
+	Automate * automate = mot_to_automate( "ab" );
+	geler_automate( automate );
+	fils = fork();
+	if( fils == 0 ){
+		freopen( "/dev/null", "w", stderr );
+		ajouter_transition( automate, 0, 'c', 0 );
+		_exit( EXIT_SUCCESS );
+	}
+	waitpid( fils, &statut, 0 );
+	TEST( WIFEXITED( statut ) && WEXITSTATUS( statut ) == EXIT_FAILURE, result );
+
+	// et peut l'être de nouveau une fois dégelé
+	degeler_automate( automate );
+	ajouter_etat_final( automate, 0 );
+	TEST( le_mot_est_reconnu( automate, "" ), result );
+	liberer_automate( automate );
+
+	return result;
+}
+
+int main( int argc, char ** argv ){
+	Options_tests options;
+	int i;
+
+	options.nb_fils = sysconf( _SC_NPROCESSORS_ONLN );
+	options.delai = 60;
+	options.memoire_mo = 2048;
+	options.filtre = "";
+	for( i = 1; i < argc; i++ ){
+		if( strcmp( argv[i], "-j" ) == 0 && i + 1 < argc ){
+			options.nb_fils = atoi( argv[++i] );
+		}else if( strcmp( argv[i], "-t" ) == 0 && i + 1 < argc ){
+			options.delai = atof( argv[++i] );
+		}else if( strcmp( argv[i], "-m" ) == 0 && i + 1 < argc ){
+			options.memoire_mo = atol( argv[++i] );
+		}else if( argv[i][0] == '-' ){
+			fprintf(
+				stderr, "Usage : %s [-j nb_fils] [-t delai_en_secondes] "
+				"[-m memoire_en_mo, 0 sans limite] [filtre]\n", argv[0]
+			);
+			return EXIT_FAILURE;
+		}else{
+			options.filtre = argv[i];
+		}
+	}
+	if( options.nb_fils < 1 ) options.nb_fils = 1;
 
 	ajouter_test( test_execute_fonctions );
 	ajouter_test( test_delta_delta_star );
 	ajouter_test( test_creer_automate );
 	ajouter_test( test_mot_accepte );
 	ajouter_test( test_automate_vide );
-
-	set_all_sigactions();
-	
-	start_or_continue_test();
-
-	exit( nb_test );
+	ajouter_test( test_melange );
+	ajouter_test( test_produit );
+	ajouter_test( test_inclusion_equivalence );
+	ajouter_test( test_plus_court_mot );
+	ajouter_test( test_comptage );
+	ajouter_test( test_echantillonnage );
+	ajouter_test( test_enumeration );
+	ajouter_test( test_dictionnaire );
+	ajouter_test( test_aho_corasick );
+	ajouter_test( test_automate_suffixes );
+	ajouter_test( test_expression_rationnelle );
+	ajouter_test( test_utf8 );
+	ajouter_test( test_sauvegarde );
+	ajouter_test( test_format_texte );
+	ajouter_test( test_generateur );
+	ajouter_test( test_compteurs_allocations );
+	ajouter_test( test_stress_grand_automate );
+	ajouter_test( test_determinisation_parallele );
+	ajouter_test( test_parcours_largeur );
+	ajouter_test( test_automate_gele );
+
+	return executer_tests( &options ) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -22,62 +22,188 @@
 #include "outils.h"
 #include "fifo.h"
 
-typedef struct _List List;
+#include <string.h>
 
-struct _List {
-	List * next;
-	intptr_t element;
-};
+#define CAPACITE_INITIALE 16
 
+/*
+ * Les éléments de la file sont elements[ ( debut + i ) & ( capacite - 1 ) ]
+ * pour i allant de 0 à taille - 1. La capacité est une puissance de 2.
+ */
 struct _Fifo {
-	List * list;
+	intptr_t * elements;
+	size_t capacite;
+	size_t debut;
+	size_t taille;
 };
 
-List* allouer_list( List * next, intptr_t element ){
-	List* res = (List*) xmalloc( sizeof(List) );
-	res->next = next;
-	res->element = element;
+Fifo* creer_fifo(){
+	Fifo* res = xmalloc_etiquete( sizeof(Fifo), ALLOCATION_FIFO );
+	res->capacite = CAPACITE_INITIALE;
+	res->elements = xmalloc_etiquete(
+		res->capacite * sizeof(intptr_t), ALLOCATION_FIFO
+	);
+	res->debut = 0;
+	res->taille = 0;
 	return res;
 }
 
-void liberer_list( List * list ){
-	xfree( list );
+void liberer_fifo( Fifo* fifo ){
+	xfree( fifo->elements );
+	xfree( fifo );
+}
+
+int est_vide( Fifo* fifo ){
+	return fifo->taille == 0;
+}
+
+size_t taille_fifo( const Fifo* fifo ){
+	return fifo->taille;
+}
+
+/* Agrandit la file pour qu'elle puisse contenir 'taille' éléments. Les
+ * éléments sont recopiés au début du nouveau tableau.
+ */
+static void reserver_fifo( Fifo* fifo, size_t taille ){
+	size_t capacite = fifo->capacite, premiere_partie;
+	intptr_t * elements;
+	if( taille <= capacite ) return;
+	while( capacite < taille ) capacite *= 2;
+	elements = xmalloc_etiquete( capacite * sizeof(intptr_t), ALLOCATION_FIFO );
+	premiere_partie = fifo->capacite - fifo->debut;
+	if( premiere_partie > fifo->taille ) premiere_partie = fifo->taille;
+	memcpy(
+		elements, fifo->elements + fifo->debut,
+		premiere_partie * sizeof(intptr_t)
+	);
+	memcpy(
+		elements + premiere_partie, fifo->elements,
+		( fifo->taille - premiere_partie ) * sizeof(intptr_t)
+	);
+	xfree( fifo->elements );
+	fifo->elements = elements;
+	fifo->capacite = capacite;
+	fifo->debut = 0;
 }
 
 void ajouter_fifo( Fifo* fifo, intptr_t element ){
-	fifo->list = allouer_list( fifo->list, element );
+	if( fifo->taille == fifo->capacite ) reserver_fifo( fifo, fifo->taille + 1 );
+	fifo->elements[ ( fifo->debut + fifo->taille ) & ( fifo->capacite - 1 ) ] =
+		element;
+	fifo->taille++;
+}
+
+void ajouter_elements_fifo( Fifo* fifo, const intptr_t* elements, size_t nb ){
+	size_t fin, premiere_partie;
+	reserver_fifo( fifo, fifo->taille + nb );
+	fin = ( fifo->debut + fifo->taille ) & ( fifo->capacite - 1 );
+	premiere_partie = fifo->capacite - fin;
+	if( premiere_partie > nb ) premiere_partie = nb;
+	memcpy( fifo->elements + fin, elements, premiere_partie * sizeof(intptr_t) );
+	memcpy(
+		fifo->elements, elements + premiere_partie,
+		( nb - premiere_partie ) * sizeof(intptr_t)
+	);
+	fifo->taille += nb;
 }
 
 intptr_t retirer_fifo( Fifo* fifo ){
-	intptr_t res = fifo->list->element;
-	List* tmp = fifo->list;
-	fifo->list = fifo->list->next;
-	liberer_list( tmp );
+	intptr_t res = fifo->elements[ fifo->debut ];
+	fifo->debut = ( fifo->debut + 1 ) & ( fifo->capacite - 1 );
+	fifo->taille--;
 	return res;
 }
 
+size_t retirer_elements_fifo( Fifo* fifo, intptr_t* elements, size_t nb ){
+	size_t premiere_partie;
+	if( nb > fifo->taille ) nb = fifo->taille;
+	premiere_partie = fifo->capacite - fifo->debut;
+	if( premiere_partie > nb ) premiere_partie = nb;
+	memcpy(
+		elements, fifo->elements + fifo->debut,
+		premiere_partie * sizeof(intptr_t)
+	);
+	memcpy(
+		elements + premiere_partie, fifo->elements,
+		( nb - premiere_partie ) * sizeof(intptr_t)
+	);
+	fifo->debut = ( fifo->debut + nb ) & ( fifo->capacite - 1 );
+	fifo->taille -= nb;
+	return nb;
+}
+
 intptr_t obtenir_fifo( Fifo* fifo ){
-	return fifo->list->element;
+	return fifo->elements[ fifo->debut ];
 }
 
-int est_vide( Fifo* fifo ){
-	return fifo->list == NULL;
+void vider_fifo( Fifo* fifo ){
+	fifo->debut = 0;
+	fifo->taille = 0;
 }
 
-Fifo* creer_fifo(){
-	Fifo* res = xmalloc( sizeof(Fifo) );
-	res->list = NULL;
+struct _Pile {
+	intptr_t * elements;
+	size_t capacite;
+	size_t taille;
+};
+
+Pile* creer_pile(){
+	Pile* res = xmalloc_etiquete( sizeof(Pile), ALLOCATION_FIFO );
+	res->capacite = CAPACITE_INITIALE;
+	res->elements = xmalloc_etiquete(
+		res->capacite * sizeof(intptr_t), ALLOCATION_FIFO
+	);
+	res->taille = 0;
 	return res;
 }
 
-void vider_list( List * list ){
-	if( list ){
-		vider_list( list->next );
-		xfree( list );
-	}
+void liberer_pile( Pile* pile ){
+	xfree( pile->elements );
+	xfree( pile );
+}
+
+int pile_est_vide( const Pile* pile ){
+	return pile->taille == 0;
+}
+
+size_t taille_pile( const Pile* pile ){
+	return pile->taille;
+}
+
+static void reserver_pile( Pile* pile, size_t taille ){
+	if( taille <= pile->capacite ) return;
+	while( pile->capacite < taille ) pile->capacite *= 2;
+	pile->elements = xrealloc_etiquete(
+		pile->elements, pile->capacite * sizeof(intptr_t), ALLOCATION_FIFO
+	);
+}
+
+void empiler( Pile* pile, intptr_t element ){
+	if( pile->taille == pile->capacite ) reserver_pile( pile, pile->taille + 1 );
+	pile->elements[ pile->taille++ ] = element;
+}
+
+void empiler_elements( Pile* pile, const intptr_t* elements, size_t nb ){
+	reserver_pile( pile, pile->taille + nb );
+	memcpy( pile->elements + pile->taille, elements, nb * sizeof(intptr_t) );
+	pile->taille += nb;
+}
+
+intptr_t depiler( Pile* pile ){
+	return pile->elements[ --pile->taille ];
+}
+
+size_t depiler_elements( Pile* pile, intptr_t* elements, size_t nb ){
+	size_t i;
+	if( nb > pile->taille ) nb = pile->taille;
+	for( i = 0; i < nb; i++ ) elements[i] = pile->elements[ --pile->taille ];
+	return nb;
+}
+
+intptr_t sommet_pile( const Pile* pile ){
+	return pile->elements[ pile->taille - 1 ];
 }
 
-void liberer_fifo( Fifo* file ){
-	vider_list( file->list );
-	xfree( file );
+void vider_pile( Pile* pile ){
+	pile->taille = 0;
 }
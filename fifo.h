@@ -22,13 +22,18 @@
 #ifndef __FIFO_H__
 #define __FIFO_H__
 
+#include <stddef.h>
 #include <stdint.h>
 
 /*
  * Définit le type d'une file first-in first-out contenant des entiers ou 
- * des pointerus vers des stucture plus complexes.
+ * des pointeurs vers des structures plus complexes.
  * La file n'est pas responsable de la mémoire des éléments qui y sont 
  * entreposés.
+ *
+ * La file est un tableau circulaire dont la capacité double quand il est
+ * plein : un ajout coûte O(1) amorti et n'alloue rien en dehors de ces
+ * agrandissements.
  */
 typedef struct _Fifo Fifo;
 
@@ -39,7 +44,7 @@ Fifo* creer_fifo();
 
 /*
  * Supprimme la mémoire associée à la file.
- * La mamoir associée aux élément de la file ne sont pas supprimé.
+ * La mémoire associée aux éléments de la file n'est pas supprimée.
  */
 void liberer_fifo( Fifo* fifo );
 
@@ -49,19 +54,85 @@ void liberer_fifo( Fifo* fifo );
 int est_vide( Fifo* fifo );
 
 /*
- * Ajoute un élément au dessus de la pile.
+ * Renvoie le nombre d'éléments de la file.
+ */
+size_t taille_fifo( const Fifo* fifo );
+
+/*
+ * Ajoute un élément à la fin de la file.
  */
 void ajouter_fifo( Fifo* fifo, intptr_t element );
 
 /*
- * Retire un élément du dessus de la pile et le renvoie.
+ * Ajoute 'nb' éléments à la fin de la file, dans l'ordre du tableau.
+ */
+void ajouter_elements_fifo( Fifo* fifo, const intptr_t* elements, size_t nb );
+
+/*
+ * Retire l'élément du début de la file et le renvoie. La file ne doit pas
+ * être vide.
  */
 intptr_t retirer_fifo( Fifo* fifo );
 
 /*
- * Renvoie l'élement qui se trouve au dessus de la pile. L'élément n'est pas
- * retiré de la pile.
+ * Retire au plus 'nb' éléments du début de la file, les écrit dans
+ * 'elements' dans l'ordre de la file, et renvoie leur nombre.
+ */
+size_t retirer_elements_fifo( Fifo* fifo, intptr_t* elements, size_t nb );
+
+/*
+ * Renvoie l'élement qui se trouve au début de la file. L'élément n'est pas
+ * retiré de la file.
  */
 intptr_t obtenir_fifo( Fifo* fifo );
 
+/*
+ * Retire tous les éléments de la file, sans rendre sa mémoire.
+ */
+void vider_fifo( Fifo* fifo );
+
+/*
+ * Définit le type d'une pile last-in first-out, avec les mêmes conventions
+ * que la file : un tableau qui double quand il est plein.
+ */
+typedef struct _Pile Pile;
+
+Pile* creer_pile();
+
+void liberer_pile( Pile* pile );
+
+int pile_est_vide( const Pile* pile );
+
+size_t taille_pile( const Pile* pile );
+
+/*
+ * Ajoute un élément au dessus de la pile.
+ */
+void empiler( Pile* pile, intptr_t element );
+
+/*
+ * Ajoute 'nb' éléments au dessus de la pile : le dernier élément du
+ * tableau se retrouve au sommet.
+ */
+void empiler_elements( Pile* pile, const intptr_t* elements, size_t nb );
+
+/*
+ * Retire l'élément du dessus de la pile et le renvoie. La pile ne doit pas
+ * être vide.
+ */
+intptr_t depiler( Pile* pile );
+
+/*
+ * Retire au plus 'nb' éléments du dessus de la pile, les écrit dans
+ * 'elements' en commençant par le sommet, et renvoie leur nombre.
+ */
+size_t depiler_elements( Pile* pile, intptr_t* elements, size_t nb );
+
+/*
+ * Renvoie l'élément du dessus de la pile, sans le retirer.
+ */
+intptr_t sommet_pile( const Pile* pile );
+
+void vider_pile( Pile* pile );
+
 #endif
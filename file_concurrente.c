@@ -0,0 +1,279 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "outils.h"
+#include "file_concurrente.h"
+
+#include <stdatomic.h>
+
+/* Les compteurs modifiés par des fils différents sont placés sur des
+ * lignes de cache différentes, pour éviter le faux partage.
+ */
+#define TAILLE_LIGNE_CACHE 64
+
+typedef struct {
+	atomic_size_t sequence;
+	intptr_t element;
+} Case_file;
+
+struct _File_concurrente {
+	Case_file * cases;
+	size_t masque;
+	_Alignas( TAILLE_LIGNE_CACHE ) atomic_size_t ajouts;
+	_Alignas( TAILLE_LIGNE_CACHE ) atomic_size_t retraits;
+};
+
+File_concurrente* creer_file_concurrente( size_t capacite ){
+	File_concurrente* res;
+	size_t taille = 2, i;
+	while( taille < capacite ) taille *= 2;
+	// xmalloc ne garantit que l'alignement de max_align_t.
+	if( posix_memalign( (void **) &res, TAILLE_LIGNE_CACHE, sizeof(File_concurrente) ) ){
+		ERREUR( "Espace insuffisant" );
+	}
+	res->cases = xmalloc_etiquete( taille * sizeof(Case_file), ALLOCATION_FIFO );
+	res->masque = taille - 1;
+	for( i = 0; i < taille; i++ ){
+		atomic_init( &res->cases[i].sequence, i );
+	}
+	atomic_init( &res->ajouts, 0 );
+	atomic_init( &res->retraits, 0 );
+	return res;
+}
+
+void liberer_file_concurrente( File_concurrente* file ){
+	xfree( file->cases );
+	free( file );
+}
+
+/*
+ * La case d'indice p (modulo la capacité) a pour séquence p quand elle
+ * attend le p-ième ajout, et p + 1 quand elle contient l'élément de cet
+ * ajout. Un retrait la remet à p + capacité pour le tour suivant.
+ */
+int ajouter_file_concurrente( File_concurrente* file, intptr_t element ){
+	size_t position = atomic_load_explicit( &file->ajouts, memory_order_relaxed );
+	Case_file * c;
+	for(;;){
+		intptr_t difference;
+		size_t sequence;
+		c = &file->cases[ position & file->masque ];
+		sequence = atomic_load_explicit( &c->sequence, memory_order_acquire );
+		difference = (intptr_t) sequence - (intptr_t) position;
+		if( difference == 0 ){
+			if( atomic_compare_exchange_weak_explicit(
+				&file->ajouts, &position, position + 1,
+				memory_order_relaxed, memory_order_relaxed
+			) ) break;
+		}else if( difference < 0 ){
+			return 0;
+		}else{
+			position = atomic_load_explicit( &file->ajouts, memory_order_relaxed );
+		}
+	}
+	c->element = element;
+	atomic_store_explicit( &c->sequence, position + 1, memory_order_release );
+	return 1;
+}
+
+int retirer_file_concurrente( File_concurrente* file, intptr_t* element ){
+	size_t position = atomic_load_explicit( &file->retraits, memory_order_relaxed );
+	Case_file * c;
+	for(;;){
+		intptr_t difference;
+		size_t sequence;
+		c = &file->cases[ position & file->masque ];
+		sequence = atomic_load_explicit( &c->sequence, memory_order_acquire );
+		difference = (intptr_t) sequence - (intptr_t) ( position + 1 );
+		if( difference == 0 ){
+			if( atomic_compare_exchange_weak_explicit(
+				&file->retraits, &position, position + 1,
+				memory_order_relaxed, memory_order_relaxed
+			) ) break;
+		}else if( difference < 0 ){
+			return 0;
+		}else{
+			position = atomic_load_explicit( &file->retraits, memory_order_relaxed );
+		}
+	}
+	*element = c->element;
+	atomic_store_explicit(
+		&c->sequence, position + file->masque + 1, memory_order_release
+	);
+	return 1;
+}
+
+size_t taille_file_concurrente( File_concurrente* file ){
+	size_t retraits = atomic_load_explicit( &file->retraits, memory_order_relaxed );
+	size_t ajouts = atomic_load_explicit( &file->ajouts, memory_order_relaxed );
+	return ajouts > retraits ? ajouts - retraits : 0;
+}
+
+/*
+ * Un tableau circulaire de la deque. 'precedent' chaîne les tableaux
+ * remplacés, qui ne sont libérés qu'avec la deque.
+ */
+typedef struct _Tableau_deque {
+	size_t masque;
+	struct _Tableau_deque * precedent;
+	_Atomic intptr_t elements[];
+} Tableau_deque;
+
+/*
+ * 'haut' est l'indice du plus ancien élément, et 'bas' celui qui suit le
+ * plus récent. Les indices ne font que croître ; un élément d'indice i est
+ * rangé dans la case i & masque du tableau courant.
+ *
+ * Les ordres mémoire sont ceux de Lê, Pop, Cohen et Zappa Nardelli
+ * (« Correct and Efficient Work-Stealing for Weak Memory Models », 2013).
+ */
+struct _Deque_vol {
+	_Alignas( TAILLE_LIGNE_CACHE ) atomic_llong haut;
+	_Alignas( TAILLE_LIGNE_CACHE ) atomic_llong bas;
+	_Atomic( Tableau_deque * ) tableau;
+};
+
+#define CAPACITE_INITIALE_DEQUE 64
+
+static Tableau_deque * creer_tableau_deque( size_t taille ){
+	Tableau_deque * res = xmalloc_etiquete(
+		sizeof(Tableau_deque) + taille * sizeof(_Atomic intptr_t),
+		ALLOCATION_FIFO
+	);
+	res->masque = taille - 1;
+	res->precedent = NULL;
+	return res;
+}
+
+Deque_vol* creer_deque_vol(){
+	Deque_vol* res;
+	if( posix_memalign( (void **) &res, TAILLE_LIGNE_CACHE, sizeof(Deque_vol) ) ){
+		ERREUR( "Espace insuffisant" );
+	}
+	atomic_init( &res->haut, 0 );
+	atomic_init( &res->bas, 0 );
+	atomic_init( &res->tableau, creer_tableau_deque( CAPACITE_INITIALE_DEQUE ) );
+	return res;
+}
+
+void liberer_deque_vol( Deque_vol* deque ){
+	Tableau_deque * t =
+		atomic_load_explicit( &deque->tableau, memory_order_relaxed );
+	while( t ){
+		Tableau_deque * precedent = t->precedent;
+		xfree( t );
+		t = precedent;
+	}
+	free( deque );
+}
+
+/* Remplace le tableau plein par un tableau deux fois plus grand, qui
+ * contient les éléments d'indices 'haut' à 'bas' - 1.
+ */
+static Tableau_deque * agrandir_deque(
+	Deque_vol* deque, Tableau_deque * ancien, long long haut, long long bas
+){
+	Tableau_deque * res = creer_tableau_deque( 2 * ( ancien->masque + 1 ) );
+	long long i;
+	for( i = haut; i < bas; i++ ){
+		atomic_store_explicit(
+			&res->elements[ i & res->masque ],
+			atomic_load_explicit(
+				&ancien->elements[ i & ancien->masque ], memory_order_relaxed
+			),
+			memory_order_relaxed
+		);
+	}
+	res->precedent = ancien;
+	atomic_store_explicit( &deque->tableau, res, memory_order_release );
+	return res;
+}
+
+void empiler_deque_vol( Deque_vol* deque, intptr_t element ){
+	long long bas = atomic_load_explicit( &deque->bas, memory_order_relaxed );
+	long long haut = atomic_load_explicit( &deque->haut, memory_order_acquire );
+	Tableau_deque * t = atomic_load_explicit( &deque->tableau, memory_order_relaxed );
+	if( bas - haut > (long long) t->masque ){
+		t = agrandir_deque( deque, t, haut, bas );
+	}
+	atomic_store_explicit(
+		&t->elements[ bas & t->masque ], element, memory_order_relaxed
+	);
+	atomic_thread_fence( memory_order_release );
+	atomic_store_explicit( &deque->bas, bas + 1, memory_order_relaxed );
+}
+
+int depiler_deque_vol( Deque_vol* deque, intptr_t* element ){
+	long long bas = atomic_load_explicit( &deque->bas, memory_order_relaxed ) - 1;
+	Tableau_deque * t = atomic_load_explicit( &deque->tableau, memory_order_relaxed );
+	long long haut;
+	int res = 1;
+
+	atomic_store_explicit( &deque->bas, bas, memory_order_relaxed );
+	atomic_thread_fence( memory_order_seq_cst );
+	haut = atomic_load_explicit( &deque->haut, memory_order_relaxed );
+	if( haut > bas ){
+		// La deque était vide.
+		atomic_store_explicit( &deque->bas, bas + 1, memory_order_relaxed );
+		return 0;
+	}
+	*element = atomic_load_explicit(
+		&t->elements[ bas & t->masque ], memory_order_relaxed
+	);
+	if( haut == bas ){
+		// Le dernier élément : on le dispute aux voleurs.
+		if( ! atomic_compare_exchange_strong_explicit(
+			&deque->haut, &haut, haut + 1,
+			memory_order_seq_cst, memory_order_relaxed
+		) ){
+			res = 0;
+		}
+		atomic_store_explicit( &deque->bas, bas + 1, memory_order_relaxed );
+	}
+	return res;
+}
+
+Resultat_vol voler_deque_vol( Deque_vol* deque, intptr_t* element ){
+	long long haut = atomic_load_explicit( &deque->haut, memory_order_acquire );
+	long long bas;
+	Tableau_deque * t;
+
+	atomic_thread_fence( memory_order_seq_cst );
+	bas = atomic_load_explicit( &deque->bas, memory_order_acquire );
+	if( haut >= bas ) return VOL_VIDE;
+	t = atomic_load_explicit( &deque->tableau, memory_order_consume );
+	*element = atomic_load_explicit(
+		&t->elements[ haut & t->masque ], memory_order_relaxed
+	);
+	if( ! atomic_compare_exchange_strong_explicit(
+		&deque->haut, &haut, haut + 1,
+		memory_order_seq_cst, memory_order_relaxed
+	) ){
+		return VOL_CONFLIT;
+	}
+	return VOL_REUSSI;
+}
+
+size_t taille_deque_vol( Deque_vol* deque ){
+	long long bas = atomic_load_explicit( &deque->bas, memory_order_relaxed );
+	long long haut = atomic_load_explicit( &deque->haut, memory_order_relaxed );
+	return bas > haut ? bas - haut : 0;
+}
@@ -0,0 +1,119 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __FILE_CONCURRENTE_H__
+#define __FILE_CONCURRENTE_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Définit le type d'une file first-in first-out bornée, partagée par
+ * plusieurs fils d'exécution qui peuvent tous y ajouter et en retirer des
+ * éléments en même temps, sans verrou (algorithme de D. Vyukov : chaque
+ * case porte un numéro de séquence qui dit si elle attend un ajout ou un
+ * retrait).
+ * Comme pour la Fifo, la file n'est pas responsable de la mémoire des
+ * éléments.
+ */
+typedef struct _File_concurrente File_concurrente;
+
+/*
+ * Crée une file vide pouvant contenir au moins 'capacite' éléments (la
+ * capacité est arrondie à la puissance de 2 supérieure).
+ */
+File_concurrente* creer_file_concurrente( size_t capacite );
+
+/*
+ * Libère la file. Aucun fil ne doit plus l'utiliser.
+ */
+void liberer_file_concurrente( File_concurrente* file );
+
+/*
+ * Ajoute un élément à la fin de la file. Renvoie 1 en cas de succès, et 0
+ * si la file est pleine.
+ */
+int ajouter_file_concurrente( File_concurrente* file, intptr_t element );
+
+/*
+ * Retire l'élément du début de la file et l'écrit dans 'element'. Renvoie 1
+ * en cas de succès, et 0 si la file est vide.
+ */
+int retirer_file_concurrente( File_concurrente* file, intptr_t* element );
+
+/*
+ * Renvoie le nombre approximatif d'éléments de la file : la valeur peut
+ * être dépassée dès qu'elle est renvoyée si d'autres fils utilisent la
+ * file.
+ */
+size_t taille_file_concurrente( File_concurrente* file );
+
+/*
+ * Définit le type d'une deque de vol de travail (algorithme de Chase et
+ * Lev). Un seul fil, son propriétaire, y empile et en dépile des éléments
+ * par le bas, comme une pile ; les autres fils volent les éléments les
+ * plus anciens par le haut. La deque grandit à la demande : les anciens
+ * tableaux sont gardés jusqu'à sa libération, car un voleur peut encore
+ * les lire.
+ */
+typedef struct _Deque_vol Deque_vol;
+
+/*
+ * Les résultats d'un vol.
+ */
+typedef enum {
+	VOL_REUSSI,
+	VOL_VIDE,
+	VOL_CONFLIT
+} Resultat_vol;
+
+Deque_vol* creer_deque_vol();
+
+/*
+ * Libère la deque. Aucun fil ne doit plus l'utiliser.
+ */
+void liberer_deque_vol( Deque_vol* deque );
+
+/*
+ * Empile un élément. Réservé au propriétaire.
+ */
+void empiler_deque_vol( Deque_vol* deque, intptr_t element );
+
+/*
+ * Dépile l'élément le plus récent. Réservé au propriétaire. Renvoie 1 en
+ * cas de succès, et 0 si la deque est vide (ou si son dernier élément
+ * vient d'être volé).
+ */
+int depiler_deque_vol( Deque_vol* deque, intptr_t* element );
+
+/*
+ * Vole l'élément le plus ancien. Peut être appelé par n'importe quel fil.
+ * Renvoie VOL_CONFLIT si un autre fil a pris l'élément au même moment : la
+ * deque n'est alors peut-être pas vide, et le vol peut être retenté.
+ */
+Resultat_vol voler_deque_vol( Deque_vol* deque, intptr_t* element );
+
+/*
+ * Renvoie le nombre approximatif d'éléments de la deque.
+ */
+size_t taille_deque_vol( Deque_vol* deque );
+
+#endif
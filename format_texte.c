@@ -0,0 +1,488 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "format_texte.h"
+#include "outils.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define TAILLE_TAMPON_SORTIE ( 1 << 16 )
+
+/* Nombre d'états ou de lettres par ligne de déclaration. */
+#define NB_PAR_LIGNE 16
+
+/*
+ * Les écritures passent par un tampon, vidé dans le flux quand il est plein :
+ * les entiers et les lettres sont formatés à la main plutôt que par un appel
+ * à fprintf() par élément.
+ */
+typedef struct {
+	FILE * flux;
+	size_t taille;
+	int erreur;
+	char donnees[TAILLE_TAMPON_SORTIE];
+} Sortie;
+
+static void vider_sortie( Sortie * s ){
+	if( s->taille > 0 && fwrite( s->donnees, s->taille, 1, s->flux ) != 1 ){
+		s->erreur = 1;
+	}
+	s->taille = 0;
+}
+
+static void ecrire_chaine( Sortie * s, const char * chaine ){
+	size_t longueur = strlen( chaine );
+	if( s->taille + longueur > TAILLE_TAMPON_SORTIE ) vider_sortie( s );
+	memcpy( s->donnees + s->taille, chaine, longueur );
+	s->taille += longueur;
+}
+
+static void ecrire_entier( Sortie * s, int entier ){
+	char chiffres[16];
+	unsigned int valeur = ( entier < 0 ) ? - (unsigned int) entier : entier;
+	int n = 0;
+	if( s->taille + sizeof(chiffres) > TAILLE_TAMPON_SORTIE ) vider_sortie( s );
+	do{
+		chiffres[n++] = '0' + valeur % 10;
+		valeur /= 10;
+	}while( valeur );
+	if( entier < 0 ) s->donnees[ s->taille++ ] = '-';
+	while( n > 0 ) s->donnees[ s->taille++ ] = chiffres[--n];
+}
+
+/* Écrit une lettre, telle quelle si c'est un caractère visible et sinon sous
+ * la forme \xHH. Dans une chaîne DOT, '"' doit aussi être échappée.
+ */
+static void ecrire_lettre( Sortie * s, char lettre, int dans_une_chaine ){
+	static const char hexadecimal[] = "0123456789abcdef";
+	unsigned char c = (unsigned char) lettre;
+	if( s->taille + 4 > TAILLE_TAMPON_SORTIE ) vider_sortie( s );
+	if( c > ' ' && c < 0x7F && c != '\\' && ! ( dans_une_chaine && c == '"' ) ){
+		s->donnees[ s->taille++ ] = c;
+		return;
+	}
+	// En DOT, '\' doit être doublé pour apparaître dans l'étiquette.
+	s->donnees[ s->taille++ ] = '\\';
+	if( dans_une_chaine ) s->donnees[ s->taille++ ] = '\\';
+	s->donnees[ s->taille++ ] = 'x';
+	s->donnees[ s->taille++ ] = hexadecimal[ c >> 4 ];
+	s->donnees[ s->taille++ ] = hexadecimal[ c & 15 ];
+}
+
+static void ecrire_declaration(
+	Sortie * s, const char * mot_cle, const Ensemble * ensemble, int lettres
+){
+	Ensemble_iterateur it;
+	int n = 0;
+	for( it = premier_iterateur_ensemble( ensemble );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		if( n % NB_PAR_LIGNE == 0 ){
+			if( n > 0 ) ecrire_chaine( s, "\n" );
+			ecrire_chaine( s, mot_cle );
+		}
+		ecrire_chaine( s, " " );
+		if( lettres ){
+			ecrire_lettre( s, (char) get_element( it ), 0 );
+		}else{
+			ecrire_entier( s, get_element( it ) );
+		}
+		n++;
+	}
+	if( n > 0 ) ecrire_chaine( s, "\n" );
+}
+
+static void action_ecrire_transition(
+	int origine, char lettre, int fin, void * data
+){
+	Sortie * s = (Sortie *) data;
+	ecrire_entier( s, origine );
+	ecrire_chaine( s, " " );
+	ecrire_lettre( s, lettre, 0 );
+	ecrire_chaine( s, " " );
+	ecrire_entier( s, fin );
+	ecrire_chaine( s, "\n" );
+}
+
+static Sortie * creer_sortie( FILE * flux ){
+	Sortie * res = xmalloc( sizeof(Sortie) );
+	res->flux = flux;
+	res->taille = 0;
+	res->erreur = 0;
+	return res;
+}
+
+/* Vide et libère la sortie, et renvoie 1 si toutes les écritures ont
+ * réussi.
+ */
+static int fermer_sortie( Sortie * s ){
+	int res;
+	vider_sortie( s );
+	res = ! s->erreur && fflush( s->flux ) == 0;
+	xfree( s );
+	return res;
+}
+
+int ecrire_automate( const Automate * automate, FILE * sortie ){
+	Sortie * s = creer_sortie( sortie );
+	ecrire_chaine( s, "automate " );
+	ecrire_entier( s, VERSION_FORMAT_TEXTE );
+	ecrire_chaine( s, "\n" );
+	ecrire_declaration( s, "lettres", get_alphabet( automate ), 1 );
+	ecrire_declaration( s, "etats", get_etats( automate ), 0 );
+	ecrire_declaration( s, "initiaux", get_initiaux( automate ), 0 );
+	ecrire_declaration( s, "finaux", get_finaux( automate ), 0 );
+	pour_toute_transition( automate, action_ecrire_transition, s );
+	return fermer_sortie( s );
+}
+
+static void action_ecrire_transition_dot(
+	int origine, char lettre, int fin, void * data
+){
+	Sortie * s = (Sortie *) data;
+	ecrire_chaine( s, "\t\"" );
+	ecrire_entier( s, origine );
+	ecrire_chaine( s, "\" -> \"" );
+	ecrire_entier( s, fin );
+	ecrire_chaine( s, "\" [label=\"" );
+	ecrire_lettre( s, lettre, 1 );
+	ecrire_chaine( s, "\"];\n" );
+}
+
+int ecrire_automate_dot( const Automate * automate, FILE * sortie ){
+	Sortie * s = creer_sortie( sortie );
+	Ensemble_iterateur it;
+
+	ecrire_chaine( s, "digraph automate {\n\trankdir=LR;\n" );
+	ecrire_chaine( s, "\tnode [shape=circle];\n" );
+	for( it = premier_iterateur_ensemble( get_etats( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		int etat = get_element( it );
+		ecrire_chaine( s, "\t\"" );
+		ecrire_entier( s, etat );
+		ecrire_chaine( s, "\"" );
+		if( est_un_etat_final_de_l_automate( automate, etat ) ){
+			ecrire_chaine( s, " [shape=doublecircle]" );
+		}
+		ecrire_chaine( s, ";\n" );
+		if( est_un_etat_initial_de_l_automate( automate, etat ) ){
+			ecrire_chaine( s, "\t\"initial " );
+			ecrire_entier( s, etat );
+			ecrire_chaine( s, "\" [shape=point];\n\t\"initial " );
+			ecrire_entier( s, etat );
+			ecrire_chaine( s, "\" -> \"" );
+			ecrire_entier( s, etat );
+			ecrire_chaine( s, "\";\n" );
+		}
+	}
+	pour_toute_transition( automate, action_ecrire_transition_dot, s );
+	ecrire_chaine( s, "}\n" );
+	return fermer_sortie( s );
+}
+
+/*
+ * Un tableau d'entiers qui grandit par doublement.
+ */
+typedef struct {
+	int * valeurs;
+	size_t nb;
+	size_t capacite;
+} Entiers;
+
+static void ajouter_entier( Entiers * t, int valeur ){
+	if( t->nb == t->capacite ){
+		t->capacite = t->capacite ? 2 * t->capacite : 64;
+		t->valeurs = xrealloc( t->valeurs, t->capacite * sizeof(int) );
+	}
+	t->valeurs[ t->nb++ ] = valeur;
+}
+
+typedef enum {
+	LIGNE_ETATS,
+	LIGNE_INITIAUX,
+	LIGNE_FINAUX,
+	LIGNE_LETTRES,
+	NB_DECLARATIONS
+} Declaration;
+
+static const char * mots_cles[NB_DECLARATIONS] = {
+	"etats", "initiaux", "finaux", "lettres"
+};
+
+/*
+ * L'état de la lecture : la position dans le texte, et ce qui a été lu.
+ * Les lettres sont rangées dans des entiers (de 0 à 255).
+ */
+typedef struct {
+	const char * courant;
+	const char * fin;
+	Entiers declarations[NB_DECLARATIONS];
+	Entiers origines;
+	Entiers fins;
+	char * lettres;
+	size_t capacite_lettres;
+} Lecture;
+
+static void passer_blancs( Lecture * l ){
+	while( l->courant < l->fin && ( *l->courant == ' ' || *l->courant == '\t' ) ){
+		l->courant++;
+	}
+}
+
+static int est_fin_de_mot( const Lecture * l ){
+	return l->courant == l->fin || *l->courant == ' ' || *l->courant == '\t'
+		|| *l->courant == '\n' || *l->courant == '\r';
+}
+
+static int valeur_hexadecimale( char c ){
+	if( c >= '0' && c <= '9' ) return c - '0';
+	if( c >= 'a' && c <= 'f' ) return c - 'a' + 10;
+	if( c >= 'A' && c <= 'F' ) return c - 'A' + 10;
+	return -1;
+}
+
+/* Lit un entier et renvoie 1, ou renvoie 0 si le mot n'est pas un entier. */
+static int lire_entier( Lecture * l, int * res ){
+	long long valeur = 0;
+	int negatif = 0, nb_chiffres = 0;
+	if( l->courant < l->fin && *l->courant == '-' ){
+		negatif = 1;
+		l->courant++;
+	}
+	while( l->courant < l->fin && *l->courant >= '0' && *l->courant <= '9' ){
+		valeur = 10 * valeur + ( *l->courant - '0' );
+		if( valeur > (long long) INT_MAX + 1 ) return 0;
+		l->courant++;
+		nb_chiffres++;
+	}
+	if( nb_chiffres == 0 || ! est_fin_de_mot( l ) ) return 0;
+	if( negatif ) valeur = - valeur;
+	if( valeur > INT_MAX ) return 0;
+	*res = (int) valeur;
+	return 1;
+}
+
+/* Lit une lettre et renvoie son code (de 0 à 255), ou -1 si le mot n'est
+ * pas une lettre.
+ */
+static int lire_lettre( Lecture * l ){
+	int res;
+	if( l->courant == l->fin ) return -1;
+	if( *l->courant != '\\' ){
+		res = (unsigned char) *l->courant++;
+		if( res <= ' ' || res >= 0x7F ) return -1;
+	}else{
+		int fort, faible;
+		if( l->fin - l->courant < 4 || l->courant[1] != 'x' ) return -1;
+		fort = valeur_hexadecimale( l->courant[2] );
+		faible = valeur_hexadecimale( l->courant[3] );
+		if( fort < 0 || faible < 0 ) return -1;
+		res = 16 * fort + faible;
+		l->courant += 4;
+	}
+	return est_fin_de_mot( l ) ? res : -1;
+}
+
+static void ajouter_lettre_lue( Lecture * l, int lettre ){
+	if( l->origines.nb == l->capacite_lettres ){
+		l->capacite_lettres = l->capacite_lettres ? 2 * l->capacite_lettres : 64;
+		l->lettres = xrealloc( l->lettres, l->capacite_lettres );
+	}
+	l->lettres[ l->origines.nb ] = (char) lettre;
+}
+
+/* Renvoie le numéro de la déclaration qui commence à la position courante,
+ * et avance après son mot-clé, ou renvoie -1.
+ */
+static int lire_mot_cle( Lecture * l ){
+	int d;
+	for( d = 0; d < NB_DECLARATIONS; d++ ){
+		size_t longueur = strlen( mots_cles[d] );
+		if( (size_t) ( l->fin - l->courant ) >= longueur
+			&& memcmp( l->courant, mots_cles[d], longueur ) == 0
+		){
+			const char * debut = l->courant;
+			l->courant += longueur;
+			if( est_fin_de_mot( l ) ) return d;
+			l->courant = debut;
+		}
+	}
+	return -1;
+}
+
+/* Lit une ligne utile (sans son '\n') et renvoie 1, ou 0 si elle est mal
+ * formée.
+ */
+static int lire_ligne( Lecture * l ){
+	int d = lire_mot_cle( l ), origine, lettre, fin;
+	if( d >= 0 ){
+		for( passer_blancs( l );
+			l->courant < l->fin && *l->courant != '\n' && *l->courant != '\r';
+			passer_blancs( l )
+		){
+			int valeur;
+			if( d == LIGNE_LETTRES ){
+				valeur = lire_lettre( l );
+				if( valeur < 0 ) return 0;
+			}else if( ! lire_entier( l, &valeur ) ){
+				return 0;
+			}
+			ajouter_entier( l->declarations + d, valeur );
+		}
+		return 1;
+	}
+	if( ! lire_entier( l, &origine ) ) return 0;
+	passer_blancs( l );
+	lettre = lire_lettre( l );
+	if( lettre < 0 ) return 0;
+	passer_blancs( l );
+	if( ! lire_entier( l, &fin ) ) return 0;
+	passer_blancs( l );
+	ajouter_lettre_lue( l, lettre );
+	ajouter_entier( &l->origines, origine );
+	ajouter_entier( &l->fins, fin );
+	return 1;
+}
+
+/* Passe la fin de la ligne courante. Renvoie 0 s'il reste des caractères
+ * avant la fin de ligne.
+ */
+static int finir_ligne( Lecture * l ){
+	passer_blancs( l );
+	if( l->courant < l->fin && *l->courant == '\r' ) l->courant++;
+	if( l->courant == l->fin ) return 1;
+	if( *l->courant != '\n' ) return 0;
+	l->courant++;
+	return 1;
+}
+
+static void passer_ligne( Lecture * l ){
+	const char * fin_ligne = memchr( l->courant, '\n', l->fin - l->courant );
+	l->courant = fin_ligne ? fin_ligne + 1 : l->fin;
+}
+
+static Automate * construire_automate_lu( Lecture * l ){
+	Automate * res = creer_automate();
+	size_t i;
+	ajouter_transitions_en_bloc(
+		res, l->origines.valeurs, l->lettres, l->fins.valeurs, l->origines.nb
+	);
+	for( i = 0; i < l->declarations[LIGNE_LETTRES].nb; i++ ){
+		ajouter_lettre( res, (char) l->declarations[LIGNE_LETTRES].valeurs[i] );
+	}
+	for( i = 0; i < l->declarations[LIGNE_ETATS].nb; i++ ){
+		ajouter_etat( res, l->declarations[LIGNE_ETATS].valeurs[i] );
+	}
+	for( i = 0; i < l->declarations[LIGNE_INITIAUX].nb; i++ ){
+		ajouter_etat_initial( res, l->declarations[LIGNE_INITIAUX].valeurs[i] );
+	}
+	for( i = 0; i < l->declarations[LIGNE_FINAUX].nb; i++ ){
+		ajouter_etat_final( res, l->declarations[LIGNE_FINAUX].valeurs[i] );
+	}
+	return res;
+}
+
+Automate * lire_automate(
+	const char * texte, size_t longueur, int * ligne_erreur
+){
+	Lecture l;
+	Automate * res = NULL;
+	int ligne = 0, entete_lu = 0, d;
+
+	memset( &l, 0, sizeof(Lecture) );
+	l.courant = texte;
+	l.fin = texte + longueur;
+	while( l.courant < l.fin ){
+		int valide;
+		ligne++;
+		passer_blancs( &l );
+		if( l.courant == l.fin ) break;
+		if( *l.courant == '#' ){
+			passer_ligne( &l );
+			continue;
+		}
+		if( *l.courant == '\n' || *l.courant == '\r' ){
+			valide = finir_ligne( &l );
+		}else if( ! entete_lu ){
+			int version;
+			valide = (size_t) ( l.fin - l.courant ) > 8
+				&& memcmp( l.courant, "automate", 8 ) == 0;
+			if( valide ){
+				l.courant += 8;
+				valide = est_fin_de_mot( &l );
+				passer_blancs( &l );
+				valide = valide && lire_entier( &l, &version )
+					&& version == VERSION_FORMAT_TEXTE && finir_ligne( &l );
+			}
+			entete_lu = 1;
+		}else{
+			valide = lire_ligne( &l ) && finir_ligne( &l );
+		}
+		if( ! valide ) break;
+	}
+
+	if( l.courant == l.fin && entete_lu ){
+		res = construire_automate_lu( &l );
+		ligne = 0;
+	}
+	if( ligne_erreur ) *ligne_erreur = ligne;
+
+	for( d = 0; d < NB_DECLARATIONS; d++ ) xfree( l.declarations[d].valeurs );
+	xfree( l.origines.valeurs );
+	xfree( l.fins.valeurs );
+	xfree( l.lettres );
+	return res;
+}
+
+Automate * lire_automate_fichier( const char * fichier, int * ligne_erreur ){
+	struct stat informations;
+	Automate * res;
+	void * texte;
+	int descripteur = open( fichier, O_RDONLY );
+
+	if( ligne_erreur ) *ligne_erreur = 0;
+	if( descripteur < 0 ) return NULL;
+	if( fstat( descripteur, &informations ) != 0 ){
+		close( descripteur );
+		return NULL;
+	}
+	if( informations.st_size == 0 ){
+		close( descripteur );
+		return lire_automate( "", 0, ligne_erreur );
+	}
+	texte = mmap(
+		NULL, informations.st_size, PROT_READ, MAP_PRIVATE, descripteur, 0
+	);
+	close( descripteur );
+	if( texte == MAP_FAILED ) return NULL;
+	madvise( texte, informations.st_size, MADV_SEQUENTIAL );
+	res = lire_automate( texte, informations.st_size, ligne_erreur );
+	munmap( texte, informations.st_size );
+	return res;
+}
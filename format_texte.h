@@ -0,0 +1,102 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __FORMAT_TEXTE_H__
+#define __FORMAT_TEXTE_H__
+
+#include <stddef.h>
+#include <stdio.h>
+
+#include "automate.h"
+
+/**
+ * \brief La version du format texte écrit par ecrire_automate().
+ */
+#define VERSION_FORMAT_TEXTE 1
+
+/**
+ * \brief Écrit un automate au format texte.
+ *
+ * Le format est orienté ligne. Les lignes vides et les lignes dont le premier
+ * caractère non blanc est '#' sont ignorées. Les mots d'une ligne sont
+ * séparés par des espaces ou des tabulations. La première ligne utile est
+ * "automate 1" (le numéro de version du format) ; les suivantes sont, dans
+ * n'importe quel ordre :
+ * - "etats e1 e2 ..." : des états de l'automate ;
+ * - "initiaux e1 e2 ..." : des états initiaux ;
+ * - "finaux e1 e2 ..." : des états finaux ;
+ * - "lettres l1 l2 ..." : des lettres de l'alphabet ;
+ * - "origine lettre fin" : une transition.
+ * Les états sont des entiers en base 10, éventuellement négatifs. Une lettre
+ * est un caractère ASCII visible autre que '\', ou bien '\xHH' où HH est le
+ * code hexadécimal de l'octet. Une même ligne de déclaration peut être
+ * répétée ; les états et les lettres des transitions n'ont pas besoin d'être
+ * déclarés.
+ *
+ * ecrire_automate() écrit les transitions triées par origine, lettre puis
+ * fin, ce qui permet à lire_automate() de les charger sans les trier.
+ *
+ * \param automate Un automate
+ * \param sortie Le flux où écrire
+ * \return 1 si l'écriture a réussi, 0 sinon
+ */
+int ecrire_automate( const Automate * automate, FILE * sortie );
+
+/**
+ * \brief Lit un automate écrit au format de ecrire_automate().
+ *
+ * Le texte est lu en une seule passe, sans recopie. Les transitions sont
+ * rangées dans des tableaux, puis ajoutées d'un coup avec
+ * ajouter_transitions_en_bloc().
+ *
+ * \param texte Le texte à lire (il n'a pas besoin de finir par '\0')
+ * \param longueur La longueur du texte
+ * \param ligne_erreur Si non NULL, reçoit le numéro (à partir de 1) de la
+ *        première ligne mal formée, ou 0
+ * \return L'automate, ou NULL si le texte est mal formé
+ */
+Automate * lire_automate(
+	const char * texte, size_t longueur, int * ligne_erreur
+);
+
+/**
+ * \brief Comme lire_automate(), en lisant le texte dans un fichier projeté
+ *        en mémoire.
+ *
+ * \return L'automate, ou NULL si le fichier ne peut pas être lu (et alors
+ *         *ligne_erreur vaut 0) ou s'il est mal formé
+ */
+Automate * lire_automate_fichier( const char * fichier, int * ligne_erreur );
+
+/**
+ * \brief Écrit un automate au format DOT de Graphviz.
+ *
+ * Les transitions sont écrites au fur et à mesure de leur parcours, sans
+ * structure intermédiaire. Les états finaux sont doublement cerclés, et
+ * chaque état initial est désigné par une flèche sans origine.
+ *
+ * \param automate Un automate
+ * \param sortie Le flux où écrire
+ * \return 1 si l'écriture a réussi, 0 sinon
+ */
+int ecrire_automate_dot( const Automate * automate, FILE * sortie );
+
+#endif
@@ -0,0 +1,423 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "generateur.h"
+#include "echantillonnage.h"
+#include "outils.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#define NB_ESSAIS_NON_RECONNUS 16
+
+void initialiser_parametres_generateur( Parametres_generateur * p ){
+	p->nb_etats = 100;
+	p->taille_alphabet = 2;
+	p->premiere_lettre = 'a';
+	p->loi_degre = LOI_CONSTANTE;
+	p->degre_moyen = 2;
+	p->densite_initiaux = 0;
+	p->densite_finaux = 0.1;
+	p->deterministe = 0;
+	p->graine = 1;
+}
+
+/* Un réel uniforme dans [0, 1[. */
+static double tirer_reel( Generateur_aleatoire * g ){
+	return ( tirer_aleatoire( g ) >> 11 ) * ( 1.0 / ( (uint64_t) 1 << 53 ) );
+}
+
+static int tirer_selon_loi(
+	Generateur_aleatoire * g, Loi_aleatoire loi, double moyenne
+){
+	int res;
+	switch( loi ){
+	case LOI_UNIFORME :
+		return tirer_aleatoire( g ) % ( (uint64_t) ( 2 * moyenne ) + 1 );
+	case LOI_GEOMETRIQUE :
+		// Succès avec probabilité 1 / ( moyenne + 1 ).
+		for( res = 0; tirer_reel( g ) * ( moyenne + 1 ) >= 1; res++ );
+		return res;
+	default :
+		res = (int) moyenne;
+		return res + ( tirer_reel( g ) < moyenne - res );
+	}
+}
+
+static int comparer_transitions_generees( const void * a, const void * b ){
+	uint64_t x = *(const uint64_t *) a, y = *(const uint64_t *) b;
+	return ( x > y ) - ( x < y );
+}
+
+/* Trie les transitions d'un état, codées par lettre << 32 | fin, et retire
+ * les doublons. Renvoie le nombre de transitions restantes.
+ */
+static int trier_transitions_generees( uint64_t * t, int nb ){
+	int i, j, res = 0;
+	if( nb > 16 ){
+		qsort( t, nb, sizeof(uint64_t), comparer_transitions_generees );
+	}else{
+		for( i = 1; i < nb; i++ ){
+			uint64_t x = t[i];
+			for( j = i; j > 0 && t[j-1] > x; j-- ) t[j] = t[j-1];
+			t[j] = x;
+		}
+	}
+	for( i = 0; i < nb; i++ ){
+		if( res == 0 || t[i] != t[res-1] ) t[res++] = t[i];
+	}
+	return res;
+}
+
+Index_automate * generer_index_aleatoire( const Parametres_generateur * p ){
+	Index_automate * res = xmalloc( sizeof(Index_automate) );
+	Generateur_aleatoire g;
+	size_t nb_mots = NB_MOTS_BITS( p->nb_etats ) + 1;
+	size_t capacite = (size_t) p->nb_etats * ( p->degre_moyen + 1 ) + 16;
+	int capacite_etat = 16, permutation[256];
+	uint64_t * transitions = xmalloc( capacite_etat * sizeof(uint64_t) );
+	int i, k, c, m = 0;
+
+	if( p->nb_etats < 1 || p->taille_alphabet < 1
+		|| (unsigned char) p->premiere_lettre + p->taille_alphabet > 256
+	){
+		ERREUR( "Parametres de generation invalides" );
+	}
+	initialiser_generateur_aleatoire( &g, p->graine );
+	res->nb_etats = p->nb_etats;
+	res->taille_alphabet = p->taille_alphabet;
+	res->noms = xmalloc( ( p->nb_etats + 1 ) * sizeof(int) );
+	res->debut = xmalloc( ( p->nb_etats + 1 ) * sizeof(int) );
+	res->lettres = xmalloc( capacite );
+	res->fins = xmalloc( capacite * sizeof(int) );
+	res->alphabet = xmalloc( p->taille_alphabet + 1 );
+	res->initiaux = xmalloc( nb_mots * sizeof(uint64_t) );
+	res->finaux = xmalloc( nb_mots * sizeof(uint64_t) );
+	memset( res->initiaux, 0, nb_mots * sizeof(uint64_t) );
+	memset( res->finaux, 0, nb_mots * sizeof(uint64_t) );
+	for( c = 0; c < p->taille_alphabet; c++ ){
+		res->alphabet[c] = (char) ( (unsigned char) p->premiere_lettre + c );
+		permutation[c] = c;
+	}
+
+	MARQUER_BIT( res->initiaux, 0 );
+	for( i = 0; i < p->nb_etats; i++ ){
+		int degre = tirer_selon_loi( &g, p->loi_degre, p->degre_moyen );
+		res->noms[i] = i;
+		res->debut[i] = m;
+		if( ! p->deterministe && tirer_reel( &g ) < p->densite_initiaux ){
+			MARQUER_BIT( res->initiaux, i );
+		}
+		if( tirer_reel( &g ) < p->densite_finaux ) MARQUER_BIT( res->finaux, i );
+
+		if( p->deterministe && degre > p->taille_alphabet ){
+			degre = p->taille_alphabet;
+		}
+		if( degre > capacite_etat ){
+			capacite_etat = degre;
+			transitions = xrealloc( transitions, capacite_etat * sizeof(uint64_t) );
+		}
+		for( k = 0; k < degre; k++ ){
+			if( p->deterministe ){
+				// Tirage sans remise des lettres (Fisher-Yates partiel).
+				int j = k + tirer_aleatoire( &g ) % ( p->taille_alphabet - k );
+				c = permutation[j];
+				permutation[j] = permutation[k];
+				permutation[k] = c;
+			}else{
+				c = tirer_aleatoire( &g ) % p->taille_alphabet;
+			}
+			transitions[k] = (uint64_t) c << 32
+				| (uint32_t) ( tirer_aleatoire( &g ) % p->nb_etats );
+		}
+		degre = trier_transitions_generees( transitions, degre );
+
+		if( (size_t) m + degre > capacite ){
+			capacite = 2 * capacite + degre;
+			res->lettres = xrealloc( res->lettres, capacite );
+			res->fins = xrealloc( res->fins, capacite * sizeof(int) );
+		}
+		for( k = 0; k < degre; k++ ){
+			res->lettres[m] = res->alphabet[ transitions[k] >> 32 ];
+			res->fins[m] = (int) ( transitions[k] & 0xFFFFFFFF );
+			m++;
+		}
+	}
+	res->debut[ p->nb_etats ] = m;
+	res->nb_transitions = m;
+	xfree( transitions );
+	return res;
+}
+
+Automate * generer_automate_aleatoire( const Parametres_generateur * p ){
+	Index_automate * index = generer_index_aleatoire( p );
+	Automate * res = creer_automate();
+	int * origines = xmalloc( ( index->nb_transitions + 1 ) * sizeof(int) );
+	int i, t;
+
+	for( i = 0; i < index->nb_etats; i++ ){
+		for( t = index->debut[i]; t < index->debut[i+1]; t++ ) origines[t] = i;
+	}
+	ajouter_transitions_en_bloc(
+		res, origines, index->lettres, index->fins, index->nb_transitions
+	);
+	for( i = 0; i < index->taille_alphabet; i++ ){
+		ajouter_lettre( res, index->alphabet[i] );
+	}
+	for( i = 0; i < index->nb_etats; i++ ){
+		ajouter_etat( res, i );
+		if( TESTER_BIT( index->initiaux, i ) ) ajouter_etat_initial( res, i );
+		if( TESTER_BIT( index->finaux, i ) ) ajouter_etat_final( res, i );
+	}
+	xfree( origines );
+	liberer_index_automate( index );
+	return res;
+}
+
+/*
+ * Pour construire des mots reconnus, on calcule pour chaque état la
+ * longueur d'un plus court chemin vers un état final, ainsi que la première
+ * transition d'un tel chemin (par un parcours en largeur de l'automate
+ * miroir). La simulation de l'automate utilise des listes d'états, avec un
+ * ensemble de bits pour retirer les doublons, de sorte que son coût ne
+ * dépend que des états effectivement atteints.
+ */
+typedef struct {
+	const Index_automate * index;
+	int * distance;
+	int * vers_final;
+	int * initiaux_utiles;
+	int nb_initiaux_utiles;
+	int * courants;
+	int * suivants;
+	uint64_t * marques;
+} Guide;
+
+static void initialiser_guide( Guide * guide, const Index_automate * index ){
+	Index_automate * miroir = creer_index_miroir( index );
+	int n = index->nb_etats, debut_file = 0, fin_file = 0, i, t;
+	int * file = xmalloc( ( n + 1 ) * sizeof(int) );
+	size_t nb_mots = NB_MOTS_BITS( n ) + 1;
+
+	guide->index = index;
+	guide->distance = xmalloc( ( n + 1 ) * sizeof(int) );
+	guide->vers_final = xmalloc( ( n + 1 ) * sizeof(int) );
+	guide->initiaux_utiles = xmalloc( ( n + 1 ) * sizeof(int) );
+	guide->nb_initiaux_utiles = 0;
+	guide->courants = xmalloc( ( n + 1 ) * sizeof(int) );
+	guide->suivants = xmalloc( ( n + 1 ) * sizeof(int) );
+	guide->marques = xmalloc( nb_mots * sizeof(uint64_t) );
+	memset( guide->marques, 0, nb_mots * sizeof(uint64_t) );
+	for( i = 0; i < n; i++ ){
+		guide->distance[i] = -1;
+		if( TESTER_BIT( index->finaux, i ) ){
+			guide->distance[i] = 0;
+			file[ fin_file++ ] = i;
+		}
+	}
+	while( debut_file < fin_file ){
+		int v = file[ debut_file++ ];
+		for( t = miroir->debut[v]; t < miroir->debut[v+1]; t++ ){
+			int u = miroir->fins[t];
+			if( guide->distance[u] < 0 ){
+				guide->distance[u] = guide->distance[v] + 1;
+				file[ fin_file++ ] = u;
+			}
+		}
+	}
+	for( i = 0; i < n; i++ ){
+		// La transition vers un état plus proche d'un état final
+		guide->vers_final[i] = -1;
+		for( t = index->debut[i]; t < index->debut[i+1] && guide->distance[i] > 0; t++ ){
+			if( guide->distance[ index->fins[t] ] == guide->distance[i] - 1 ){
+				guide->vers_final[i] = t;
+				break;
+			}
+		}
+		if( TESTER_BIT( index->initiaux, i ) && guide->distance[i] >= 0 ){
+			guide->initiaux_utiles[ guide->nb_initiaux_utiles++ ] = i;
+		}
+	}
+	xfree( file );
+	liberer_index_automate( miroir );
+}
+
+static void liberer_guide( Guide * guide ){
+	xfree( guide->distance );
+	xfree( guide->vers_final );
+	xfree( guide->initiaux_utiles );
+	xfree( guide->courants );
+	xfree( guide->suivants );
+	xfree( guide->marques );
+}
+
+/* Renvoie 1 si le mot est reconnu. Seuls les états qui peuvent encore mener
+ * à un état final sont conservés.
+ */
+static int reconnait_index( Guide * guide, const char * mot, int longueur ){
+	const Index_automate * index = guide->index;
+	int nb_courants = guide->nb_initiaux_utiles, nb_suivants, i, k, t;
+	int * echange;
+
+	memcpy( guide->courants, guide->initiaux_utiles, nb_courants * sizeof(int) );
+	for( i = 0; i < longueur && nb_courants > 0; i++ ){
+		nb_suivants = 0;
+		for( k = 0; k < nb_courants; k++ ){
+			int e = guide->courants[k];
+			for( t = index->debut[e]; t < index->debut[e+1]; t++ ){
+				int f = index->fins[t];
+				if( index->lettres[t] == mot[i] && guide->distance[f] >= 0
+					&& ! TESTER_BIT( guide->marques, f )
+				){
+					MARQUER_BIT( guide->marques, f );
+					guide->suivants[ nb_suivants++ ] = f;
+				}
+			}
+		}
+		for( k = 0; k < nb_suivants; k++ ){
+			guide->marques[ guide->suivants[k] / 64 ] = 0;
+		}
+		echange = guide->courants;
+		guide->courants = guide->suivants;
+		guide->suivants = echange;
+		nb_courants = nb_suivants;
+	}
+	for( k = 0; k < nb_courants; k++ ){
+		if( guide->distance[ guide->courants[k] ] == 0 ) return 1;
+	}
+	return 0;
+}
+
+/*
+ * Un tampon de caractères qui grandit par doublement. Les mots y sont
+ * rangés les uns à la suite des autres, chacun suivi de '\0'.
+ */
+typedef struct {
+	char * donnees;
+	size_t taille;
+	size_t capacite;
+} Tampon;
+
+static void ajouter_caractere( Tampon * tampon, char c ){
+	if( tampon->taille == tampon->capacite ){
+		tampon->capacite = 2 * tampon->capacite + 64;
+		tampon->donnees = xrealloc( tampon->donnees, tampon->capacite );
+	}
+	tampon->donnees[ tampon->taille++ ] = c;
+}
+
+/* Écrit un mot reconnu : une marche aléatoire parmi les états depuis
+ * lesquels un état final est accessible, puis un plus court chemin vers un
+ * état final. Renvoie 0 si aucun état initial ne mène à un état final.
+ */
+static int ecrire_mot_reconnu(
+	Guide * guide, Generateur_aleatoire * g, int longueur, Tampon * tampon
+){
+	const Index_automate * index = guide->index;
+	int nb_candidats, e, i, t;
+
+	if( guide->nb_initiaux_utiles == 0 ) return 0;
+	e = guide->initiaux_utiles[
+		tirer_aleatoire( g ) % guide->nb_initiaux_utiles
+	];
+	for( i = 0; i < longueur; i++ ){
+		int choisie = -1;
+		nb_candidats = 0;
+		for( t = index->debut[e]; t < index->debut[e+1]; t++ ){
+			if( guide->distance[ index->fins[t] ] >= 0 ){
+				nb_candidats++;
+				if( tirer_aleatoire( g ) % nb_candidats == 0 ) choisie = t;
+			}
+		}
+		if( choisie < 0 ) break;
+		ajouter_caractere( tampon, index->lettres[choisie] );
+		e = index->fins[choisie];
+	}
+	while( guide->distance[e] > 0 ){
+		t = guide->vers_final[e];
+		ajouter_caractere( tampon, index->lettres[t] );
+		e = index->fins[t];
+	}
+	return 1;
+}
+
+Charge_mots * generer_charge_mots(
+	const Index_automate * index, const Parametres_mots * p
+){
+	Charge_mots * res = xmalloc( sizeof(Charge_mots) );
+	size_t * positions = xmalloc( ( p->nb_mots + 1 ) * sizeof(size_t) );
+	Generateur_aleatoire g;
+	Tampon tampon;
+	Guide guide;
+	int i, k, essai;
+
+	initialiser_generateur_aleatoire( &g, p->graine );
+	initialiser_guide( &guide, index );
+	tampon.donnees = NULL;
+	tampon.taille = 0;
+	tampon.capacite = 0;
+	res->nb_mots = p->nb_mots;
+	res->reconnus = xmalloc( ( p->nb_mots + 1 ) * sizeof(int) );
+
+	for( i = 0; i < p->nb_mots; i++ ){
+		int longueur = tirer_selon_loi( &g, p->loi_longueur, p->longueur_moyenne );
+		// Sans lettre, le seul mot possible est le mot vide.
+		if( index->taille_alphabet == 0 ) longueur = 0;
+		positions[i] = tampon.taille;
+		if( tirer_reel( &g ) < p->proportion_reconnus
+			&& ecrire_mot_reconnu( &guide, &g, longueur, &tampon )
+		){
+			res->reconnus[i] = 1;
+		}else{
+			for( essai = 0; essai < NB_ESSAIS_NON_RECONNUS; essai++ ){
+				tampon.taille = positions[i];
+				for( k = 0; k < longueur; k++ ){
+					ajouter_caractere( &tampon, index->alphabet[
+						tirer_aleatoire( &g ) % index->taille_alphabet
+					] );
+				}
+				res->reconnus[i] = reconnait_index(
+					&guide, tampon.donnees + positions[i], longueur
+				);
+				if( ! res->reconnus[i] ) break;
+			}
+		}
+		ajouter_caractere( &tampon, '\0' );
+	}
+
+	// Le tampon ne bouge plus : on peut calculer les adresses des mots.
+	res->texte = tampon.donnees;
+	res->mots = xmalloc( ( p->nb_mots + 1 ) * sizeof(char *) );
+	for( i = 0; i < p->nb_mots; i++ ) res->mots[i] = res->texte + positions[i];
+
+	xfree( positions );
+	liberer_guide( &guide );
+	return res;
+}
+
+void liberer_charge_mots( Charge_mots * charge ){
+	if( charge ){
+		xfree( charge->mots );
+		xfree( charge->reconnus );
+		xfree( charge->texte );
+		xfree( charge );
+	}
+}
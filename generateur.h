@@ -0,0 +1,149 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __GENERATEUR_H__
+#define __GENERATEUR_H__
+
+#include <stdint.h>
+
+#include "automate.h"
+#include "index_automate.h"
+
+/**
+ * \brief Les lois utilisées pour tirer les degrés sortants des états et les
+ *        longueurs des mots, toutes données par leur moyenne.
+ *
+ * - LOI_CONSTANTE : la partie entière de la moyenne, plus 1 avec une
+ *   probabilité égale à sa partie fractionnaire ;
+ * - LOI_UNIFORME : uniforme entre 0 et le double de la moyenne ;
+ * - LOI_GEOMETRIQUE : le nombre d'échecs avant un succès, dont la queue est
+ *   plus longue (quelques états de fort degré, beaucoup de mots courts).
+ */
+typedef enum {
+	LOI_CONSTANTE,
+	LOI_UNIFORME,
+	LOI_GEOMETRIQUE
+} Loi_aleatoire;
+
+/**
+ * \brief Les paramètres d'un automate aléatoire.
+ *
+ * Les états sont numérotés de 0 à nb_etats-1. Les lettres sont les
+ * 'taille_alphabet' octets qui suivent 'premiere_lettre' (inclus). Chaque
+ * état est initial avec la probabilité 'densite_initiaux' et final avec la
+ * probabilité 'densite_finaux' ; l'état 0 est toujours initial.
+ *
+ * Les transitions sortant d'un état sont tirées uniformément (lettre et état
+ * d'arrivée), les doublons étant retirés. Si 'deterministe' est non nul,
+ * l'état 0 est le seul état initial, et les lettres des transitions d'un
+ * même état sont distinctes : le degré est alors au plus taille_alphabet.
+ */
+typedef struct {
+	int nb_etats;
+	int taille_alphabet;
+	char premiere_lettre;
+	Loi_aleatoire loi_degre;
+	double degre_moyen;
+	double densite_initiaux;
+	double densite_finaux;
+	int deterministe;
+	uint64_t graine;
+} Parametres_generateur;
+
+/**
+ * \brief Remplit des paramètres par défaut : 100 états, les lettres 'a' et
+ *        'b', un degré constant de 2, un état initial et 10% d'états
+ *        finaux, non déterministe, graine 1.
+ */
+void initialiser_parametres_generateur( Parametres_generateur * parametres );
+
+/**
+ * \brief Génère directement l'index d'un automate aléatoire.
+ *
+ * La génération ne passe pas par un Automate : elle est linéaire en le
+ * nombre de transitions et convient jusqu'à des dizaines de millions de
+ * transitions. Pour des paramètres identiques (graine comprise), le résultat
+ * est toujours le même.
+ *
+ * \param parametres Les paramètres de l'automate
+ * \return L'index, à libérer avec liberer_index_automate()
+ */
+Index_automate * generer_index_aleatoire( const Parametres_generateur * parametres );
+
+/**
+ * \brief Génère un automate aléatoire.
+ *
+ * L'automate est celui de generer_index_aleatoire(), construit avec
+ * ajouter_transitions_en_bloc().
+ *
+ * \param parametres Les paramètres de l'automate
+ * \return L'automate
+ */
+Automate * generer_automate_aleatoire( const Parametres_generateur * parametres );
+
+/**
+ * \brief Les paramètres d'une charge de mots à faire reconnaître par un
+ *        automate.
+ *
+ * Une proportion 'proportion_reconnus' des mots est construite le long d'un
+ * chemin de l'automate, de longueur tirée selon 'loi_longueur', prolongé par
+ * un plus court chemin vers un état final : ces mots sont reconnus. Les
+ * autres sont des mots uniformes sur l'alphabet, retirés (quelques fois au
+ * plus) tant qu'ils sont reconnus.
+ */
+typedef struct {
+	int nb_mots;
+	double proportion_reconnus;
+	Loi_aleatoire loi_longueur;
+	double longueur_moyenne;
+	uint64_t graine;
+} Parametres_mots;
+
+/**
+ * \brief Une charge de mots. 'reconnus[i]' vaut 1 si mots[i] est reconnu par
+ *        l'automate, et 0 sinon : c'est la réponse attendue, calculée lors
+ *        de la génération.
+ */
+typedef struct {
+	int nb_mots;
+	char ** mots;
+	int * reconnus;
+	char * texte;
+} Charge_mots;
+
+/**
+ * \brief Génère une charge de mots pour un automate indexé.
+ *
+ * Les lettres des mots sont celles de l'alphabet de l'automate (qui ne doit
+ * pas contenir '\0'). Si l'automate ne reconnaît aucun mot, tous les mots
+ * sont non reconnus. Si son alphabet est vide, tous les mots sont vides.
+ *
+ * \param index Un automate indexé
+ * \param parametres Les paramètres de la charge
+ * \return La charge, à libérer avec liberer_charge_mots()
+ */
+Charge_mots * generer_charge_mots(
+	const Index_automate * index, const Parametres_mots * parametres
+);
+
+void liberer_charge_mots( Charge_mots * charge );
+
+#endif
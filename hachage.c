@@ -0,0 +1,159 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hachage.h"
+#include "outils.h"
+
+#include <string.h>
+
+typedef struct {
+	uint64_t cle;
+	intptr_t valeur;
+} Association_hachage;
+
+/*
+ * Le tableau contient toujours une puissance de deux de cases, et au plus
+ * la moitié des cases sont occupées. Les collisions sont résolues par
+ * sondage linéaire.
+ */
+struct _Table_hachage {
+	Association_hachage * cases;
+	unsigned char * occupees;
+	size_t masque;
+	size_t taille;
+};
+
+uint64_t hacher_64( uint64_t x ){
+	x ^= x >> 30;
+	x *= 0xbf58476d1ce4e5b9ULL;
+	x ^= x >> 27;
+	x *= 0x94d049bb133111ebULL;
+	x ^= x >> 31;
+	return x;
+}
+
+static void allouer_cases( Table_hachage * table, size_t nb_cases ){
+	table->cases = xmalloc( nb_cases * sizeof(Association_hachage) );
+	table->occupees = xmalloc( nb_cases );
+	memset( table->occupees, 0, nb_cases );
+	table->masque = nb_cases - 1;
+	table->taille = 0;
+}
+
+Table_hachage * creer_table_hachage( size_t capacite ){
+	Table_hachage * res = xmalloc( sizeof(Table_hachage) );
+	size_t nb_cases = 16;
+	while( nb_cases < 2 * capacite ) nb_cases *= 2;
+	allouer_cases( res, nb_cases );
+	return res;
+}
+
+void liberer_table_hachage( Table_hachage * table ){
+	if( table ){
+		xfree( table->cases );
+		xfree( table->occupees );
+		xfree( table );
+	}
+}
+
+void vider_table_hachage( Table_hachage * table ){
+	memset( table->occupees, 0, table->masque + 1 );
+	table->taille = 0;
+}
+
+size_t taille_table_hachage( const Table_hachage * table ){
+	return table->taille;
+}
+
+/* Renvoie l'indice de la case contenant la clé, ou celui de la case vide
+ * où la clé devrait être rangée.
+ */
+static size_t chercher_case( const Table_hachage * table, uint64_t cle ){
+	size_t i = hacher_64( cle ) & table->masque;
+	while( table->occupees[i] && table->cases[i].cle != cle ){
+		i = ( i + 1 ) & table->masque;
+	}
+	return i;
+}
+
+static void agrandir( Table_hachage * table ){
+	Association_hachage * anciennes = table->cases;
+	unsigned char * occupees = table->occupees;
+	size_t nb_cases = table->masque + 1;
+	size_t i;
+
+	allouer_cases( table, 2 * nb_cases );
+	for( i = 0; i < nb_cases; i++ ){
+		if( occupees[i] ){
+			size_t j = chercher_case( table, anciennes[i].cle );
+			table->cases[j] = anciennes[i];
+			table->occupees[j] = 1;
+			table->taille++;
+		}
+	}
+	xfree( anciennes );
+	xfree( occupees );
+}
+
+int trouver_table_hachage(
+	const Table_hachage * table, uint64_t cle, intptr_t * valeur
+){
+	size_t i = chercher_case( table, cle );
+	if( ! table->occupees[i] ) return 0;
+	if( valeur ) *valeur = table->cases[i].valeur;
+	return 1;
+}
+
+intptr_t * sonder_table_hachage(
+	Table_hachage * table, uint64_t cle, int * nouveau
+){
+	size_t i = chercher_case( table, cle );
+	if( table->occupees[i] ){
+		if( nouveau ) *nouveau = 0;
+		return &( table->cases[i].valeur );
+	}
+	if( 2 * ( table->taille + 1 ) > table->masque + 1 ){
+		agrandir( table );
+		i = chercher_case( table, cle );
+	}
+	table->occupees[i] = 1;
+	table->cases[i].cle = cle;
+	table->cases[i].valeur = 0;
+	table->taille++;
+	if( nouveau ) *nouveau = 1;
+	return &( table->cases[i].valeur );
+}
+
+void ajouter_table_hachage( Table_hachage * table, uint64_t cle, intptr_t valeur ){
+	*sonder_table_hachage( table, cle, NULL ) = valeur;
+}
+
+void pour_toute_cle_valeur_table_hachage(
+	const Table_hachage * table,
+	void (* action )( uint64_t cle, intptr_t valeur, void* data ),
+	void* data
+){
+	size_t i;
+	for( i = 0; i <= table->masque; i++ ){
+		if( table->occupees[i] ){
+			action( table->cases[i].cle, table->cases[i].valeur, data );
+		}
+	}
+}
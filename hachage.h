@@ -0,0 +1,113 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __HACHAGE_H__
+#define __HACHAGE_H__
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Définit le type d'une table de hachage qui associe à une clé entière de 64
+ * bits une valeur de type intptr_t.
+ *
+ * Contrairement à la Table (qui repose sur un arbre AVL et sur des fonctions
+ * de comparaison), la table de hachage utilise un adressage ouvert : les
+ * associations sont rangées dans un unique tableau et aucune allocation n'est
+ * faite lors d'un ajout, sauf quand le tableau doit être agrandi.
+ *
+ * La table n'est pas responsable de la mémoire des valeurs.
+ */
+typedef struct _Table_hachage Table_hachage;
+
+/*
+ * Code un couple d'entiers (p,q) dans une clé de 64 bits, et inversement.
+ */
+#define CLE_PAIRE(p,q) \
+	( ( ((uint64_t) (uint32_t) (p)) << 32 ) | (uint64_t) (uint32_t) (q) )
+#define PREMIER_PAIRE(cle) ( (int) (int32_t) ( (uint64_t) (cle) >> 32 ) )
+#define SECOND_PAIRE(cle) ( (int) (int32_t) ( (cle) & 0xFFFFFFFFu ) )
+
+/*
+ * Renvoie une nouvelle table de hachage vide, prévue pour contenir
+ * 'capacite' associations sans être agrandie. 'capacite' peut valoir 0.
+ */
+Table_hachage * creer_table_hachage( size_t capacite );
+
+/*
+ * Libère la mémoire de la table. Les valeurs ne sont pas libérées.
+ */
+void liberer_table_hachage( Table_hachage * table );
+
+/*
+ * Retire toutes les associations de la table, sans libérer son tableau.
+ */
+void vider_table_hachage( Table_hachage * table );
+
+/*
+ * Renvoie le nombre d'associations de la table.
+ */
+size_t taille_table_hachage( const Table_hachage * table );
+
+/*
+ * Renvoie 1 si la clé est dans la table et 0 sinon.
+ * Si la clé est trouvée et que 'valeur' n'est pas NULL, la valeur associée à
+ * la clé est écrite dans '*valeur'.
+ */
+int trouver_table_hachage(
+	const Table_hachage * table, uint64_t cle, intptr_t * valeur
+);
+
+/*
+ * Associe 'valeur' à 'cle'. Si la clé existe déjà, l'ancienne valeur est
+ * remplacée.
+ */
+void ajouter_table_hachage( Table_hachage * table, uint64_t cle, intptr_t valeur );
+
+/*
+ * Cherche la clé dans la table, et l'ajoute si elle n'y est pas (la valeur
+ * associée vaut alors 0).
+ * Renvoie l'adresse de la valeur associée à la clé, et écrit dans '*nouveau'
+ * 1 si la clé vient d'être ajoutée et 0 sinon.
+ *
+ * L'adresse renvoyée n'est valide que jusqu'au prochain ajout dans la table.
+ */
+intptr_t * sonder_table_hachage(
+	Table_hachage * table, uint64_t cle, int * nouveau
+);
+
+/*
+ * Passe en revue toutes les associations de la table (dans un ordre
+ * quelconque) et exécute la fonction passée en paramètre.
+ */
+void pour_toute_cle_valeur_table_hachage(
+	const Table_hachage * table,
+	void (* action )( uint64_t cle, intptr_t valeur, void* data ),
+	void* data
+);
+
+/*
+ * Fonction de mélange des bits d'une clé de 64 bits (finaliseur de
+ * splitmix64). Elle peut être utilisée pour hacher d'autres structures.
+ */
+uint64_t hacher_64( uint64_t x );
+
+#endif
@@ -0,0 +1,214 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "index_automate.h"
+#include "outils.h"
+
+#include <string.h>
+
+int indice_etat( const Index_automate * index, int etat ){
+	int bas = 0, haut = index->nb_etats - 1;
+	while( bas <= haut ){
+		int milieu = bas + ( haut - bas ) / 2;
+		if( index->noms[milieu] == etat ) return milieu;
+		if( index->noms[milieu] < etat ){
+			bas = milieu + 1;
+		}else{
+			haut = milieu - 1;
+		}
+	}
+	return -1;
+}
+
+int transition_index( const Index_automate * index, int origine, char lettre ){
+	int t;
+	for( t = index->debut[origine]; t < index->debut[origine+1]; t++ ){
+		if( index->lettres[t] == lettre ) return index->fins[t];
+		if( (unsigned char) index->lettres[t] > (unsigned char) lettre ) break;
+	}
+	return -1;
+}
+
+int index_est_deterministe( const Index_automate * index ){
+	int i, t, nb_initiaux = 0;
+	for( i = 0; i < index->nb_etats; i++ ){
+		nb_initiaux += TESTER_BIT( index->initiaux, i );
+		for( t = index->debut[i] + 1; t < index->debut[i+1]; t++ ){
+			if( index->lettres[t] == index->lettres[t-1] ) return 0;
+		}
+	}
+	return nb_initiaux <= 1;
+}
+
+typedef struct {
+	Index_automate * index;
+	int position;
+} Donnees_index;
+
+static void action_compter_transition( int origine, char lettre, int fin, void* data ){
+	Index_automate * index = ( (Donnees_index*) data )->index;
+	index->debut[ indice_etat( index, origine ) + 1 ] += 1;
+}
+
+/* pour_toute_transition() parcourt les transitions dans l'ordre des couples
+ * (origine, lettre), puis des états d'arrivée : on peut donc les ranger les
+ * unes à la suite des autres.
+ */
+static void action_ranger_transition( int origine, char lettre, int fin, void* data ){
+	Donnees_index * d = (Donnees_index*) data;
+	d->index->lettres[ d->position ] = lettre;
+	d->index->fins[ d->position ] = indice_etat( d->index, fin );
+	d->position++;
+}
+
+Index_automate * creer_index_automate( const Automate * automate ){
+	Index_automate * res = xmalloc( sizeof(Index_automate) );
+	Ensemble_iterateur it;
+	Donnees_index d;
+	int i;
+
+	res->nb_etats = taille_ensemble( get_etats( automate ) );
+	res->noms = xmalloc( ( res->nb_etats + 1 ) * sizeof(int) );
+	i = 0;
+	for( it = premier_iterateur_ensemble( get_etats( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		res->noms[i++] = get_element( it );
+	}
+
+	res->taille_alphabet = taille_ensemble( get_alphabet( automate ) );
+	res->alphabet = xmalloc( res->taille_alphabet + 1 );
+	i = 0;
+	for( it = premier_iterateur_ensemble( get_alphabet( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		res->alphabet[i++] = (char) get_element( it );
+	}
+
+	d.index = res;
+	d.position = 0;
+	res->debut = xmalloc( ( res->nb_etats + 1 ) * sizeof(int) );
+	memset( res->debut, 0, ( res->nb_etats + 1 ) * sizeof(int) );
+	pour_toute_transition( automate, action_compter_transition, &d );
+	for( i = 0; i < res->nb_etats; i++ ){
+		res->debut[i+1] += res->debut[i];
+	}
+	res->nb_transitions = res->debut[ res->nb_etats ];
+	res->lettres = xmalloc( res->nb_transitions + 1 );
+	res->fins = xmalloc( ( res->nb_transitions + 1 ) * sizeof(int) );
+	pour_toute_transition( automate, action_ranger_transition, &d );
+
+	res->initiaux = xmalloc( ( NB_MOTS_BITS( res->nb_etats ) + 1 ) * sizeof(uint64_t) );
+	res->finaux = xmalloc( ( NB_MOTS_BITS( res->nb_etats ) + 1 ) * sizeof(uint64_t) );
+	memset( res->initiaux, 0, ( NB_MOTS_BITS( res->nb_etats ) + 1 ) * sizeof(uint64_t) );
+	memset( res->finaux, 0, ( NB_MOTS_BITS( res->nb_etats ) + 1 ) * sizeof(uint64_t) );
+	for( it = premier_iterateur_ensemble( get_initiaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		MARQUER_BIT( res->initiaux, indice_etat( res, get_element( it ) ) );
+	}
+	for( it = premier_iterateur_ensemble( get_finaux( automate ) );
+		! iterateur_ensemble_est_vide( it );
+		it = iterateur_suivant_ensemble( it )
+	){
+		MARQUER_BIT( res->finaux, indice_etat( res, get_element( it ) ) );
+	}
+	return res;
+}
+
+/* Les transitions renversées sont triées par origine, puis par lettre, puis
+ * par état d'arrivée : on fait un premier tri stable par lettre, puis un
+ * second par nouvelle origine. Comme les transitions de départ sont rangées
+ * par ancienne origine (la nouvelle arrivée), l'ordre obtenu est le bon.
+ */
+Index_automate * creer_index_miroir( const Index_automate * index ){
+	Index_automate * res = xmalloc( sizeof(Index_automate) );
+	int n = index->nb_etats, m = index->nb_transitions;
+	size_t nb_mots = NB_MOTS_BITS( n ) + 1;
+	int * origines = xmalloc( ( m + 1 ) * sizeof(int) );
+	int * ordre = xmalloc( ( m + 1 ) * sizeof(int) );
+	int compteurs[257];
+	int i, t;
+
+	res->nb_etats = n;
+	res->nb_transitions = m;
+	res->taille_alphabet = index->taille_alphabet;
+	res->noms = xmalloc( ( n + 1 ) * sizeof(int) );
+	memcpy( res->noms, index->noms, n * sizeof(int) );
+	res->alphabet = xmalloc( index->taille_alphabet + 1 );
+	memcpy( res->alphabet, index->alphabet, index->taille_alphabet );
+	res->initiaux = xmalloc( nb_mots * sizeof(uint64_t) );
+	res->finaux = xmalloc( nb_mots * sizeof(uint64_t) );
+	memcpy( res->initiaux, index->finaux, nb_mots * sizeof(uint64_t) );
+	memcpy( res->finaux, index->initiaux, nb_mots * sizeof(uint64_t) );
+
+	for( i = 0; i < n; i++ ){
+		for( t = index->debut[i]; t < index->debut[i+1]; t++ ){
+			origines[t] = i;
+		}
+	}
+
+	// Tri stable par lettre
+	memset( compteurs, 0, sizeof(compteurs) );
+	for( t = 0; t < m; t++ ){
+		compteurs[ (unsigned char) index->lettres[t] + 1 ]++;
+	}
+	for( i = 0; i < 256; i++ ) compteurs[i+1] += compteurs[i];
+	for( t = 0; t < m; t++ ){
+		ordre[ compteurs[ (unsigned char) index->lettres[t] ]++ ] = t;
+	}
+
+	// Tri stable par nouvelle origine
+	res->debut = xmalloc( ( n + 1 ) * sizeof(int) );
+	memset( res->debut, 0, ( n + 1 ) * sizeof(int) );
+	for( t = 0; t < m; t++ ) res->debut[ index->fins[t] + 1 ]++;
+	for( i = 0; i < n; i++ ) res->debut[i+1] += res->debut[i];
+	res->lettres = xmalloc( m + 1 );
+	res->fins = xmalloc( ( m + 1 ) * sizeof(int) );
+	for( i = 0; i < m; i++ ){
+		int ancienne = ordre[i];
+		int origine = index->fins[ancienne];
+		int position = res->debut[origine]++;
+		res->lettres[position] = index->lettres[ancienne];
+		res->fins[position] = origines[ancienne];
+	}
+	for( i = n; i > 0; i-- ) res->debut[i] = res->debut[i-1];
+	res->debut[0] = 0;
+
+	xfree( origines );
+	xfree( ordre );
+	return res;
+}
+
+void liberer_index_automate( Index_automate * index ){
+	if( index ){
+		xfree( index->noms );
+		xfree( index->debut );
+		xfree( index->lettres );
+		xfree( index->fins );
+		xfree( index->alphabet );
+		xfree( index->initiaux );
+		xfree( index->finaux );
+		xfree( index );
+	}
+}
@@ -0,0 +1,129 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __INDEX_AUTOMATE_H__
+#define __INDEX_AUTOMATE_H__
+
+#include <stdint.h>
+
+#include "automate.h"
+
+/**
+ * \brief Manipulation d'ensembles de bits, rangés dans des tableaux de
+ *        uint64_t.
+ */
+#define NB_MOTS_BITS(n) ( ( (size_t) (n) + 63 ) / 64 )
+#define TESTER_BIT(bits,i) ( ( (bits)[ (size_t) (i) >> 6 ] >> ( (i) & 63 ) ) & 1 )
+#define MARQUER_BIT(bits,i) ( (bits)[ (size_t) (i) >> 6 ] |= ( (uint64_t) 1 ) << ( (i) & 63 ) )
+
+/**
+ * \brief Le type d'un index d'automate.
+ *
+ * Un index est une copie en lecture seule d'un automate, rangée dans des
+ * tableaux contigus pour les algorithmes qui parcourent beaucoup de
+ * transitions.
+ *
+ * Les états sont renumérotés de 0 à nb_etats-1 dans l'ordre croissant de
+ * leurs noms : l'état d'indice i s'appelle noms[i] dans l'automate.
+ *
+ * Les transitions partant de l'état d'indice i sont rangées aux positions
+ * debut[i] à debut[i+1]-1 des tableaux 'lettres' et 'fins' (format CSR) et
+ * sont triées par lettre (comme des unsigned char) puis par état d'arrivée.
+ * Les états d'arrivée sont donnés par leur indice.
+ *
+ * Les états initiaux et finaux sont codés par des ensembles de bits de
+ * NB_MOTS_BITS( nb_etats ) mots.
+ */
+typedef struct {
+	int nb_etats;
+	int nb_transitions;
+	int taille_alphabet;
+	int * noms;
+	int * debut;
+	char * lettres;
+	int * fins;
+	char * alphabet;
+	uint64_t * initiaux;
+	uint64_t * finaux;
+} Index_automate;
+
+/**
+ * \brief Construit l'index d'un automate.
+ *
+ * L'index est indépendant de l'automate du point de vue de la mémoire : il
+ * n'est pas mis à jour si l'automate est modifié par la suite.
+ *
+ * \param automate Un automate
+ * \return L'index de l'automate
+ */
+Index_automate * creer_index_automate( const Automate * automate );
+
+/**
+ * \brief Construit l'index de l'automate miroir d'un index.
+ *
+ * Les états gardent les mêmes indices et les mêmes noms, les transitions sont
+ * renversées, et les états initiaux et finaux sont échangés.
+ *
+ * \param index Un index
+ * \return L'index de l'automate miroir
+ */
+Index_automate * creer_index_miroir( const Index_automate * index );
+
+/**
+ * \brief Détruit un index.
+ *
+ * \param index L'index à détruire
+ */
+void liberer_index_automate( Index_automate * index );
+
+/**
+ * \brief Renvoie l'indice d'un état dans l'index, ou -1 si l'état n'existe
+ *        pas.
+ *
+ * \param index Un index
+ * \param etat Le nom d'un état de l'automate
+ * \return L'indice de l'état ou -1
+ */
+int indice_etat( const Index_automate * index, int etat );
+
+/**
+ * \brief Renvoie l'indice de l'unique état atteint depuis l'état d'indice
+ *        'origine' en lisant 'lettre', ou -1 s'il n'y en a pas.
+ *
+ * Si l'automate n'est pas déterministe, l'état d'arrivée de plus petit
+ * indice est renvoyé.
+ *
+ * \param index Un index
+ * \param origine L'indice de l'état de départ
+ * \param lettre Une lettre
+ * \return L'indice de l'état d'arrivée ou -1
+ */
+int transition_index( const Index_automate * index, int origine, char lettre );
+
+/**
+ * \brief Renvoie 1 si l'automate indexé est déterministe et 0 sinon.
+ *
+ * \param index Un index
+ * \return 1 ou 0
+ */
+int index_est_deterministe( const Index_automate * index );
+
+#endif
@@ -0,0 +1,742 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "langage.h"
+#include "index_automate.h"
+#include "outils.h"
+
+#include <string.h>
+
+/* Reconstruit le mot lu pour arriver au noeud 'noeud' en remontant les
+ * pères jusqu'à un noeud sans père (dont le père vaut -1).
+ */
+static char * reconstruire_mot(
+	const int * parents, const char * lettres, int noeud
+){
+	int longueur = 0, n;
+	char * mot;
+	for( n = noeud; parents[n] >= 0; n = parents[n] ) longueur++;
+	mot = xmalloc( longueur + 1 );
+	mot[longueur] = '\0';
+	for( n = noeud; parents[n] >= 0; n = parents[n] ){
+		mot[--longueur] = lettres[n];
+	}
+	return mot;
+}
+
+static int est_inclus_bits( const uint64_t * a, const uint64_t * b, size_t nb_mots ){
+	size_t i;
+	for( i = 0; i < nb_mots; i++ ){
+		if( a[i] & ~b[i] ) return 0;
+	}
+	return 1;
+}
+
+static int intersecte_bits( const uint64_t * a, const uint64_t * b, size_t nb_mots ){
+	size_t i;
+	for( i = 0; i < nb_mots; i++ ){
+		if( a[i] & b[i] ) return 1;
+	}
+	return 0;
+}
+
+/*
+ * Pour tester L(A1) inclus dans L(A2), on explore en largeur les couples
+ * (p, S) où p est un état de A1 et S l'ensemble des états de A2 atteints en
+ * lisant le même mot. Un couple est un contre-exemple si p est final alors
+ * qu'aucun état de S ne l'est.
+ *
+ * Si (p, S') a déjà été rencontré avec S' inclus dans S, tout contre-exemple
+ * trouvé depuis (p, S) l'aurait aussi été depuis (p, S') : on ne garde donc,
+ * pour chaque p, que les ensembles minimaux (une antichaîne). Les noeuds qui
+ * deviennent dominés sont retirés de l'antichaîne et ne sont pas explorés.
+ */
+typedef struct {
+	size_t nb_mots;
+	int nb_noeuds;
+	int capacite;
+	int * etats;
+	int * parents;
+	int * suivants;
+	char * lettres;
+	char * domines;
+	uint64_t * bits;
+	int * tetes;
+} Antichaine;
+
+static void initialiser_antichaine( Antichaine * c, int nb_etats1, int nb_etats2 ){
+	int i;
+	c->nb_mots = NB_MOTS_BITS( nb_etats2 );
+	if( c->nb_mots == 0 ) c->nb_mots = 1;
+	c->nb_noeuds = 0;
+	c->capacite = 64;
+	c->etats = xmalloc( c->capacite * sizeof(int) );
+	c->parents = xmalloc( c->capacite * sizeof(int) );
+	c->suivants = xmalloc( c->capacite * sizeof(int) );
+	c->lettres = xmalloc( c->capacite );
+	c->domines = xmalloc( c->capacite );
+	c->bits = xmalloc( c->capacite * c->nb_mots * sizeof(uint64_t) );
+	c->tetes = xmalloc( ( nb_etats1 + 1 ) * sizeof(int) );
+	for( i = 0; i < nb_etats1; i++ ) c->tetes[i] = -1;
+}
+
+static void liberer_antichaine( Antichaine * c ){
+	xfree( c->etats );
+	xfree( c->parents );
+	xfree( c->suivants );
+	xfree( c->lettres );
+	xfree( c->domines );
+	xfree( c->bits );
+	xfree( c->tetes );
+}
+
+#define BITS_NOEUD(c,n) ( (c)->bits + (size_t) (n) * (c)->nb_mots )
+
+/* Ajoute le noeud (etat, ensemble) et renvoie son numéro, ou renvoie -1 si
+ * le noeud est dominé par un noeud de l'antichaîne.
+ */
+static int ajouter_noeud(
+	Antichaine * c, int etat, const uint64_t * ensemble, int parent,
+	char lettre
+){
+	int n, * precedent;
+
+	for( n = c->tetes[etat]; n >= 0; n = c->suivants[n] ){
+		if( est_inclus_bits( BITS_NOEUD( c, n ), ensemble, c->nb_mots ) ){
+			return -1;
+		}
+	}
+	precedent = &( c->tetes[etat] );
+	for( n = *precedent; n >= 0; n = c->suivants[n] ){
+		if( est_inclus_bits( ensemble, BITS_NOEUD( c, n ), c->nb_mots ) ){
+			c->domines[n] = 1;
+			*precedent = c->suivants[n];
+		}else{
+			precedent = &( c->suivants[n] );
+		}
+	}
+
+	if( c->nb_noeuds == c->capacite ){
+		c->capacite *= 2;
+		c->etats = xrealloc( c->etats, c->capacite * sizeof(int) );
+		c->parents = xrealloc( c->parents, c->capacite * sizeof(int) );
+		c->suivants = xrealloc( c->suivants, c->capacite * sizeof(int) );
+		c->lettres = xrealloc( c->lettres, c->capacite );
+		c->domines = xrealloc( c->domines, c->capacite );
+		c->bits = xrealloc(
+			c->bits, c->capacite * c->nb_mots * sizeof(uint64_t)
+		);
+	}
+	n = c->nb_noeuds++;
+	c->etats[n] = etat;
+	c->parents[n] = parent;
+	c->lettres[n] = lettre;
+	c->domines[n] = 0;
+	memcpy( BITS_NOEUD( c, n ), ensemble, c->nb_mots * sizeof(uint64_t) );
+	c->suivants[n] = c->tetes[etat];
+	c->tetes[etat] = n;
+	return n;
+}
+
+static int est_un_contre_exemple(
+	const Antichaine * c, const Index_automate * index1,
+	const Index_automate * index2, int n
+){
+	return TESTER_BIT( index1->finaux, c->etats[n] )
+		&& ! intersecte_bits( BITS_NOEUD( c, n ), index2->finaux, c->nb_mots );
+}
+
+/* Calcule dans 'res' l'ensemble des états atteints depuis 'ensemble' en
+ * lisant 'lettre'.
+ */
+static void successeurs_bits(
+	const Index_automate * index, const uint64_t * ensemble, size_t nb_mots,
+	char lettre, uint64_t * res
+){
+	size_t m;
+	memset( res, 0, nb_mots * sizeof(uint64_t) );
+	for( m = 0; m < nb_mots; m++ ){
+		uint64_t x = ensemble[m];
+		while( x ){
+			int i = (int) ( m * 64 + __builtin_ctzll( x ) );
+			int t;
+			x &= x - 1;
+			for( t = index->debut[i]; t < index->debut[i+1]; t++ ){
+				if( (unsigned char) index->lettres[t] > (unsigned char) lettre ) break;
+				if( index->lettres[t] == lettre ){
+					MARQUER_BIT( res, index->fins[t] );
+				}
+			}
+		}
+	}
+}
+
+/*
+ * Un état q de A2 simule un état p de A1 si q est final dès que p l'est et
+ * si, pour toute transition (p,a)->p', il existe une transition (q,a)->q'
+ * telle que q' simule p'. Le langage de p est alors inclus dans celui de q,
+ * et il est inutile d'explorer un couple (p, S) dès que S contient un état
+ * qui simule p.
+ *
+ * On calcule la plus grande simulation en partant de la relation "q est final
+ * si p est final", puis en retirant les couples qui ne vérifient pas la
+ * condition. Quand un couple (p',q') est retiré, seuls les couples (p,q) avec
+ * (p,a)->p' et (q,a)->q' sont à vérifier de nouveau : on les retrouve grâce
+ * aux index miroirs.
+ *
+ * La ligne p de la relation est l'ensemble de bits des états qui simulent p.
+ */
+#define LIGNE(sim,nb_mots,p) ( (sim) + (size_t) (p) * (nb_mots) )
+
+static int simule(
+	const Index_automate * index1, const Index_automate * index2,
+	const uint64_t * sim, size_t nb_mots, int p, int q
+){
+	int t, u;
+	for( t = index1->debut[p]; t < index1->debut[p+1]; t++ ){
+		const uint64_t * ligne = LIGNE( sim, nb_mots, index1->fins[t] );
+		int trouve = 0;
+		for( u = index2->debut[q]; u < index2->debut[q+1] && ! trouve; u++ ){
+			if( (unsigned char) index2->lettres[u]
+				> (unsigned char) index1->lettres[t]
+			){
+				break;
+			}
+			trouve = index2->lettres[u] == index1->lettres[t]
+				&& TESTER_BIT( ligne, index2->fins[u] );
+		}
+		if( ! trouve ) return 0;
+	}
+	return 1;
+}
+
+/* Retire le couple (p,q) de la relation et l'empile pour propager le
+ * retrait.
+ */
+static void retirer_couple(
+	uint64_t * sim, size_t nb_mots, int p, int q,
+	int ** pile, int * nb, int * capacite
+){
+	LIGNE( sim, nb_mots, p )[ q >> 6 ] &= ~( ( (uint64_t) 1 ) << ( q & 63 ) );
+	if( *nb == *capacite ){
+		*capacite *= 2;
+		*pile = xrealloc( *pile, 2 * (*capacite) * sizeof(int) );
+	}
+	(*pile)[ 2 * (*nb) ] = p;
+	(*pile)[ 2 * (*nb) + 1 ] = q;
+	(*nb)++;
+}
+
+static uint64_t * calculer_simulation(
+	const Index_automate * index1, const Index_automate * index2,
+	size_t nb_mots
+){
+	int n1 = index1->nb_etats, n2 = index2->nb_etats;
+	uint64_t * sim = xmalloc( ( (size_t) n1 * nb_mots + 1 ) * sizeof(uint64_t) );
+	Index_automate * miroir1 = creer_index_miroir( index1 );
+	Index_automate * miroir2 = creer_index_miroir( index2 );
+	int capacite = 1024, nb = 0;
+	int * pile = xmalloc( 2 * capacite * sizeof(int) );
+	int p, q;
+
+	for( p = 0; p < n1; p++ ){
+		uint64_t * ligne = LIGNE( sim, nb_mots, p );
+		memset( ligne, 0, nb_mots * sizeof(uint64_t) );
+		for( q = 0; q < n2; q++ ){
+			if( ! TESTER_BIT( index1->finaux, p )
+				|| TESTER_BIT( index2->finaux, q ) ){
+				MARQUER_BIT( ligne, q );
+			}
+		}
+	}
+
+	// Premier passage sur tous les couples, puis propagation des retraits.
+	for( p = 0; p < n1; p++ ){
+		for( q = 0; q < n2; q++ ){
+			if( TESTER_BIT( LIGNE( sim, nb_mots, p ), q )
+				&& ! simule( index1, index2, sim, nb_mots, p, q ) ){
+				retirer_couple( sim, nb_mots, p, q, &pile, &nb, &capacite );
+			}
+		}
+	}
+	while( nb > 0 ){
+		int p2, q2, t, u;
+		nb--;
+		p2 = pile[2*nb];
+		q2 = pile[2*nb+1];
+		for( t = miroir1->debut[p2]; t < miroir1->debut[p2+1]; t++ ){
+			for( u = miroir2->debut[q2]; u < miroir2->debut[q2+1]; u++ ){
+				if( miroir2->lettres[u] != miroir1->lettres[t] ) continue;
+				p = miroir1->fins[t];
+				q = miroir2->fins[u];
+				if( TESTER_BIT( LIGNE( sim, nb_mots, p ), q )
+					&& ! simule( index1, index2, sim, nb_mots, p, q ) ){
+					retirer_couple( sim, nb_mots, p, q, &pile, &nb, &capacite );
+				}
+			}
+		}
+	}
+
+	xfree( pile );
+	liberer_index_automate( miroir1 );
+	liberer_index_automate( miroir2 );
+	return sim;
+}
+
+static int inclusion_index(
+	const Index_automate * index1, const Index_automate * index2,
+	char ** contre_exemple
+){
+	Antichaine c;
+	uint64_t * suivant;
+	uint64_t * sim;
+	int i, courant, mauvais = -1;
+
+	initialiser_antichaine( &c, index1->nb_etats, index2->nb_etats );
+	sim = calculer_simulation( index1, index2, c.nb_mots );
+	suivant = xmalloc( c.nb_mots * sizeof(uint64_t) );
+	memset( suivant, 0, c.nb_mots * sizeof(uint64_t) );
+	memcpy( suivant, index2->initiaux,
+		NB_MOTS_BITS( index2->nb_etats ) * sizeof(uint64_t) );
+
+	for( i = 0; i < index1->nb_etats && mauvais < 0; i++ ){
+		if( TESTER_BIT( index1->initiaux, i )
+			&& ! intersecte_bits( LIGNE( sim, c.nb_mots, i ), suivant, c.nb_mots ) ){
+			int n = ajouter_noeud( &c, i, suivant, -1, '\0' );
+			if( n >= 0 && est_un_contre_exemple( &c, index1, index2, n ) ){
+				mauvais = n;
+			}
+		}
+	}
+
+	for( courant = 0; courant < c.nb_noeuds && mauvais < 0; courant++ ){
+		int p, t, fin;
+		if( c.domines[courant] ) continue;
+		p = c.etats[courant];
+		t = index1->debut[p];
+		fin = index1->debut[p+1];
+		while( t < fin && mauvais < 0 ){
+			char lettre = index1->lettres[t];
+			successeurs_bits(
+				index2, BITS_NOEUD( &c, courant ), c.nb_mots, lettre, suivant
+			);
+			for( ; t < fin && index1->lettres[t] == lettre; t++ ){
+				int n;
+				if( intersecte_bits(
+					LIGNE( sim, c.nb_mots, index1->fins[t] ), suivant, c.nb_mots
+				) ){
+					continue;
+				}
+				n = ajouter_noeud(
+					&c, index1->fins[t], suivant, courant, lettre
+				);
+				if( n >= 0 && est_un_contre_exemple( &c, index1, index2, n ) ){
+					mauvais = n;
+					break;
+				}
+			}
+		}
+	}
+
+	if( mauvais >= 0 && contre_exemple ){
+		*contre_exemple = reconstruire_mot( c.parents, c.lettres, mauvais );
+	}
+	xfree( suivant );
+	xfree( sim );
+	liberer_antichaine( &c );
+	return mauvais < 0;
+}
+
+int inclusion_langage(
+	const Automate * automate1, const Automate * automate2,
+	char ** contre_exemple
+){
+	Index_automate * index1 = creer_index_automate( automate1 );
+	Index_automate * index2 = creer_index_automate( automate2 );
+	int res = inclusion_index( index1, index2, contre_exemple );
+	liberer_index_automate( index1 );
+	liberer_index_automate( index2 );
+	return res;
+}
+
+static int trouver_representant( int * representants, int x ){
+	while( representants[x] != x ){
+		representants[x] = representants[ representants[x] ];
+		x = representants[x];
+	}
+	return x;
+}
+
+/*
+ * Algorithme de Hopcroft et Karp. Les états des deux automates sont rangés
+ * dans un même tableau (ceux du second sont décalés de n1) et complétés par
+ * un unique état puits d'indice n1 + n2. On fusionne les états initiaux, puis
+ * on fusionne de proche en proche les états atteints par une même lettre. Si
+ * deux états fusionnés ne sont pas tous les deux finaux ou tous les deux non
+ * finaux, le mot qui y mène est un contre-exemple.
+ */
+static int equivalence_deterministe(
+	const Index_automate * index1, const Index_automate * index2,
+	char ** contre_exemple
+){
+	int n1 = index1->nb_etats, n2 = index2->nb_etats;
+	int puits = n1 + n2;
+	int * representants = xmalloc( ( puits + 1 ) * sizeof(int) );
+	int capacite = 64, nb = 0, courant, i, res = 1;
+	int * gauches = xmalloc( capacite * sizeof(int) );
+	int * droites = xmalloc( capacite * sizeof(int) );
+	int * parents = xmalloc( capacite * sizeof(int) );
+	char * lettres = xmalloc( capacite );
+	char alphabet[256];
+	char present[256];
+	int taille_alphabet = 0;
+
+	memset( present, 0, sizeof(present) );
+	for( i = 0; i < index1->taille_alphabet; i++ ){
+		present[ (unsigned char) index1->alphabet[i] ] = 1;
+	}
+	for( i = 0; i < index2->taille_alphabet; i++ ){
+		present[ (unsigned char) index2->alphabet[i] ] = 1;
+	}
+	for( i = 0; i < 256; i++ ){
+		if( present[i] ) alphabet[ taille_alphabet++ ] = (char) i;
+	}
+	for( i = 0; i <= puits; i++ ) representants[i] = i;
+
+	gauches[0] = puits;
+	droites[0] = puits;
+	parents[0] = -1;
+	lettres[0] = '\0';
+	for( i = 0; i < n1; i++ ){
+		if( TESTER_BIT( index1->initiaux, i ) ) gauches[0] = i;
+	}
+	for( i = 0; i < n2; i++ ){
+		if( TESTER_BIT( index2->initiaux, i ) ) droites[0] = n1 + i;
+	}
+	representants[ trouver_representant( representants, gauches[0] ) ] =
+		trouver_representant( representants, droites[0] );
+	nb = 1;
+
+	for( courant = 0; courant < nb && res; courant++ ){
+		int x = gauches[courant], y = droites[courant];
+		int final_x = ( x < n1 ) && TESTER_BIT( index1->finaux, x );
+		int final_y = ( y >= n1 && y < puits )
+			&& TESTER_BIT( index2->finaux, y - n1 );
+		if( final_x != final_y ){
+			res = 0;
+			if( contre_exemple ){
+				*contre_exemple = reconstruire_mot( parents, lettres, courant );
+			}
+			break;
+		}
+		for( i = 0; i < taille_alphabet; i++ ){
+			int sx = puits, sy = puits, rx, ry;
+			if( x < n1 ){
+				sx = transition_index( index1, x, alphabet[i] );
+				if( sx < 0 ) sx = puits;
+			}
+			if( y >= n1 && y < puits ){
+				sy = transition_index( index2, y - n1, alphabet[i] );
+				sy = ( sy < 0 ) ? puits : n1 + sy;
+			}
+			rx = trouver_representant( representants, sx );
+			ry = trouver_representant( representants, sy );
+			if( rx == ry ) continue;
+			representants[rx] = ry;
+			if( nb == capacite ){
+				capacite *= 2;
+				gauches = xrealloc( gauches, capacite * sizeof(int) );
+				droites = xrealloc( droites, capacite * sizeof(int) );
+				parents = xrealloc( parents, capacite * sizeof(int) );
+				lettres = xrealloc( lettres, capacite );
+			}
+			gauches[nb] = sx;
+			droites[nb] = sy;
+			parents[nb] = courant;
+			lettres[nb] = alphabet[i];
+			nb++;
+		}
+	}
+
+	xfree( representants );
+	xfree( gauches );
+	xfree( droites );
+	xfree( parents );
+	xfree( lettres );
+	return res;
+}
+
+int equivalence_langage(
+	const Automate * automate1, const Automate * automate2,
+	char ** contre_exemple
+){
+	Index_automate * index1 = creer_index_automate( automate1 );
+	Index_automate * index2 = creer_index_automate( automate2 );
+	int res;
+
+	if( index_est_deterministe( index1 ) && index_est_deterministe( index2 ) ){
+		res = equivalence_deterministe( index1, index2, contre_exemple );
+	}else{
+		res = inclusion_index( index1, index2, contre_exemple )
+			&& inclusion_index( index2, index1, contre_exemple );
+	}
+
+	liberer_index_automate( index1 );
+	liberer_index_automate( index2 );
+	return res;
+}
+
+/*
+ * Parcours en largeur depuis les états initiaux. Le tableau 'parents' sert à
+ * la fois à marquer les états déjà vus (-2 pour ceux qui ne l'ont pas été,
+ * -1 pour les états initiaux) et à reconstruire le mot qui mène à l'état
+ * final trouvé. Renvoie l'indice de cet état, ou -1 s'il n'y en a pas.
+ */
+static int parcours_vers_un_final(
+	const Index_automate * index, int * parents, char * lettres
+){
+	int * file = xmalloc( ( index->nb_etats + 1 ) * sizeof(int) );
+	int debut = 0, fin = 0, i, res = -1;
+
+	for( i = 0; i < index->nb_etats; i++ ){
+		parents[i] = -2;
+		if( TESTER_BIT( index->initiaux, i ) ){
+			parents[i] = -1;
+			file[ fin++ ] = i;
+		}
+	}
+	while( debut < fin ){
+		int e = file[ debut++ ], t;
+		if( TESTER_BIT( index->finaux, e ) ){
+			res = e;
+			break;
+		}
+		for( t = index->debut[e]; t < index->debut[e+1]; t++ ){
+			int f = index->fins[t];
+			if( parents[f] == -2 ){
+				parents[f] = e;
+				lettres[f] = index->lettres[t];
+				file[ fin++ ] = f;
+			}
+		}
+	}
+	xfree( file );
+	return res;
+}
+
+static char * plus_court_mot_index( const Index_automate * index ){
+	int * parents = xmalloc( ( index->nb_etats + 1 ) * sizeof(int) );
+	char * lettres = xmalloc( index->nb_etats + 1 );
+	int final = parcours_vers_un_final( index, parents, lettres );
+	char * res = NULL;
+	if( final >= 0 ){
+		res = reconstruire_mot( parents, lettres, final );
+	}
+	xfree( parents );
+	xfree( lettres );
+	return res;
+}
+
+char * plus_court_mot_reconnu( const Automate * automate ){
+	Index_automate * index = creer_index_automate( automate );
+	char * res = plus_court_mot_index( index );
+	liberer_index_automate( index );
+	return res;
+}
+
+int langage_est_vide( const Automate * automate ){
+	Index_automate * index = creer_index_automate( automate );
+	int * parents = xmalloc( ( index->nb_etats + 1 ) * sizeof(int) );
+	char * lettres = xmalloc( index->nb_etats + 1 );
+	int res = parcours_vers_un_final( index, parents, lettres ) < 0;
+	xfree( parents );
+	xfree( lettres );
+	liberer_index_automate( index );
+	return res;
+}
+
+/*
+ * Énumération par longueur croissante, puis par ordre lexicographique.
+ *
+ * La ligne r de 'atteint' contient les états accessibles depuis lesquels un
+ * mot de longueur r mène à un état final. Pour une longueur L fixée, le mot
+ * courant est décrit par les transitions choix[0], ..., choix[L-1]. Le mot
+ * suivant de même longueur s'obtient en remplaçant la dernière transition qui
+ * peut l'être par une transition de lettre plus grande (restant dans
+ * 'atteint'), puis en complétant avec les plus petites lettres possibles.
+ */
+struct _Enumerateur {
+	Index_automate * index;
+	int initial;
+	int longueur;
+	int termine;
+	size_t nb_mots;
+	uint64_t * accessibles;
+	uint64_t * atteint;
+	int nb_lignes;
+	int capacite;
+	char * mot;
+	int * choix;
+};
+
+#define LIGNE_ATTEINT(e,r) ( (e)->atteint + (size_t) (r) * (e)->nb_mots )
+
+/* Calcule la ligne suivante de 'atteint'. Renvoie 0 si elle est vide : toutes
+ * les lignes suivantes le sont alors aussi.
+ */
+static int calculer_ligne_suivante( Enumerateur * e ){
+	const Index_automate * index = e->index;
+	uint64_t * precedente, * ligne;
+	int q, t, non_vide = 0;
+
+	if( e->nb_lignes == e->capacite ){
+		e->capacite *= 2;
+		e->atteint = xrealloc(
+			e->atteint, e->capacite * e->nb_mots * sizeof(uint64_t)
+		);
+		e->mot = xrealloc( e->mot, e->capacite + 1 );
+		e->choix = xrealloc( e->choix, ( e->capacite + 1 ) * sizeof(int) );
+	}
+	precedente = LIGNE_ATTEINT( e, e->nb_lignes - 1 );
+	ligne = LIGNE_ATTEINT( e, e->nb_lignes );
+	memset( ligne, 0, e->nb_mots * sizeof(uint64_t) );
+	for( q = 0; q < index->nb_etats; q++ ){
+		if( ! TESTER_BIT( e->accessibles, q ) ) continue;
+		for( t = index->debut[q]; t < index->debut[q+1]; t++ ){
+			if( TESTER_BIT( precedente, index->fins[t] ) ){
+				MARQUER_BIT( ligne, q );
+				non_vide = 1;
+				break;
+			}
+		}
+	}
+	e->nb_lignes++;
+	return non_vide;
+}
+
+/* Complète le mot courant à partir de la position i, depuis l'état q, avec
+ * les plus petites lettres possibles. Un mot de longueur L - i doit mener de
+ * q à un état final.
+ */
+static void completer_mot( Enumerateur * e, int i, int q ){
+	const Index_automate * index = e->index;
+	int t;
+	for( ; i < e->longueur; i++ ){
+		const uint64_t * ligne = LIGNE_ATTEINT( e, e->longueur - i - 1 );
+		for( t = index->debut[q]; ! TESTER_BIT( ligne, index->fins[t] ); t++ );
+		e->choix[i] = t;
+		e->mot[i] = index->lettres[t];
+		q = index->fins[t];
+	}
+	e->mot[ e->longueur ] = '\0';
+}
+
+Enumerateur * creer_enumerateur( const Automate * automate ){
+	Enumerateur * res = xmalloc( sizeof(Enumerateur) );
+	Index_automate * index = creer_index_automate( automate );
+	int * file = xmalloc( ( index->nb_etats + 1 ) * sizeof(int) );
+	int debut = 0, fin = 0, q, t;
+
+	if( ! index_est_deterministe( index ) ){
+		ERREUR( "L'enumeration demande un automate deterministe" );
+	}
+	res->index = index;
+	res->nb_mots = NB_MOTS_BITS( index->nb_etats ) + 1;
+	res->accessibles = xmalloc( res->nb_mots * sizeof(uint64_t) );
+	memset( res->accessibles, 0, res->nb_mots * sizeof(uint64_t) );
+	res->initial = -1;
+	for( q = 0; q < index->nb_etats; q++ ){
+		if( TESTER_BIT( index->initiaux, q ) ){
+			res->initial = q;
+			MARQUER_BIT( res->accessibles, q );
+			file[ fin++ ] = q;
+		}
+	}
+	while( debut < fin ){
+		q = file[ debut++ ];
+		for( t = index->debut[q]; t < index->debut[q+1]; t++ ){
+			if( ! TESTER_BIT( res->accessibles, index->fins[t] ) ){
+				MARQUER_BIT( res->accessibles, index->fins[t] );
+				file[ fin++ ] = index->fins[t];
+			}
+		}
+	}
+	xfree( file );
+
+	res->capacite = 16;
+	res->atteint = xmalloc( res->capacite * res->nb_mots * sizeof(uint64_t) );
+	res->mot = xmalloc( res->capacite + 1 );
+	res->choix = xmalloc( ( res->capacite + 1 ) * sizeof(int) );
+	res->nb_lignes = 1;
+	for( q = 0; q < (int) res->nb_mots; q++ ){
+		res->atteint[q] = index->finaux[q] & res->accessibles[q];
+	}
+	res->longueur = -1;
+	res->termine = ( res->initial < 0 );
+	return res;
+}
+
+void liberer_enumerateur( Enumerateur * enumerateur ){
+	if( enumerateur ){
+		liberer_index_automate( enumerateur->index );
+		xfree( enumerateur->accessibles );
+		xfree( enumerateur->atteint );
+		xfree( enumerateur->mot );
+		xfree( enumerateur->choix );
+		xfree( enumerateur );
+	}
+}
+
+const char * mot_suivant( Enumerateur * e ){
+	const Index_automate * index = e->index;
+	int i, t;
+
+	if( e->termine ) return NULL;
+
+	// Le mot suivant de même longueur
+	for( i = e->longueur - 1; i >= 0; i-- ){
+		const uint64_t * ligne = LIGNE_ATTEINT( e, e->longueur - i - 1 );
+		int q = ( i == 0 ) ? e->initial : index->fins[ e->choix[i-1] ];
+		for( t = e->choix[i] + 1; t < index->debut[q+1]; t++ ){
+			if( TESTER_BIT( ligne, index->fins[t] ) ){
+				e->choix[i] = t;
+				e->mot[i] = index->lettres[t];
+				completer_mot( e, i + 1, index->fins[t] );
+				return e->mot;
+			}
+		}
+	}
+
+	// Le premier mot d'une longueur plus grande. Tous les états considérés
+	// sont accessibles depuis l'état initial : tant que les lignes ne sont
+	// pas vides, l'état initial apparaît au moins une fois toutes les
+	// nb_etats lignes.
+	for( ;; ){
+		e->longueur++;
+		if( e->longueur == e->nb_lignes && ! calculer_ligne_suivante( e ) ){
+			e->termine = 1;
+			return NULL;
+		}
+		if( TESTER_BIT( LIGNE_ATTEINT( e, e->longueur ), e->initial ) ){
+			completer_mot( e, 0, e->initial );
+			return e->mot;
+		}
+	}
+}
@@ -0,0 +1,136 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __LANGAGE_H__
+#define __LANGAGE_H__
+
+#include "automate.h"
+
+/**
+ * \brief Renvoie 1 si le langage reconnu par le premier automate est inclus
+ *        dans le langage reconnu par le second, et 0 sinon.
+ *
+ * Les automates peuvent être non déterministes : le second automate n'est pas
+ * déterminisé, ses ensembles d'états sont calculés à la volée et seuls les
+ * plus petits d'entre eux (pour l'inclusion) sont conservés (antichaîne).
+ *
+ * Si l'inclusion est fausse et que 'contre_exemple' n'est pas NULL, un mot
+ * reconnu par le premier automate mais pas par le second est écrit dans
+ * '*contre_exemple'. La mémoire de ce mot est laissée à la charge de
+ * l'utilisateur, qui devra la libérer avec xfree().
+ *
+ * \param automate1 Le premier automate
+ * \param automate2 Le second automate
+ * \param contre_exemple L'adresse où écrire le contre-exemple, ou NULL
+ * \return 1 ou 0
+ */
+int inclusion_langage(
+	const Automate * automate1, const Automate * automate2,
+	char ** contre_exemple
+);
+
+/**
+ * \brief Renvoie 1 si les deux automates reconnaissent le même langage, et 0
+ *        sinon.
+ *
+ * Si les deux automates sont déterministes, la fonction utilise l'algorithme
+ * de Hopcroft et Karp (union-find sur les couples d'états). Sinon, elle
+ * teste les deux inclusions avec inclusion_langage().
+ *
+ * Si les langages sont différents et que 'contre_exemple' n'est pas NULL, un
+ * mot reconnu par un seul des deux automates est écrit dans
+ * '*contre_exemple'. La mémoire de ce mot est laissée à la charge de
+ * l'utilisateur, qui devra la libérer avec xfree().
+ *
+ * \param automate1 Le premier automate
+ * \param automate2 Le second automate
+ * \param contre_exemple L'adresse où écrire le contre-exemple, ou NULL
+ * \return 1 ou 0
+ */
+int equivalence_langage(
+	const Automate * automate1, const Automate * automate2,
+	char ** contre_exemple
+);
+
+/**
+ * \brief Renvoie 1 si l'automate ne reconnaît aucun mot, et 0 sinon.
+ *
+ * La fonction fait un unique parcours en largeur depuis les états initiaux,
+ * qui s'arrête au premier état final rencontré. Aucun automate n'est créé.
+ *
+ * \param automate Un automate
+ * \return 1 ou 0
+ */
+int langage_est_vide( const Automate * automate );
+
+/**
+ * \brief Renvoie un mot de longueur minimale reconnu par l'automate, ou NULL
+ *        si l'automate ne reconnaît aucun mot.
+ *
+ * Parmi les mots de longueur minimale, le mot renvoyé est obtenu par un
+ * parcours en largeur qui essaie les lettres dans l'ordre croissant.
+ * La mémoire du mot renvoyé est laissée à la charge de l'utilisateur, qui
+ * devra la libérer avec xfree().
+ *
+ * \param automate Un automate
+ * \return Un mot reconnu ou NULL
+ */
+char * plus_court_mot_reconnu( const Automate * automate );
+
+/**
+ * \brief Un énumérateur des mots reconnus par un automate déterministe.
+ */
+typedef struct _Enumerateur Enumerateur;
+
+/**
+ * \brief Prépare l'énumération des mots reconnus par un automate
+ *        déterministe, par longueur croissante puis par ordre
+ *        lexicographique.
+ *
+ * Seuls les états accessibles sont considérés. Pour chaque longueur r, on
+ * calcule (à la demande) l'ensemble des états depuis lesquels un mot de
+ * longueur r mène à un état final : les branches qui ne peuvent pas mener à
+ * un mot reconnu de la bonne longueur ne sont jamais explorées, et chaque
+ * mot est obtenu en un temps proportionnel à sa longueur.
+ *
+ * Le programme s'arrête avec une erreur si l'automate n'est pas
+ * déterministe.
+ *
+ * \param automate Un automate déterministe
+ * \return L'énumérateur, à libérer avec liberer_enumerateur()
+ */
+Enumerateur * creer_enumerateur( const Automate * automate );
+
+void liberer_enumerateur( Enumerateur * enumerateur );
+
+/**
+ * \brief Renvoie le mot reconnu suivant, ou NULL s'il n'y en a plus.
+ *
+ * Le mot renvoyé est écrit dans un tampon de l'énumérateur, qui est réutilisé
+ * (et peut être déplacé) à l'appel suivant : il faut le copier pour le
+ * conserver.
+ *
+ * \param enumerateur Un énumérateur
+ * \return Le mot suivant ou NULL
+ */
+const char * mot_suivant( Enumerateur * enumerateur );
+
+#endif
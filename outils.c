@@ -21,7 +21,9 @@
 
 #include "outils.h"
 
+#include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
 
 int test( int result, int ligne ){
 	if( ! result ){
@@ -31,7 +33,89 @@ int test( int result, int ligne ){
 	return 0;
 }
 
-void* xmalloc( size_t n ){
+#ifdef COMPTER_ALLOCATIONS
+
+/* L'en-tête placé devant chaque bloc. L'union garde l'alignement que
+ * malloc() garantit au bloc rendu à l'utilisateur.
+ */
+typedef union {
+	struct {
+		size_t taille;
+		Sous_systeme_allocation sous_systeme;
+	} bloc;
+	max_align_t alignement;
+} En_tete_allocation;
+
+static Compteurs_allocation compteurs[ NB_SOUS_SYSTEMES_ALLOCATION ];
+
+static void compter_allocation( Sous_systeme_allocation s, size_t n ){
+	Compteurs_allocation * c = &compteurs[s];
+	long long vivants, pic;
+	__atomic_fetch_add( &c->allocations, 1, __ATOMIC_RELAXED );
+	vivants = __atomic_add_fetch( &c->octets_vivants, n, __ATOMIC_RELAXED );
+	pic = __atomic_load_n( &c->pic_octets, __ATOMIC_RELAXED );
+	while( vivants > pic && ! __atomic_compare_exchange_n(
+		&c->pic_octets, &pic, vivants, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED
+	) );
+}
+
+static void compter_liberation( const En_tete_allocation * en_tete ){
+	Compteurs_allocation * c = &compteurs[ en_tete->bloc.sous_systeme ];
+	__atomic_fetch_add( &c->liberations, 1, __ATOMIC_RELAXED );
+	__atomic_fetch_sub( &c->octets_vivants, en_tete->bloc.taille, __ATOMIC_RELAXED );
+}
+
+void* xmalloc_etiquete( size_t n, Sous_systeme_allocation sous_systeme ){
+	En_tete_allocation * en_tete = malloc( sizeof(En_tete_allocation) + n );
+	if( ! en_tete ){
+		ERREUR( "Espace insuffisant" );
+	}
+	en_tete->bloc.taille = n;
+	en_tete->bloc.sous_systeme = sous_systeme;
+	compter_allocation( sous_systeme, n );
+	return en_tete + 1;
+}
+
+void* xrealloc_etiquete(
+	void* ptr, size_t n, Sous_systeme_allocation sous_systeme
+){
+	En_tete_allocation * en_tete = ptr ? (En_tete_allocation *) ptr - 1 : NULL;
+	if( en_tete ) compter_liberation( en_tete );
+	en_tete = realloc( en_tete, sizeof(En_tete_allocation) + n );
+	if( ! en_tete ){
+		ERREUR( "Espace insuffisant" );
+	}
+	en_tete->bloc.taille = n;
+	en_tete->bloc.sous_systeme = sous_systeme;
+	compter_allocation( sous_systeme, n );
+	return en_tete + 1;
+}
+
+void xfree( void* ptr ){
+	if( ptr ){
+		En_tete_allocation * en_tete = (En_tete_allocation *) ptr - 1;
+		compter_liberation( en_tete );
+		free( en_tete );
+	}
+}
+
+void relever_allocations( Releve_allocations * releve ){
+	int s;
+	for( s = 0; s < NB_SOUS_SYSTEMES_ALLOCATION; s++ ){
+		Compteurs_allocation * c = &compteurs[s];
+		Compteurs_allocation * r = &releve->sous_systemes[s];
+		r->allocations = __atomic_load_n( &c->allocations, __ATOMIC_RELAXED );
+		r->liberations = __atomic_load_n( &c->liberations, __ATOMIC_RELAXED );
+		r->octets_vivants = __atomic_load_n( &c->octets_vivants, __ATOMIC_RELAXED );
+		r->pic_octets = __atomic_exchange_n(
+			&c->pic_octets, r->octets_vivants, __ATOMIC_RELAXED
+		);
+	}
+}
+
+#else
+
+void* xmalloc_etiquete( size_t n, Sous_systeme_allocation sous_systeme ){
 	void* result = malloc( n );
 	if( ! result ){
 		ERREUR( "Espace insuffisant" );
@@ -39,6 +123,95 @@ void* xmalloc( size_t n ){
 	return result;
 }
 
+void* xrealloc_etiquete(
+	void* ptr, size_t n, Sous_systeme_allocation sous_systeme
+){
+	void* result = realloc( ptr, n );
+	if( ! result ){
+		ERREUR( "Espace insuffisant" );
+	}
+	return result;
+}
+
 void xfree( void* ptr ){
 	free(ptr);
 }
+
+void relever_allocations( Releve_allocations * releve ){
+	memset( releve, 0, sizeof(Releve_allocations) );
+}
+
+#endif
+
+void* xmalloc( size_t n ){
+	return xmalloc_etiquete( n, ALLOCATION_AUTRE );
+}
+
+void* xrealloc( void* ptr, size_t n ){
+	return xrealloc_etiquete( ptr, n, ALLOCATION_AUTRE );
+}
+
+void total_allocations(
+	const Releve_allocations * releve, Compteurs_allocation * total
+){
+	int s;
+	memset( total, 0, sizeof(Compteurs_allocation) );
+	for( s = 0; s < NB_SOUS_SYSTEMES_ALLOCATION; s++ ){
+		const Compteurs_allocation * c = &releve->sous_systemes[s];
+		total->allocations += c->allocations;
+		total->liberations += c->liberations;
+		total->octets_vivants += c->octets_vivants;
+		total->pic_octets += c->pic_octets;
+	}
+}
+
+unsigned long long nombre_allocations( void ){
+	unsigned long long res = 0;
+#ifdef COMPTER_ALLOCATIONS
+	int s;
+	for( s = 0; s < NB_SOUS_SYSTEMES_ALLOCATION; s++ ){
+		res += __atomic_load_n( &compteurs[s].allocations, __ATOMIC_RELAXED );
+	}
+#endif
+	return res;
+}
+
+void difference_allocations(
+	const Releve_allocations * avant, const Releve_allocations * apres,
+	Releve_allocations * difference
+){
+	int s;
+	for( s = 0; s < NB_SOUS_SYSTEMES_ALLOCATION; s++ ){
+		const Compteurs_allocation * a = &avant->sous_systemes[s];
+		const Compteurs_allocation * b = &apres->sous_systemes[s];
+		Compteurs_allocation * d = &difference->sous_systemes[s];
+		d->allocations = b->allocations - a->allocations;
+		d->liberations = b->liberations - a->liberations;
+		d->octets_vivants = b->octets_vivants - a->octets_vivants;
+		d->pic_octets = b->pic_octets - a->octets_vivants;
+		if( d->pic_octets < 0 ) d->pic_octets = 0;
+	}
+}
+
+const char * nom_sous_systeme_allocation( Sous_systeme_allocation sous_systeme ){
+	static const char * noms[ NB_SOUS_SYSTEMES_ALLOCATION ] = {
+		"autre", "table", "avl", "ensemble", "automate", "fifo"
+	};
+	if( sous_systeme < 0 || sous_systeme >= NB_SOUS_SYSTEMES_ALLOCATION ){
+		return "?";
+	}
+	return noms[ sous_systeme ];
+}
+
+void afficher_allocations( FILE * sortie, const Releve_allocations * releve ){
+	int s;
+	for( s = 0; s < NB_SOUS_SYSTEMES_ALLOCATION; s++ ){
+		const Compteurs_allocation * c = &releve->sous_systemes[s];
+		fprintf(
+			sortie, "%-9s allocations : %llu, liberations : %llu, "
+			"octets vivants : %lld, pic : %lld\n",
+			nom_sous_systeme_allocation( s ), c->allocations, c->liberations,
+			c->octets_vivants, c->pic_octets
+		);
+	}
+}
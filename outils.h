@@ -28,9 +28,91 @@
 #define DEBUG(x) { fprintf(stderr,"DEBUG : %s - ligne : %d, fichier : %s\n", (x), __LINE__, __FILE__ ); }
 #define ERREUR(x) { fprintf(stderr,"ERREUR : %s - ligne : %d, fichier : %s\n", (x), __LINE__, __FILE__ ); exit(EXIT_FAILURE); }
 
+/*
+ * Les sous-systèmes auxquels sont attribuées les allocations, pour les
+ * compteurs ci-dessous. xmalloc() et xrealloc() attribuent leurs allocations
+ * à ALLOCATION_AUTRE.
+ */
+typedef enum {
+	ALLOCATION_AUTRE,
+	ALLOCATION_TABLE,
+	ALLOCATION_AVL,
+	ALLOCATION_ENSEMBLE,
+	ALLOCATION_AUTOMATE,
+	ALLOCATION_FIFO,
+	NB_SOUS_SYSTEMES_ALLOCATION
+} Sous_systeme_allocation;
+
 void* xmalloc( size_t n );
+void* xrealloc( void* ptr, size_t n );
+void* xmalloc_etiquete( size_t n, Sous_systeme_allocation sous_systeme );
+void* xrealloc_etiquete(
+	void* ptr, size_t n, Sous_systeme_allocation sous_systeme
+);
 void xfree( void* ptr );
 
+/*
+ * Si la bibliothèque est compilée avec -DCOMPTER_ALLOCATIONS, chaque bloc
+ * alloué porte un en-tête qui donne sa taille et son sous-système, et les
+ * allocations, les libérations et les octets vivants sont comptés par
+ * sous-système. Un xrealloc() compte pour une allocation, et pour une
+ * libération si le pointeur n'est pas nul. Sinon, aucun en-tête n'est
+ * ajouté et tous les compteurs restent nuls.
+ *
+ * Les compteurs sont mis à jour de manière atomique : ils restent justes
+ * quand plusieurs fils d'exécution allouent à la fois.
+ */
+typedef struct {
+	unsigned long long allocations;
+	unsigned long long liberations;
+	long long octets_vivants;
+	long long pic_octets;
+} Compteurs_allocation;
+
+typedef struct {
+	Compteurs_allocation sous_systemes[ NB_SOUS_SYSTEMES_ALLOCATION ];
+} Releve_allocations;
+
+/*
+ * Renvoie le nombre d'allocations (tous sous-systèmes confondus) depuis le
+ * début du programme.
+ */
+unsigned long long nombre_allocations( void );
+
+/*
+ * Relève les compteurs, puis ramène le pic de chaque sous-système à son
+ * nombre d'octets vivants : le pic du relevé suivant est donc le maximum
+ * atteint entre les deux relevés.
+ */
+void relever_allocations( Releve_allocations * releve );
+
+/*
+ * Calcule ce qui s'est passé entre deux relevés : les allocations, les
+ * libérations et la variation des octets vivants (une variation non nulle
+ * après une opération qui devrait tout libérer signale une fuite). Le pic
+ * est le plus grand nombre d'octets alloués en plus de ceux du premier
+ * relevé.
+ */
+void difference_allocations(
+	const Releve_allocations * avant, const Releve_allocations * apres,
+	Releve_allocations * difference
+);
+
+/*
+ * Additionne les compteurs de tous les sous-systèmes. Le pic obtenu est la
+ * somme des pics, qui majore le pic global.
+ */
+void total_allocations(
+	const Releve_allocations * releve, Compteurs_allocation * total
+);
+
+const char * nom_sous_systeme_allocation( Sous_systeme_allocation sous_systeme );
+
+/*
+ * Écrit un relevé (ou une différence), une ligne par sous-système.
+ */
+void afficher_allocations( FILE * sortie, const Releve_allocations * releve );
+
 #define TEST(y,x) { x &= (y); if(!(y)){ fprintf(stdout, "\033[31mEchec du test %s() -- ligne : %d, fichier : %s\033[0m\n", __FUNCTION__, __LINE__, __FILE__ ); } }
 #define TEST1(x) test( x, __LINE__)
 
@@ -0,0 +1,434 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#include "outils.h"
+#include "parcours.h"
+
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+ * Le parcours est synchrone : les fils traitent ensemble une phase, puis le
+ * fil 0 choisit la suivante pendant que les autres attendent à la barrière.
+ *
+ * En descendant, la frontière est une liste d'états, découpée en blocs que
+ * les fils se partagent ; un état est marqué par un « ou » atomique dans
+ * 'visites', et seul le fil qui l'a marqué l'ajoute à la frontière
+ * suivante. En montant, la frontière est un ensemble de bits, et chaque fil
+ * traite des blocs de mots entiers de 'visites' : aucun autre fil n'y
+ * écrit, les marquages se font sans opération atomique.
+ *
+ * Les changements de sens suivent Beamer et al. : on monte quand les
+ * transitions partant de la frontière dépassent le ALPHA-ième de celles
+ * partant des états non atteints, et on redescend quand la frontière,
+ * en décroissance, ne contient plus qu'un BETA-ième des états.
+ */
+
+#define ALPHA 14
+#define BETA 24
+
+#define BLOC_ETATS 256
+#define BLOC_MOTS 16
+
+typedef enum {
+	PHASE_DESCENDANTE,
+	PHASE_MONTANTE,
+	PHASE_COPIER_FRONTIERE,
+	PHASE_EFFACER_FRONTIERE,
+	PHASE_MARQUER_FRONTIERE,
+	PHASE_FIN
+} Phase;
+
+typedef struct _Parcours Parcours;
+
+/* Ce qu'un fil a trouvé pendant la dernière phase de parcours : les états
+ * atteints, et la somme de leurs degrés sortants.
+ */
+typedef struct {
+	Parcours * parcours;
+	int numero;
+	int * trouves;
+	long nb_trouves;
+	long capacite;
+	long degres;
+} Fil_parcours;
+
+struct _Parcours {
+	const Index_automate * graphe;
+	const Index_automate * inverse;
+	size_t nb_mots;
+	uint64_t * visites;
+	uint64_t * frontiere_bits;
+	uint64_t * suivante_bits;
+	int * frontiere;
+	long nb_frontiere;
+	long transitions_restantes;
+	Fil_parcours * fils;
+	long * decalages;
+	int nb_fils;
+	pthread_barrier_t barriere;
+	Phase phase;
+	long prochain;
+};
+
+static long degre( const Index_automate * graphe, int etat ){
+	return graphe->debut[ etat + 1 ] - graphe->debut[ etat ];
+}
+
+static void ajouter_trouve( Fil_parcours * f, int etat ){
+	if( f->nb_trouves == f->capacite ){
+		f->capacite = 2 * f->capacite + 1024;
+		f->trouves = xrealloc( f->trouves, f->capacite * sizeof(int) );
+	}
+	f->trouves[ f->nb_trouves++ ] = etat;
+	f->degres += degre( f->parcours->graphe, etat );
+}
+
+/* Réserve le prochain bloc de 'taille' éléments parmi 'nb'. Renvoie 0
+ * quand il n'en reste plus.
+ */
+static int prendre_bloc( Parcours * p, long taille, long nb, long * debut, long * fin ){
+	*debut = __atomic_fetch_add( &p->prochain, taille, __ATOMIC_RELAXED );
+	if( *debut >= nb ) return 0;
+	*fin = *debut + taille < nb ? *debut + taille : nb;
+	return 1;
+}
+
+static void descendre( Fil_parcours * f ){
+	Parcours * p = f->parcours;
+	const Index_automate * graphe = p->graphe;
+	long debut, fin, k;
+	int t;
+
+	f->nb_trouves = 0;
+	f->degres = 0;
+	while( prendre_bloc( p, BLOC_ETATS, p->nb_frontiere, &debut, &fin ) ){
+		for( k = debut; k < fin; k++ ){
+			int etat = p->frontiere[k];
+			for( t = graphe->debut[ etat ]; t < graphe->debut[ etat + 1 ]; t++ ){
+				int v = graphe->fins[t];
+				uint64_t bit = ( (uint64_t) 1 ) << ( v & 63 );
+				uint64_t * mot = &p->visites[ v >> 6 ];
+				if( __atomic_load_n( mot, __ATOMIC_RELAXED ) & bit ) continue;
+				// Seul, le fil peut se passer de l'opération atomique.
+				if( p->nb_fils == 1 ) *mot |= bit;
+				else if( __atomic_fetch_or( mot, bit, __ATOMIC_RELAXED ) & bit ) continue;
+				ajouter_trouve( f, v );
+			}
+		}
+	}
+}
+
+static void monter( Fil_parcours * f ){
+	Parcours * p = f->parcours;
+	const Index_automate * inverse = p->inverse;
+	int reste = p->graphe->nb_etats & 63;
+	long debut, fin, w;
+	int t;
+
+	f->nb_trouves = 0;
+	f->degres = 0;
+	while( prendre_bloc( p, BLOC_MOTS, p->nb_mots, &debut, &fin ) ){
+		for( w = debut; w < fin; w++ ){
+			uint64_t restants = ~ p->visites[w], nouveaux = 0;
+			if( w == (long) p->nb_mots - 1 && reste ){
+				restants &= ( ( (uint64_t) 1 ) << reste ) - 1;
+			}
+			while( restants ){
+				int b = __builtin_ctzll( restants );
+				int v = w * 64 + b;
+				restants &= restants - 1;
+				for( t = inverse->debut[v]; t < inverse->debut[v+1]; t++ ){
+					if( TESTER_BIT( p->frontiere_bits, inverse->fins[t] ) ){
+						nouveaux |= ( (uint64_t) 1 ) << b;
+						ajouter_trouve( f, v );
+						break;
+					}
+				}
+			}
+			p->visites[w] |= nouveaux;
+			p->suivante_bits[w] = nouveaux;
+		}
+	}
+}
+
+static void executer_phase( Fil_parcours * f ){
+	Parcours * p = f->parcours;
+	long debut, fin, k;
+
+	switch( p->phase ){
+	case PHASE_DESCENDANTE:
+		descendre( f );
+		break;
+	case PHASE_MONTANTE:
+		monter( f );
+		break;
+	case PHASE_COPIER_FRONTIERE:
+		// 'trouves' est NULL tant que le fil n'a rien trouvé.
+		if( f->nb_trouves ){
+			memcpy(
+				p->frontiere + p->decalages[ f->numero ], f->trouves,
+				f->nb_trouves * sizeof(int)
+			);
+		}
+		break;
+	case PHASE_EFFACER_FRONTIERE:
+		while( prendre_bloc( p, BLOC_MOTS, p->nb_mots, &debut, &fin ) ){
+			memset(
+				p->frontiere_bits + debut, 0, ( fin - debut ) * sizeof(uint64_t)
+			);
+		}
+		break;
+	case PHASE_MARQUER_FRONTIERE:
+		for( k = 0; k < f->nb_trouves; k++ ){
+			int v = f->trouves[k];
+			__atomic_fetch_or(
+				&p->frontiere_bits[ v >> 6 ], ( (uint64_t) 1 ) << ( v & 63 ),
+				__ATOMIC_RELAXED
+			);
+		}
+		break;
+	case PHASE_FIN:
+		break;
+	}
+}
+
+/* Choisit la phase suivante. Appelée par le fil 0 seul, entre deux
+ * barrières.
+ */
+static void choisir_phase( Parcours * p ){
+	Phase faite = p->phase;
+	long nb = 0, degres = 0;
+	int i, montante;
+
+	p->prochain = 0;
+	switch( faite ){
+	case PHASE_COPIER_FRONTIERE:
+		p->phase = PHASE_DESCENDANTE;
+		return;
+	case PHASE_EFFACER_FRONTIERE:
+		p->phase = PHASE_MARQUER_FRONTIERE;
+		return;
+	case PHASE_MARQUER_FRONTIERE:
+		p->phase = PHASE_MONTANTE;
+		return;
+	default:
+		break;
+	}
+
+	for( i = 0; i < p->nb_fils; i++ ){
+		nb += p->fils[i].nb_trouves;
+		degres += p->fils[i].degres;
+	}
+	p->transitions_restantes -= degres;
+	if( faite == PHASE_MONTANTE ){
+		uint64_t * echange = p->frontiere_bits;
+		p->frontiere_bits = p->suivante_bits;
+		p->suivante_bits = echange;
+	}
+	if( nb == 0 ){
+		p->phase = PHASE_FIN;
+		return;
+	}
+	if( faite == PHASE_DESCENDANTE ){
+		montante = p->inverse != NULL
+			&& degres > p->transitions_restantes / ALPHA;
+	}else{
+		montante = nb >= p->graphe->nb_etats / BETA || nb >= p->nb_frontiere;
+	}
+	p->nb_frontiere = nb;
+	if( montante ){
+		p->phase = faite == PHASE_MONTANTE ?
+			PHASE_MONTANTE : PHASE_EFFACER_FRONTIERE;
+	}else{
+		p->decalages[0] = 0;
+		for( i = 1; i < p->nb_fils; i++ ){
+			p->decalages[i] = p->decalages[i-1] + p->fils[i-1].nb_trouves;
+		}
+		p->phase = PHASE_COPIER_FRONTIERE;
+	}
+}
+
+static void * parcourir( void * donnees ){
+	Fil_parcours * f = donnees;
+	Parcours * p = f->parcours;
+
+	while( p->phase != PHASE_FIN ){
+		executer_phase( f );
+		pthread_barrier_wait( &p->barriere );
+		if( f->numero == 0 ) choisir_phase( p );
+		pthread_barrier_wait( &p->barriere );
+	}
+	return NULL;
+}
+
+void parcourir_en_largeur(
+	const Index_automate * index, const Index_automate * miroir,
+	const uint64_t * depart, uint64_t * atteints, int nb_fils
+){
+	Parcours p;
+	pthread_t * fils;
+	int i, v;
+
+	if( nb_fils <= 0 ) nb_fils = sysconf( _SC_NPROCESSORS_ONLN );
+	if( nb_fils <= 0 ) nb_fils = 1;
+	p.graphe = index;
+	p.inverse = miroir;
+	p.nb_mots = NB_MOTS_BITS( index->nb_etats );
+	p.visites = atteints;
+	memmove( atteints, depart, p.nb_mots * sizeof(uint64_t) );
+	p.frontiere_bits = xmalloc( ( p.nb_mots + 1 ) * sizeof(uint64_t) );
+	p.suivante_bits = xmalloc( ( p.nb_mots + 1 ) * sizeof(uint64_t) );
+	p.frontiere = xmalloc( ( index->nb_etats + 1 ) * sizeof(int) );
+	p.nb_frontiere = 0;
+	p.transitions_restantes = index->nb_transitions;
+	for( v = 0; v < index->nb_etats; v++ ){
+		if( TESTER_BIT( atteints, v ) ){
+			p.frontiere[ p.nb_frontiere++ ] = v;
+			p.transitions_restantes -= degre( index, v );
+		}
+	}
+	p.phase = p.nb_frontiere ? PHASE_DESCENDANTE : PHASE_FIN;
+	p.prochain = 0;
+	p.nb_fils = nb_fils;
+	p.fils = xmalloc( nb_fils * sizeof(Fil_parcours) );
+	p.decalages = xmalloc( nb_fils * sizeof(long) );
+	memset( p.fils, 0, nb_fils * sizeof(Fil_parcours) );
+	pthread_barrier_init( &p.barriere, NULL, nb_fils );
+
+	fils = xmalloc( nb_fils * sizeof(pthread_t) );
+	for( i = 0; i < nb_fils; i++ ){
+		p.fils[i].parcours = &p;
+		p.fils[i].numero = i;
+	}
+	for( i = 1; i < nb_fils; i++ ){
+		if( pthread_create( &fils[i], NULL, parcourir, &p.fils[i] ) ){
+			ERREUR( "Impossible de creer un fil d'execution" );
+		}
+	}
+	parcourir( &p.fils[0] );
+	for( i = 1; i < nb_fils; i++ ) pthread_join( fils[i], NULL );
+
+	for( i = 0; i < nb_fils; i++ ) xfree( p.fils[i].trouves );
+	pthread_barrier_destroy( &p.barriere );
+	xfree( fils );
+	xfree( p.decalages );
+	xfree( p.fils );
+	xfree( p.frontiere );
+	xfree( p.suivante_bits );
+	xfree( p.frontiere_bits );
+}
+
+uint64_t * etats_accessibles_index(
+	const Index_automate * index, const Index_automate * miroir, int nb_fils
+){
+	uint64_t * res = xmalloc(
+		( NB_MOTS_BITS( index->nb_etats ) + 1 ) * sizeof(uint64_t)
+	);
+	Index_automate * construit = NULL;
+	if( ! miroir ) miroir = construit = creer_index_miroir( index );
+	parcourir_en_largeur( index, miroir, index->initiaux, res, nb_fils );
+	if( construit ) liberer_index_automate( construit );
+	return res;
+}
+
+uint64_t * etats_co_accessibles_index(
+	const Index_automate * index, const Index_automate * miroir, int nb_fils
+){
+	uint64_t * res = xmalloc(
+		( NB_MOTS_BITS( index->nb_etats ) + 1 ) * sizeof(uint64_t)
+	);
+	Index_automate * construit = NULL;
+	if( ! miroir ) miroir = construit = creer_index_miroir( index );
+	parcourir_en_largeur( miroir, index, index->finaux, res, nb_fils );
+	if( construit ) liberer_index_automate( construit );
+	return res;
+}
+
+Automate * restreindre_automate(
+	const Index_automate * index, const uint64_t * gardes,
+	int garder_alphabet
+){
+	Automate * res = creer_automate();
+	int * origines = xmalloc( ( index->nb_transitions + 1 ) * sizeof(int) );
+	char * lettres = xmalloc( index->nb_transitions + 1 );
+	int * fins = xmalloc( ( index->nb_transitions + 1 ) * sizeof(int) );
+	size_t nb = 0;
+	int i, t;
+
+	// Les transitions sont produites dans l'ordre de l'index, qui est
+	// celui attendu par ajouter_transitions_en_bloc().
+	for( i = 0; i < index->nb_etats; i++ ){
+		if( ! TESTER_BIT( gardes, i ) ) continue;
+		for( t = index->debut[i]; t < index->debut[i+1]; t++ ){
+			if( ! TESTER_BIT( gardes, index->fins[t] ) ) continue;
+			origines[nb] = index->noms[i];
+			lettres[nb] = index->lettres[t];
+			fins[nb] = index->noms[ index->fins[t] ];
+			nb++;
+		}
+	}
+	if( garder_alphabet ){
+		for( i = 0; i < index->taille_alphabet; i++ ){
+			ajouter_lettre( res, index->alphabet[i] );
+		}
+	}
+	ajouter_transitions_en_bloc( res, origines, lettres, fins, nb );
+	for( i = 0; i < index->nb_etats; i++ ){
+		if( ! TESTER_BIT( gardes, i ) ) continue;
+		ajouter_etat( res, index->noms[i] );
+		if( TESTER_BIT( index->initiaux, i ) ){
+			ajouter_etat_initial( res, index->noms[i] );
+		}
+		if( TESTER_BIT( index->finaux, i ) ){
+			ajouter_etat_final( res, index->noms[i] );
+		}
+	}
+
+	xfree( origines );
+	xfree( lettres );
+	xfree( fins );
+	return res;
+}
+
+Automate * automate_emonde( const Automate * automate, int nb_fils ){
+	Index_automate * index = creer_index_automate( automate );
+	Index_automate * miroir = creer_index_miroir( index );
+	uint64_t * gardes = etats_accessibles_index( index, miroir, nb_fils );
+	uint64_t * co_accessibles = etats_co_accessibles_index(
+		index, miroir, nb_fils
+	);
+	Automate * res;
+	size_t w;
+
+	for( w = 0; w < NB_MOTS_BITS( index->nb_etats ); w++ ){
+		gardes[w] &= co_accessibles[w];
+	}
+	res = restreindre_automate( index, gardes, 1 );
+
+	xfree( co_accessibles );
+	xfree( gardes );
+	liberer_index_automate( miroir );
+	liberer_index_automate( index );
+	return res;
+}
@@ -0,0 +1,115 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+
+#ifndef __PARCOURS_H__
+#define __PARCOURS_H__
+
+#include <stdint.h>
+
+#include "automate.h"
+#include "index_automate.h"
+
+/**
+ * \brief Marque dans 'atteints' les états atteints depuis ceux de 'depart'
+ *        par un parcours en largeur de l'index, réparti sur 'nb_fils' fils
+ *        d'exécution.
+ *
+ * Le parcours avance niveau par niveau. Tant que la frontière est petite,
+ * chaque fil prend une partie des états de la frontière et marque leurs
+ * successeurs (parcours descendant). Quand les transitions partant de la
+ * frontière deviennent nombreuses devant celles des états non encore
+ * atteints, chaque fil prend une tranche des états non atteints et cherche
+ * parmi leurs prédécesseurs un état de la frontière (parcours montant,
+ * d'après Beamer et al.), ce qui évite de suivre les transitions vers des
+ * états déjà atteints.
+ *
+ * Le parcours montant utilise 'miroir', l'index miroir de 'index' (voir
+ * creer_index_miroir()). Si 'miroir' est NULL, le parcours est toujours
+ * descendant.
+ *
+ * \param index Un index
+ * \param miroir L'index miroir de 'index', ou NULL
+ * \param depart Les états de départ, en NB_MOTS_BITS( nb_etats ) mots
+ * \param atteints Les états atteints, départ compris, en NB_MOTS_BITS(
+ *        nb_etats ) mots
+ * \param nb_fils Le nombre de fils (tous les cœurs si nb_fils <= 0)
+ */
+void parcourir_en_largeur(
+	const Index_automate * index, const Index_automate * miroir,
+	const uint64_t * depart, uint64_t * atteints, int nb_fils
+);
+
+/**
+ * \brief Renvoie les états accessibles depuis un état initial de l'index.
+ *
+ * Voir parcourir_en_largeur(). Si 'miroir' est NULL, il est construit puis
+ * libéré ; le passer évite de le reconstruire à chaque appel.
+ *
+ * \return Un ensemble de bits de NB_MOTS_BITS( nb_etats ) mots, à libérer
+ *         avec xfree()
+ */
+uint64_t * etats_accessibles_index(
+	const Index_automate * index, const Index_automate * miroir, int nb_fils
+);
+
+/**
+ * \brief Renvoie les états de l'index depuis lesquels un état final est
+ *        accessible.
+ *
+ * Voir etats_accessibles_index().
+ */
+uint64_t * etats_co_accessibles_index(
+	const Index_automate * index, const Index_automate * miroir, int nb_fils
+);
+
+/**
+ * \brief Renvoie l'automate formé des états de 'gardes' et des transitions
+ *        entre eux.
+ *
+ * Les états gardent leurs noms, ainsi que leur qualité d'état initial ou
+ * final. Si 'garder_alphabet' est nul, l'alphabet du résultat se réduit
+ * aux lettres de ses transitions.
+ *
+ * \param index Un index
+ * \param gardes Les états gardés, en NB_MOTS_BITS( nb_etats ) mots
+ * \param garder_alphabet Non nul pour recopier tout l'alphabet de l'index
+ * \return Un nouvel automate
+ */
+Automate * restreindre_automate(
+	const Index_automate * index, const uint64_t * gardes,
+	int garder_alphabet
+);
+
+/**
+ * \brief Renvoie l'automate émondé : seuls les états à la fois accessibles
+ *        et co-accessibles, et les transitions entre eux, sont gardés.
+ *
+ * Les états gardent leurs noms et l'alphabet est conservé. Les deux
+ * parcours sont faits par parcourir_en_largeur() avec 'nb_fils' fils.
+ *
+ * \param automate Un automate
+ * \param nb_fils Le nombre de fils (tous les cœurs si nb_fils <= 0)
+ * \return L'automate émondé
+ */
+Automate * automate_emonde( const Automate * automate, int nb_fils );
+
+#endif
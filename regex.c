@@ -0,0 +1,751 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "regex.h"
+#include "determinisation.h"
+#include "outils.h"
+#include "utf8.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef enum {
+	NOEUD_MOT_VIDE,
+	NOEUD_LETTRES,
+	NOEUD_CONCATENATION,
+	NOEUD_UNION,
+	NOEUD_ETOILE,
+	NOEUD_PLUS,
+	NOEUD_OPTION
+} Type_noeud;
+
+/*
+ * Les noeuds de l'arbre syntaxique sont rangés dans un tableau. Pour un noeud
+ * NOEUD_LETTRES, 'gauche' est le numéro de sa classe de lettres ; pour les
+ * opérateurs unaires, seul 'gauche' est utilisé.
+ */
+typedef struct {
+	Type_noeud type;
+	int gauche;
+	int droite;
+} Noeud;
+
+typedef struct {
+	uint64_t bits[4];
+} Classe_lettres;
+
+/*
+ * Un intervalle de points de code [debut, fin], tel qu'il est écrit dans une
+ * classe '[...]'.
+ */
+typedef struct {
+	uint32_t debut;
+	uint32_t fin;
+} Intervalle_points;
+
+typedef struct {
+	Noeud * noeuds;
+	int nb_noeuds;
+	int capacite_noeuds;
+	Classe_lettres * classes;
+	int nb_classes;
+	int capacite_classes;
+	Intervalle_points * intervalles;
+	int nb_intervalles;
+	int capacite_intervalles;
+	int racine;
+	const char * courant;
+} Expression;
+
+static int nouveau_noeud( Expression * e, Type_noeud type, int gauche, int droite ){
+	if( e->nb_noeuds == e->capacite_noeuds ){
+		e->capacite_noeuds *= 2;
+		e->noeuds = xrealloc( e->noeuds, e->capacite_noeuds * sizeof(Noeud) );
+	}
+	e->noeuds[ e->nb_noeuds ].type = type;
+	e->noeuds[ e->nb_noeuds ].gauche = gauche;
+	e->noeuds[ e->nb_noeuds ].droite = droite;
+	return e->nb_noeuds++;
+}
+
+static Classe_lettres * nouvelle_classe( Expression * e ){
+	Classe_lettres * res;
+	if( e->nb_classes == e->capacite_classes ){
+		e->capacite_classes *= 2;
+		e->classes = xrealloc(
+			e->classes, e->capacite_classes * sizeof(Classe_lettres)
+		);
+	}
+	res = e->classes + e->nb_classes++;
+	memset( res, 0, sizeof(Classe_lettres) );
+	return res;
+}
+
+#define AJOUTER_LETTRE_CLASSE(classe,c) \
+	( (classe)->bits[ (c) >> 6 ] |= (uint64_t) 1 << ( (c) & 63 ) )
+
+static int analyser_union( Expression * e );
+
+/* Lit un caractère, éventuellement échappé, et renvoie son point de code
+ * (non nul), ou renvoie -1 à la fin de l'expression ou si le caractère n'est
+ * pas de l'UTF-8 valide.
+ */
+static int lire_caractere( Expression * e ){
+	unsigned char c = (unsigned char) *e->courant;
+	uint32_t code_point;
+	int longueur;
+	if( c == '\0' ) return -1;
+	if( c == '\\' ){
+		e->courant++;
+		c = (unsigned char) *e->courant;
+		if( c == '\0' ) return -1;
+		if( c == 'n' || c == 't' ){
+			e->courant++;
+			return ( c == 'n' ) ? '\n' : '\t';
+		}
+	}
+	longueur = decoder_utf8( e->courant, &code_point );
+	if( longueur == 0 ) return -1;
+	e->courant += longueur;
+	return code_point;
+}
+
+static void ajouter_intervalle( Expression * e, uint32_t debut, uint32_t fin ){
+	if( e->nb_intervalles == e->capacite_intervalles ){
+		e->capacite_intervalles *= 2;
+		e->intervalles = xrealloc(
+			e->intervalles,
+			e->capacite_intervalles * sizeof(Intervalle_points)
+		);
+	}
+	e->intervalles[ e->nb_intervalles ].debut = debut;
+	e->intervalles[ e->nb_intervalles ].fin = fin;
+	e->nb_intervalles++;
+}
+
+static int comparer_intervalles( const void * a, const void * b ){
+	uint32_t x = ( (const Intervalle_points *) a )->debut;
+	uint32_t y = ( (const Intervalle_points *) b )->debut;
+	return ( x > y ) - ( x < y );
+}
+
+/* Trie et fusionne les intervalles lus, puis les remplace par leur
+ * complémentaire dans [1, CODE_POINT_MAX] si 'negation' est non nul.
+ */
+static void normaliser_intervalles( Expression * e, int negation ){
+	int i, n = 0;
+	qsort(
+		e->intervalles, e->nb_intervalles, sizeof(Intervalle_points),
+		comparer_intervalles
+	);
+	for( i = 0; i < e->nb_intervalles; i++ ){
+		if( n > 0 && e->intervalles[i].debut <= e->intervalles[n-1].fin + 1 ){
+			if( e->intervalles[i].fin > e->intervalles[n-1].fin )
+				e->intervalles[n-1].fin = e->intervalles[i].fin;
+		}else{
+			e->intervalles[n++] = e->intervalles[i];
+		}
+	}
+	e->nb_intervalles = n;
+	if( negation ){
+		uint32_t suivant = 1;
+		e->nb_intervalles = 0;
+		for( i = 0; i < n; i++ ){
+			Intervalle_points intervalle = e->intervalles[i];
+			// Le complémentaire a au plus un intervalle de plus : on écrit
+			// derrière ceux qui restent à lire.
+			if( intervalle.debut > suivant ){
+				e->intervalles[ e->nb_intervalles ].debut = suivant;
+				e->intervalles[ e->nb_intervalles ].fin = intervalle.debut - 1;
+				e->nb_intervalles++;
+			}
+			suivant = intervalle.fin + 1;
+		}
+		if( suivant <= CODE_POINT_MAX ){
+			ajouter_intervalle( e, suivant, CODE_POINT_MAX );
+		}
+	}
+}
+
+static int noeud_octets( Expression * e, unsigned char debut, unsigned char fin ){
+	int numero = e->nb_classes, c;
+	Classe_lettres * classe = nouvelle_classe( e );
+	for( c = debut; c <= fin; c++ ) AJOUTER_LETTRE_CLASSE( classe, c );
+	return nouveau_noeud( e, NOEUD_LETTRES, numero, -1 );
+}
+
+typedef struct {
+	Expression * expression;
+	int res;
+} Donnees_sequences;
+
+static void ajouter_noeud_sequence(
+	const Intervalle_octets * sequence, int longueur, void * data
+){
+	Donnees_sequences * d = (Donnees_sequences *) data;
+	Expression * e = d->expression;
+	int noeud = noeud_octets( e, sequence[0].debut, sequence[0].fin ), i;
+	for( i = 1; i < longueur; i++ ){
+		noeud = nouveau_noeud(
+			e, NOEUD_CONCATENATION, noeud,
+			noeud_octets( e, sequence[i].debut, sequence[i].fin )
+		);
+	}
+	d->res = ( d->res < 0 ) ? noeud
+		: nouveau_noeud( e, NOEUD_UNION, d->res, noeud );
+}
+
+/* Renvoie un noeud qui reconnaît les encodages UTF-8 des points de code des
+ * intervalles lus : les caractères ASCII forment une seule classe de lettres,
+ * les autres une union de concaténations de classes d'octets. Renvoie -1 si
+ * les intervalles sont vides.
+ */
+static int noeud_intervalles( Expression * e ){
+	Donnees_sequences d;
+	uint32_t c, fin;
+	int i;
+	d.expression = e;
+	d.res = -1;
+	for( i = 0; i < e->nb_intervalles && e->intervalles[i].debut < 0x80; i++ ){
+		if( d.res < 0 ){
+			d.res = e->nb_classes;
+			nouvelle_classe( e );
+		}
+		fin = ( e->intervalles[i].fin < 0x80 ) ? e->intervalles[i].fin : 0x7F;
+		for( c = e->intervalles[i].debut; c <= fin; c++ ){
+			AJOUTER_LETTRE_CLASSE( e->classes + d.res, c );
+		}
+	}
+	if( d.res >= 0 ) d.res = nouveau_noeud( e, NOEUD_LETTRES, d.res, -1 );
+	for( i = 0; i < e->nb_intervalles; i++ ){
+		if( e->intervalles[i].fin < 0x80 ) continue;
+		pour_toute_sequence_utf8(
+			e->intervalles[i].debut < 0x80 ? 0x80 : e->intervalles[i].debut,
+			e->intervalles[i].fin, ajouter_noeud_sequence, &d
+		);
+	}
+	return d.res;
+}
+
+static int analyser_classe( Expression * e ){
+	int negation = 0;
+
+	if( *e->courant == '^' ){
+		negation = 1;
+		e->courant++;
+	}
+	e->nb_intervalles = 0;
+	while( *e->courant != ']' ){
+		int debut = lire_caractere( e ), fin;
+		if( debut < 0 ) return -1;
+		fin = debut;
+		if( e->courant[0] == '-' && e->courant[1] != ']' && e->courant[1] != '\0' ){
+			e->courant++;
+			fin = lire_caractere( e );
+			if( fin < debut ) return -1;
+		}
+		ajouter_intervalle( e, debut, fin );
+	}
+	e->courant++;
+	if( e->nb_intervalles == 0 ) return -1;
+	normaliser_intervalles( e, negation );
+	return noeud_intervalles( e );
+}
+
+static int analyser_atome( Expression * e ){
+	int numero, c;
+	switch( *e->courant ){
+	case '(' :
+		e->courant++;
+		numero = analyser_union( e );
+		if( numero < 0 || *e->courant != ')' ) return -1;
+		e->courant++;
+		return numero;
+	case '[' :
+		e->courant++;
+		return analyser_classe( e );
+	case ')' : case '*' : case '+' : case '?' : case '|' : case ']' :
+		return -1;
+	}
+	c = lire_caractere( e );
+	if( c < 0 ) return -1;
+	if( c < 0x80 ){
+		numero = e->nb_classes;
+		AJOUTER_LETTRE_CLASSE( nouvelle_classe( e ), c );
+		return nouveau_noeud( e, NOEUD_LETTRES, numero, -1 );
+	}
+	e->nb_intervalles = 0;
+	ajouter_intervalle( e, c, c );
+	return noeud_intervalles( e );
+}
+
+static int analyser_repetition( Expression * e ){
+	int res = analyser_atome( e );
+	while( res >= 0 ){
+		switch( *e->courant ){
+		case '*' : res = nouveau_noeud( e, NOEUD_ETOILE, res, -1 ); break;
+		case '+' : res = nouveau_noeud( e, NOEUD_PLUS, res, -1 ); break;
+		case '?' : res = nouveau_noeud( e, NOEUD_OPTION, res, -1 ); break;
+		default : return res;
+		}
+		e->courant++;
+	}
+	return res;
+}
+
+static int analyser_concatenation( Expression * e ){
+	int res = -1;
+	while( *e->courant && *e->courant != '|' && *e->courant != ')' ){
+		int suivant = analyser_repetition( e );
+		if( suivant < 0 ) return -1;
+		res = ( res < 0 ) ? suivant
+			: nouveau_noeud( e, NOEUD_CONCATENATION, res, suivant );
+	}
+	if( res < 0 ) res = nouveau_noeud( e, NOEUD_MOT_VIDE, -1, -1 );
+	return res;
+}
+
+static int analyser_union( Expression * e ){
+	int res = analyser_concatenation( e );
+	while( res >= 0 && *e->courant == '|' ){
+		int droite;
+		e->courant++;
+		droite = analyser_concatenation( e );
+		if( droite < 0 ) return -1;
+		res = nouveau_noeud( e, NOEUD_UNION, res, droite );
+	}
+	return res;
+}
+
+static void liberer_expression( Expression * e ){
+	if( e ){
+		xfree( e->noeuds );
+		xfree( e->classes );
+		xfree( e->intervalles );
+		xfree( e );
+	}
+}
+
+/* Renvoie l'arbre syntaxique de l'expression, ou NULL si elle est mal
+ * formée.
+ */
+static Expression * analyser_expression( const char * expression ){
+	Expression * res = xmalloc( sizeof(Expression) );
+	res->nb_noeuds = 0;
+	res->capacite_noeuds = 16;
+	res->noeuds = xmalloc( res->capacite_noeuds * sizeof(Noeud) );
+	res->nb_classes = 0;
+	res->capacite_classes = 16;
+	res->classes = xmalloc( res->capacite_classes * sizeof(Classe_lettres) );
+	res->nb_intervalles = 0;
+	res->capacite_intervalles = 16;
+	res->intervalles = xmalloc(
+		res->capacite_intervalles * sizeof(Intervalle_points)
+	);
+	res->courant = expression;
+	res->racine = analyser_union( res );
+	if( res->racine < 0 || *res->courant != '\0' ){
+		liberer_expression( res );
+		return NULL;
+	}
+	return res;
+}
+
+/* Ajoute les transitions de l'état 'origine' vers l'état 'fin', étiquetées
+ * par les lettres d'une classe.
+ */
+static void ajouter_transitions_classe(
+	Automate * automate, int origine, const Classe_lettres * classe, int fin
+){
+	int i;
+	for( i = 0; i < 4; i++ ){
+		uint64_t bits = classe->bits[i];
+		while( bits ){
+			int c = 64 * i + __builtin_ctzll( bits );
+			bits &= bits - 1;
+			ajouter_transition( automate, origine, (char) c, fin );
+		}
+	}
+}
+
+/*
+ * Construction de Glushkov. Pour chaque sous-expression, on calcule si elle
+ * reconnaît le mot vide, et les positions par lesquelles ses mots peuvent
+ * commencer et finir. Les transitions entre positions consécutives sont
+ * ajoutées au fur et à mesure (concaténations et répétitions).
+ */
+typedef struct {
+	int * positions;
+	int nb;
+	int capacite;
+} Liste_positions;
+
+typedef struct {
+	int annulable;
+	Liste_positions premieres;
+	Liste_positions dernieres;
+} Resultat_glushkov;
+
+static void initialiser_liste( Liste_positions * l ){
+	l->nb = 0;
+	l->capacite = 0;
+	l->positions = NULL;
+}
+
+static void ajouter_liste( Liste_positions * l, const Liste_positions * autre ){
+	// Une liste vide peut ne pas avoir de tableau.
+	if( autre->nb == 0 ) return;
+	if( l->nb + autre->nb > l->capacite ){
+		l->capacite = 2 * ( l->nb + autre->nb );
+		l->positions = xrealloc( l->positions, l->capacite * sizeof(int) );
+	}
+	memcpy( l->positions + l->nb, autre->positions, autre->nb * sizeof(int) );
+	l->nb += autre->nb;
+}
+
+typedef struct {
+	const Expression * expression;
+	Automate * automate;
+	int nb_positions;
+	int capacite_positions;
+	int * classes;
+} Donnees_glushkov;
+
+static void relier_positions(
+	Donnees_glushkov * d, const Liste_positions * dernieres,
+	const Liste_positions * premieres
+){
+	int i, j;
+	for( i = 0; i < dernieres->nb; i++ ){
+		for( j = 0; j < premieres->nb; j++ ){
+			int q = premieres->positions[j];
+			ajouter_transitions_classe(
+				d->automate, dernieres->positions[i],
+				d->expression->classes + d->classes[q], q
+			);
+		}
+	}
+}
+
+static Resultat_glushkov glushkov( Donnees_glushkov * d, int numero ){
+	const Noeud * noeud = d->expression->noeuds + numero;
+	Resultat_glushkov res, droite;
+	int p;
+
+	switch( noeud->type ){
+	case NOEUD_MOT_VIDE :
+		res.annulable = 1;
+		initialiser_liste( &res.premieres );
+		initialiser_liste( &res.dernieres );
+		break;
+	case NOEUD_LETTRES :
+		p = ++d->nb_positions;
+		if( p >= d->capacite_positions ){
+			d->capacite_positions *= 2;
+			d->classes = xrealloc( d->classes, d->capacite_positions * sizeof(int) );
+		}
+		d->classes[p] = noeud->gauche;
+		ajouter_etat( d->automate, p );
+		res.annulable = 0;
+		res.premieres.nb = res.dernieres.nb = 1;
+		res.premieres.capacite = res.dernieres.capacite = 1;
+		res.premieres.positions = xmalloc( sizeof(int) );
+		res.dernieres.positions = xmalloc( sizeof(int) );
+		res.premieres.positions[0] = res.dernieres.positions[0] = p;
+		break;
+	case NOEUD_UNION :
+		res = glushkov( d, noeud->gauche );
+		droite = glushkov( d, noeud->droite );
+		res.annulable |= droite.annulable;
+		ajouter_liste( &res.premieres, &droite.premieres );
+		ajouter_liste( &res.dernieres, &droite.dernieres );
+		xfree( droite.premieres.positions );
+		xfree( droite.dernieres.positions );
+		break;
+	case NOEUD_CONCATENATION :
+		res = glushkov( d, noeud->gauche );
+		droite = glushkov( d, noeud->droite );
+		relier_positions( d, &res.dernieres, &droite.premieres );
+		if( res.annulable ) ajouter_liste( &res.premieres, &droite.premieres );
+		if( droite.annulable ) ajouter_liste( &droite.dernieres, &res.dernieres );
+		xfree( res.dernieres.positions );
+		res.dernieres = droite.dernieres;
+		res.annulable &= droite.annulable;
+		xfree( droite.premieres.positions );
+		break;
+	default :
+		res = glushkov( d, noeud->gauche );
+		if( noeud->type != NOEUD_OPTION ){
+			relier_positions( d, &res.dernieres, &res.premieres );
+		}
+		if( noeud->type != NOEUD_PLUS ) res.annulable = 1;
+		break;
+	}
+	return res;
+}
+
+static Automate * construire_glushkov( const Expression * e ){
+	Donnees_glushkov d;
+	Resultat_glushkov r;
+	Liste_positions initial;
+	int zero = 0, i;
+
+	d.expression = e;
+	d.automate = creer_automate();
+	d.nb_positions = 0;
+	d.capacite_positions = 16;
+	d.classes = xmalloc( d.capacite_positions * sizeof(int) );
+	ajouter_etat( d.automate, 0 );
+	ajouter_etat_initial( d.automate, 0 );
+
+	r = glushkov( &d, e->racine );
+	initial.positions = &zero;
+	initial.nb = 1;
+	relier_positions( &d, &initial, &r.premieres );
+	for( i = 0; i < r.dernieres.nb; i++ ){
+		ajouter_etat_final( d.automate, r.dernieres.positions[i] );
+	}
+	if( r.annulable ) ajouter_etat_final( d.automate, 0 );
+
+	xfree( r.premieres.positions );
+	xfree( r.dernieres.positions );
+	xfree( d.classes );
+	return d.automate;
+}
+
+/*
+ * Construction de Thompson. Chaque état a au plus deux epsilon-transitions,
+ * ou une transition étiquetée par une classe de lettres. Un fragment a un
+ * état d'entrée et un état de sortie, qui n'a aucune transition sortante.
+ */
+typedef struct {
+	int epsilon[2];
+	int classe;
+	int cible;
+} Etat_thompson;
+
+typedef struct {
+	const Expression * expression;
+	Etat_thompson * etats;
+	int nb_etats;
+	int capacite_etats;
+} Donnees_thompson;
+
+typedef struct {
+	int entree;
+	int sortie;
+} Fragment;
+
+static int nouvel_etat_thompson( Donnees_thompson * d ){
+	if( d->nb_etats == d->capacite_etats ){
+		d->capacite_etats *= 2;
+		d->etats = xrealloc( d->etats, d->capacite_etats * sizeof(Etat_thompson) );
+	}
+	d->etats[ d->nb_etats ].epsilon[0] = -1;
+	d->etats[ d->nb_etats ].epsilon[1] = -1;
+	d->etats[ d->nb_etats ].classe = -1;
+	d->etats[ d->nb_etats ].cible = -1;
+	return d->nb_etats++;
+}
+
+static void ajouter_epsilon( Donnees_thompson * d, int origine, int fin ){
+	Etat_thompson * e = d->etats + origine;
+	e->epsilon[ ( e->epsilon[0] < 0 ) ? 0 : 1 ] = fin;
+}
+
+static Fragment thompson( Donnees_thompson * d, int numero ){
+	const Noeud * noeud = d->expression->noeuds + numero;
+	Fragment res, f, g;
+
+	switch( noeud->type ){
+	case NOEUD_MOT_VIDE :
+		res.entree = res.sortie = nouvel_etat_thompson( d );
+		break;
+	case NOEUD_LETTRES :
+		res.entree = nouvel_etat_thompson( d );
+		res.sortie = nouvel_etat_thompson( d );
+		d->etats[ res.entree ].classe = noeud->gauche;
+		d->etats[ res.entree ].cible = res.sortie;
+		break;
+	case NOEUD_CONCATENATION :
+		f = thompson( d, noeud->gauche );
+		g = thompson( d, noeud->droite );
+		ajouter_epsilon( d, f.sortie, g.entree );
+		res.entree = f.entree;
+		res.sortie = g.sortie;
+		break;
+	case NOEUD_UNION :
+		f = thompson( d, noeud->gauche );
+		g = thompson( d, noeud->droite );
+		res.entree = nouvel_etat_thompson( d );
+		res.sortie = nouvel_etat_thompson( d );
+		ajouter_epsilon( d, res.entree, f.entree );
+		ajouter_epsilon( d, res.entree, g.entree );
+		ajouter_epsilon( d, f.sortie, res.sortie );
+		ajouter_epsilon( d, g.sortie, res.sortie );
+		break;
+	default :
+		f = thompson( d, noeud->gauche );
+		res.entree = nouvel_etat_thompson( d );
+		res.sortie = nouvel_etat_thompson( d );
+		ajouter_epsilon( d, res.entree, f.entree );
+		ajouter_epsilon( d, f.sortie, res.sortie );
+		if( noeud->type != NOEUD_PLUS ){
+			ajouter_epsilon( d, res.entree, res.sortie );
+		}
+		if( noeud->type != NOEUD_OPTION ){
+			ajouter_epsilon( d, f.sortie, f.entree );
+		}
+		break;
+	}
+	return res;
+}
+
+/* Supprime les epsilon-transitions : depuis chaque état gardé, on suit les
+ * transitions étiquetées de tous les états de sa epsilon-fermeture.
+ */
+static Automate * construire_thompson( const Expression * e ){
+	Automate * res = creer_automate();
+	Donnees_thompson d;
+	Fragment f;
+	int * pile, * vus, * gardes;
+	int s, i;
+
+	d.expression = e;
+	d.nb_etats = 0;
+	d.capacite_etats = 16;
+	d.etats = xmalloc( d.capacite_etats * sizeof(Etat_thompson) );
+	f = thompson( &d, e->racine );
+
+	pile = xmalloc( d.nb_etats * sizeof(int) );
+	vus = xmalloc( d.nb_etats * sizeof(int) );
+	gardes = xmalloc( d.nb_etats * sizeof(int) );
+	memset( gardes, 0, d.nb_etats * sizeof(int) );
+	gardes[ f.entree ] = 1;
+	for( s = 0; s < d.nb_etats; s++ ){
+		vus[s] = -1;
+		if( d.etats[s].cible >= 0 ) gardes[ d.etats[s].cible ] = 1;
+	}
+
+	ajouter_etat( res, f.entree );
+	ajouter_etat_initial( res, f.entree );
+	for( s = 0; s < d.nb_etats; s++ ){
+		int sommet = 0;
+		if( ! gardes[s] ) continue;
+		ajouter_etat( res, s );
+		pile[ sommet++ ] = s;
+		vus[s] = s;
+		while( sommet > 0 ){
+			const Etat_thompson * u = d.etats + pile[ --sommet ];
+			if( u - d.etats == f.sortie ) ajouter_etat_final( res, s );
+			if( u->classe >= 0 ){
+				ajouter_transitions_classe(
+					res, s, e->classes + u->classe, u->cible
+				);
+			}
+			for( i = 0; i < 2; i++ ){
+				int v = u->epsilon[i];
+				if( v >= 0 && vus[v] != s ){
+					vus[v] = s;
+					pile[ sommet++ ] = v;
+				}
+			}
+		}
+	}
+
+	xfree( pile );
+	xfree( vus );
+	xfree( gardes );
+	xfree( d.etats );
+	return res;
+}
+
+static Automate * construire_automate(
+	const Expression * e, Construction_expression construction
+){
+	if( construction == CONSTRUCTION_THOMPSON ) return construire_thompson( e );
+	return construire_glushkov( e );
+}
+
+Automate * expression_vers_automate_par(
+	const char * expression, Construction_expression construction
+){
+	Expression * e = analyser_expression( expression );
+	Automate * res;
+	if( ! e ) return NULL;
+	res = construire_automate( e, construction );
+	liberer_expression( e );
+	return res;
+}
+
+Automate * expression_vers_automate( const char * expression ){
+	return expression_vers_automate_par( expression, CONSTRUCTION_GLUSHKOV );
+}
+
+static double maintenant(){
+	struct timespec t;
+	clock_gettime( CLOCK_MONOTONIC, &t );
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+Automate_compile * compiler_expression(
+	const char * expression, Construction_expression construction,
+	Temps_compilation * temps
+){
+	Temps_compilation t;
+	Expression * e;
+	Automate * automate, * deterministe, * minimal;
+	Automate_compile * res;
+	double debut = maintenant(), fin;
+
+	e = analyser_expression( expression );
+	fin = maintenant();
+	t.analyse = fin - debut;
+	if( ! e ) return NULL;
+
+	debut = fin;
+	automate = construire_automate( e, construction );
+	liberer_expression( e );
+	fin = maintenant();
+	t.construction = fin - debut;
+
+	debut = fin;
+	deterministe = creer_automate_deterministe( automate );
+	fin = maintenant();
+	t.determinisation = fin - debut;
+
+	debut = fin;
+	minimal = creer_automate_minimal( deterministe );
+	fin = maintenant();
+	t.minimisation = fin - debut;
+
+	debut = fin;
+	res = compiler_automate( minimal );
+	fin = maintenant();
+	t.compilation = fin - debut;
+
+	liberer_automate( automate );
+	liberer_automate( deterministe );
+	liberer_automate( minimal );
+	if( temps ) *temps = t;
+	return res;
+}
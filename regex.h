@@ -0,0 +1,110 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __REGEX_H__
+#define __REGEX_H__
+
+#include "automate.h"
+#include "automate_compile.h"
+
+/**
+ * \brief Les constructions possibles d'un automate à partir d'une expression
+ *        rationnelle.
+ *
+ * CONSTRUCTION_GLUSHKOV donne directement un automate sans epsilon-transition,
+ * dont les états sont l'état initial 0 et les positions des lettres dans
+ * l'expression (numérotées à partir de 1).
+ *
+ * CONSTRUCTION_THOMPSON construit l'automate de Thompson, puis supprime ses
+ * epsilon-transitions : seuls sont gardés l'état initial et les états
+ * atteints par une transition étiquetée.
+ */
+typedef enum {
+	CONSTRUCTION_GLUSHKOV,
+	CONSTRUCTION_THOMPSON
+} Construction_expression;
+
+/**
+ * \brief Renvoie un automate qui reconnaît le langage d'une expression
+ *        rationnelle, ou NULL si l'expression est mal formée.
+ *
+ * La syntaxe reconnue est :
+ * - la concaténation, l'union '|' et les parenthèses ;
+ * - les opérateurs postfixes '*', '+' et '?' ;
+ * - les classes de lettres '[abc]', avec des intervalles '[a-z0-9]', et
+ *   leur complémentaire '[^...]' parmi tous les points de code non nuls ;
+ * - le caractère d'échappement '\' (avec '\n' et '\t'), nécessaire pour
+ *   utiliser une lettre parmi "()|*+?[]\".
+ * L'expression vide (ou une alternative vide, comme dans "a|") reconnaît le
+ * mot vide.
+ *
+ * L'expression est lue en UTF-8 : une lettre ou une borne d'intervalle est un
+ * point de code, et une expression qui n'est pas de l'UTF-8 valide est mal
+ * formée. L'automate obtenu reste un automate sur les octets, qui reconnaît
+ * les encodages UTF-8 des mots du langage (voir pour_toute_sequence_utf8()).
+ *
+ * L'automate est construit par l'algorithme de Glushkov.
+ *
+ * \param expression Une expression rationnelle
+ * \return Un automate, ou NULL
+ */
+Automate * expression_vers_automate( const char * expression );
+
+/**
+ * \brief Comme expression_vers_automate(), avec la construction passée en
+ *        paramètre.
+ */
+Automate * expression_vers_automate_par(
+	const char * expression, Construction_expression construction
+);
+
+/**
+ * \brief Les durées (en secondes) des étapes de compiler_expression().
+ */
+typedef struct {
+	double analyse;
+	double construction;
+	double determinisation;
+	double minimisation;
+	double compilation;
+} Temps_compilation;
+
+/**
+ * \brief Compile une expression rationnelle en automate déterministe minimal
+ *        prêt pour la reconnaissance, ou renvoie NULL si l'expression est mal
+ *        formée.
+ *
+ * Les étapes sont l'analyse de l'expression, la construction de l'automate
+ * non déterministe, sa déterminisation, sa minimisation, puis la compilation
+ * en table. Si 'temps' n'est pas NULL, la durée de chaque étape y est
+ * écrite.
+ *
+ * \param expression Une expression rationnelle
+ * \param construction La construction de l'automate non déterministe
+ * \param temps L'adresse où écrire les durées, ou NULL
+ * \return L'automate compilé, à libérer avec liberer_automate_compile()
+ */
+Automate_compile * compiler_expression(
+	const char * expression, Construction_expression construction,
+	Temps_compilation * temps
+);
+
+#endif
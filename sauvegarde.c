@@ -0,0 +1,289 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "sauvegarde.h"
+#include "index_automate.h"
+#include "outils.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Les tableaux d'entiers de l'index sont écrits et relus tels quels.
+_Static_assert( sizeof(int) == sizeof(int32_t), "int doit faire 32 bits" );
+
+#define MAGIQUE "AUTOMATE"
+#define BOUTISME 0x01020304
+
+typedef enum {
+	SECTION_NOMS,
+	SECTION_DEBUT,
+	SECTION_LETTRES,
+	SECTION_FINS,
+	SECTION_ALPHABET,
+	SECTION_INITIAUX,
+	SECTION_FINAUX,
+	SECTION_CLASSES,
+	SECTION_TABLE,
+	NB_SECTIONS
+} Section;
+
+/*
+ * L'en-tête du fichier. 'nb_classes' est nul si le fichier ne contient pas
+ * de table compilée ; les sections CLASSES et TABLE sont alors vides.
+ */
+typedef struct {
+	char magique[8];
+	uint32_t version;
+	uint32_t boutisme;
+	uint32_t nb_etats;
+	uint32_t nb_transitions;
+	uint32_t taille_alphabet;
+	uint32_t nb_classes;
+	int32_t initial;
+	uint32_t reserve;
+	uint64_t taille;
+	uint64_t positions[NB_SECTIONS];
+} En_tete;
+
+/* Calcule la taille de chaque section à partir des nombres de l'en-tête, et
+ * range les sections les unes à la suite des autres, alignées sur 8 octets.
+ */
+static void calculer_positions(
+	En_tete * en_tete, uint64_t tailles[NB_SECTIONS]
+){
+	uint64_t n = en_tete->nb_etats, m = en_tete->nb_transitions;
+	uint64_t position = sizeof(En_tete);
+	int s;
+
+	tailles[SECTION_NOMS] = n * sizeof(int32_t);
+	tailles[SECTION_DEBUT] = ( n + 1 ) * sizeof(int32_t);
+	tailles[SECTION_LETTRES] = m;
+	tailles[SECTION_FINS] = m * sizeof(int32_t);
+	tailles[SECTION_ALPHABET] = en_tete->taille_alphabet;
+	tailles[SECTION_INITIAUX] = ( NB_MOTS_BITS( n ) + 1 ) * sizeof(uint64_t);
+	tailles[SECTION_FINAUX] = tailles[SECTION_INITIAUX];
+	tailles[SECTION_CLASSES] = en_tete->nb_classes ? 256 : 0;
+	tailles[SECTION_TABLE] = en_tete->nb_classes
+		? ( n * en_tete->nb_classes + 1 ) * sizeof(int32_t) : 0;
+	for( s = 0; s < NB_SECTIONS; s++ ){
+		position = ( position + 7 ) & ~ (uint64_t) 7;
+		en_tete->positions[s] = position;
+		position += tailles[s];
+	}
+	en_tete->taille = position;
+}
+
+int sauver_automate( const Automate * automate, const char * fichier ){
+	Index_automate * index = creer_index_automate( automate );
+	Automate_compile * compile = NULL;
+	static const char zeros[8] = { 0 };
+	const void * donnees[NB_SECTIONS];
+	uint64_t tailles[NB_SECTIONS], position;
+	En_tete en_tete;
+	FILE * f;
+	int ok, s;
+
+	memset( &en_tete, 0, sizeof(En_tete) );
+	memcpy( en_tete.magique, MAGIQUE, sizeof(en_tete.magique) );
+	en_tete.version = VERSION_FORMAT_AUTOMATE;
+	en_tete.boutisme = BOUTISME;
+	en_tete.nb_etats = index->nb_etats;
+	en_tete.nb_transitions = index->nb_transitions;
+	en_tete.taille_alphabet = index->taille_alphabet;
+	en_tete.initial = -1;
+	if( index_est_deterministe( index ) ){
+		compile = compiler_automate( automate );
+		en_tete.nb_classes = compile->nb_classes;
+		en_tete.initial = compile->initial;
+	}
+	calculer_positions( &en_tete, tailles );
+
+	donnees[SECTION_NOMS] = index->noms;
+	donnees[SECTION_DEBUT] = index->debut;
+	donnees[SECTION_LETTRES] = index->lettres;
+	donnees[SECTION_FINS] = index->fins;
+	donnees[SECTION_ALPHABET] = index->alphabet;
+	donnees[SECTION_INITIAUX] = index->initiaux;
+	donnees[SECTION_FINAUX] = index->finaux;
+	donnees[SECTION_CLASSES] = compile ? compile->classes : NULL;
+	donnees[SECTION_TABLE] = compile ? compile->transitions : NULL;
+
+	f = fopen( fichier, "wb" );
+	ok = ( f != NULL );
+	if( ok ) ok = ( fwrite( &en_tete, sizeof(En_tete), 1, f ) == 1 );
+	position = sizeof(En_tete);
+	for( s = 0; ok && s < NB_SECTIONS; s++ ){
+		if( en_tete.positions[s] > position ){
+			ok = fwrite( zeros, en_tete.positions[s] - position, 1, f ) == 1;
+		}
+		if( ok && tailles[s] > 0 ){
+			ok = ( fwrite( donnees[s], tailles[s], 1, f ) == 1 );
+		}
+		position = en_tete.positions[s] + tailles[s];
+	}
+	if( f && fclose( f ) != 0 ) ok = 0;
+
+	liberer_automate_compile( compile );
+	liberer_index_automate( index );
+	return ok;
+}
+
+/* Projette un fichier en mémoire, en lecture seule, et renvoie l'adresse de
+ * la projection, ou NULL si le fichier ne peut pas être projeté.
+ */
+static void * projeter_fichier( const char * fichier, size_t * taille ){
+	struct stat informations;
+	void * res;
+	int descripteur = open( fichier, O_RDONLY );
+	if( descripteur < 0 ) return NULL;
+	if( fstat( descripteur, &informations ) != 0
+		|| informations.st_size < (off_t) sizeof(En_tete)
+	){
+		close( descripteur );
+		return NULL;
+	}
+	*taille = informations.st_size;
+	res = mmap( NULL, *taille, PROT_READ, MAP_PRIVATE, descripteur, 0 );
+	close( descripteur );
+	return ( res == MAP_FAILED ) ? NULL : res;
+}
+
+/* Renvoie 1 si l'en-tête est celui d'un fichier de 'taille' octets écrit par
+ * sauver_automate(), et 0 sinon. Le contenu des sections n'est pas vérifié.
+ */
+static int en_tete_est_valide( const En_tete * en_tete, size_t taille ){
+	uint64_t tailles[NB_SECTIONS];
+	En_tete attendu;
+	if( memcmp( en_tete->magique, MAGIQUE, sizeof(en_tete->magique) ) != 0
+		|| en_tete->version != VERSION_FORMAT_AUTOMATE
+		|| en_tete->boutisme != BOUTISME
+		|| en_tete->nb_etats >= INT_MAX
+		|| en_tete->nb_transitions >= INT_MAX
+		|| en_tete->taille_alphabet > 256
+		|| en_tete->nb_classes > 256
+		|| en_tete->initial < -1
+		|| en_tete->initial >= (int64_t) en_tete->nb_etats
+	){
+		return 0;
+	}
+	attendu = *en_tete;
+	calculer_positions( &attendu, tailles );
+	return attendu.taille == taille
+		&& memcmp( attendu.positions, en_tete->positions, sizeof(attendu.positions) ) == 0;
+}
+
+Automate_compile * projeter_automate_compile( const char * fichier ){
+	size_t taille;
+	char * projection = projeter_fichier( fichier, &taille );
+	const En_tete * en_tete = (const En_tete *) projection;
+	Automate_compile * res;
+	int c;
+
+	if( ! projection ) return NULL;
+	if( ! en_tete_est_valide( en_tete, taille ) || en_tete->nb_classes == 0 ){
+		munmap( projection, taille );
+		return NULL;
+	}
+	res = xmalloc( sizeof(Automate_compile) );
+	res->nb_etats = en_tete->nb_etats;
+	res->initial = en_tete->initial;
+	res->nb_classes = en_tete->nb_classes;
+	memcpy( res->classes, projection + en_tete->positions[SECTION_CLASSES], 256 );
+	res->transitions = (int32_t *) ( projection + en_tete->positions[SECTION_TABLE] );
+	res->finaux = (uint64_t *) ( projection + en_tete->positions[SECTION_FINAUX] );
+	res->projection = projection;
+	res->taille_projection = taille;
+	for( c = 0; c < 256; c++ ){
+		if( res->classes[c] >= res->nb_classes ){
+			liberer_automate_compile( res );
+			return NULL;
+		}
+	}
+	return res;
+}
+
+Automate * charger_automate( const char * fichier ){
+	size_t taille;
+	char * projection = projeter_fichier( fichier, &taille );
+	const En_tete * en_tete = (const En_tete *) projection;
+	const int32_t * noms, * debut, * fins;
+	const char * lettres, * alphabet;
+	const uint64_t * initiaux, * finaux;
+	Automate * res = NULL;
+	int valide, n, i, t;
+
+	if( ! projection ) return NULL;
+	if( ! en_tete_est_valide( en_tete, taille ) ){
+		munmap( projection, taille );
+		return NULL;
+	}
+	n = en_tete->nb_etats;
+	noms = (const int32_t *) ( projection + en_tete->positions[SECTION_NOMS] );
+	debut = (const int32_t *) ( projection + en_tete->positions[SECTION_DEBUT] );
+	lettres = projection + en_tete->positions[SECTION_LETTRES];
+	fins = (const int32_t *) ( projection + en_tete->positions[SECTION_FINS] );
+	alphabet = projection + en_tete->positions[SECTION_ALPHABET];
+	initiaux = (const uint64_t *) ( projection + en_tete->positions[SECTION_INITIAUX] );
+	finaux = (const uint64_t *) ( projection + en_tete->positions[SECTION_FINAUX] );
+
+	// Les transitions doivent former un CSR valide entre états existants.
+	valide = ( debut[0] == 0 && debut[n] == (int32_t) en_tete->nb_transitions );
+	for( i = 0; valide && i < n; i++ ){
+		valide = ( debut[i+1] >= debut[i] );
+	}
+	for( t = 0; valide && t < (int) en_tete->nb_transitions; t++ ){
+		valide = ( fins[t] >= 0 && fins[t] < n );
+	}
+
+	// Les transitions de l'index sont triées par origine, lettre puis fin :
+	// elles sont ajoutées d'un coup, sans tri.
+	if( valide ){
+		int * origines = xmalloc( ( en_tete->nb_transitions + 1 ) * sizeof(int) );
+		int * arrivees = xmalloc( ( en_tete->nb_transitions + 1 ) * sizeof(int) );
+		for( i = 0; i < n; i++ ){
+			for( t = debut[i]; t < debut[i+1]; t++ ){
+				origines[t] = noms[i];
+				arrivees[t] = noms[ fins[t] ];
+			}
+		}
+		res = creer_automate();
+		ajouter_transitions_en_bloc(
+			res, origines, lettres, arrivees, en_tete->nb_transitions
+		);
+		for( i = 0; i < (int) en_tete->taille_alphabet; i++ ){
+			ajouter_lettre( res, alphabet[i] );
+		}
+		for( i = 0; i < n; i++ ){
+			ajouter_etat( res, noms[i] );
+			if( TESTER_BIT( initiaux, i ) ) ajouter_etat_initial( res, noms[i] );
+			if( TESTER_BIT( finaux, i ) ) ajouter_etat_final( res, noms[i] );
+		}
+		xfree( arrivees );
+		xfree( origines );
+	}
+	munmap( projection, taille );
+	return res;
+}
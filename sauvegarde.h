@@ -0,0 +1,88 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __SAUVEGARDE_H__
+#define __SAUVEGARDE_H__
+
+#include "automate.h"
+#include "automate_compile.h"
+
+/**
+ * \brief La version du format de fichier écrit par sauver_automate().
+ */
+#define VERSION_FORMAT_AUTOMATE 1
+
+/**
+ * \brief Enregistre un automate dans un fichier binaire.
+ *
+ * Le fichier commence par un en-tête (le mot "AUTOMATE", la version du
+ * format, un marqueur de boutisme, les nombres d'états, de transitions et de
+ * lettres, et la position de chaque section dans le fichier). Il contient
+ * ensuite, alignés sur 8 octets, les tableaux d'un Index_automate : les noms
+ * des états, les transitions au format CSR, l'alphabet, et les ensembles de
+ * bits des états initiaux et finaux.
+ *
+ * Si l'automate est déterministe, le fichier contient aussi sa table de
+ * transitions compilée (voir compiler_automate()), que
+ * projeter_automate_compile() utilise sans la recopier.
+ *
+ * Les entiers sont écrits dans le boutisme de la machine : un fichier n'est
+ * relu que sur une machine de même boutisme.
+ *
+ * \param automate Un automate
+ * \param fichier Le chemin du fichier à écrire
+ * \return 1 si le fichier a été écrit, 0 en cas d'erreur d'entrée-sortie
+ */
+int sauver_automate( const Automate * automate, const char * fichier );
+
+/**
+ * \brief Relit un automate enregistré par sauver_automate().
+ *
+ * Le fichier est entièrement vérifié : un fichier tronqué, d'une autre
+ * version ou incohérent est refusé.
+ *
+ * \param fichier Le chemin du fichier
+ * \return L'automate, ou NULL si le fichier ne peut pas être lu ou n'est pas
+ *         valide
+ */
+Automate * charger_automate( const char * fichier );
+
+/**
+ * \brief Projette en mémoire la table compilée d'un automate déterministe
+ *        enregistré par sauver_automate().
+ *
+ * Le fichier est projeté en lecture seule et ses tableaux sont utilisés sur
+ * place : seuls l'en-tête et la position des sections sont vérifiés, et le
+ * coût ne dépend pas de la taille de l'automate. Les pages de la table ne
+ * sont lues qu'au moment où la reconnaissance les parcourt, et sont
+ * partagées entre les processus qui projettent le même fichier.
+ *
+ * Le contenu de la table n'est pas vérifié : le fichier doit avoir été écrit
+ * par sauver_automate() et ne pas être modifié tant qu'il est projeté.
+ *
+ * \param fichier Le chemin du fichier
+ * \return L'automate compilé, à libérer avec liberer_automate_compile(), ou
+ *         NULL si le fichier ne peut pas être lu, n'est pas valide, ou ne
+ *         contient pas de table compilée
+ */
+Automate_compile * projeter_automate_compile( const char * fichier );
+
+#endif
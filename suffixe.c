@@ -0,0 +1,210 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "suffixe.h"
+#include "outils.h"
+
+/*
+ * Les transitions sortantes de l'état e forment une liste chaînée qui
+ * commence à la case premiere[e] des tableaux 'lettres', 'cibles' et
+ * 'suivantes' (-1 termine la liste).
+ */
+struct _Automate_suffixes {
+	int nb_etats;
+	int capacite_etats;
+	int * longueurs;
+	int * liens;
+	int * premieres;
+
+	int nb_transitions;
+	int capacite_transitions;
+	char * lettres;
+	int * cibles;
+	int * suivantes;
+
+	int dernier;
+};
+
+static int nouvel_etat_suffixe( Automate_suffixes * a, int longueur ){
+	int e = a->nb_etats++;
+	if( e == a->capacite_etats ){
+		a->capacite_etats *= 2;
+		a->longueurs = xrealloc( a->longueurs, a->capacite_etats * sizeof(int) );
+		a->liens = xrealloc( a->liens, a->capacite_etats * sizeof(int) );
+		a->premieres = xrealloc( a->premieres, a->capacite_etats * sizeof(int) );
+	}
+	a->longueurs[e] = longueur;
+	a->liens[e] = -1;
+	a->premieres[e] = -1;
+	return e;
+}
+
+static void nouvelle_transition_suffixe(
+	Automate_suffixes * a, int origine, char lettre, int cible
+){
+	int t = a->nb_transitions++;
+	if( t == a->capacite_transitions ){
+		a->capacite_transitions *= 2;
+		a->lettres = xrealloc( a->lettres, a->capacite_transitions );
+		a->cibles = xrealloc( a->cibles, a->capacite_transitions * sizeof(int) );
+		a->suivantes = xrealloc( a->suivantes, a->capacite_transitions * sizeof(int) );
+	}
+	a->lettres[t] = lettre;
+	a->cibles[t] = cible;
+	a->suivantes[t] = a->premieres[origine];
+	a->premieres[origine] = t;
+}
+
+/* Renvoie la case de la transition de 'origine' par 'lettre', ou -1.
+ */
+static int trouver_transition_suffixe(
+	const Automate_suffixes * a, int origine, char lettre
+){
+	int t;
+	for( t = a->premieres[origine]; t >= 0; t = a->suivantes[t] ){
+		if( a->lettres[t] == lettre ) return t;
+	}
+	return -1;
+}
+
+Automate_suffixes * creer_automate_suffixes(){
+	Automate_suffixes * res = xmalloc( sizeof(Automate_suffixes) );
+	res->nb_etats = 0;
+	res->capacite_etats = 16;
+	res->longueurs = xmalloc( res->capacite_etats * sizeof(int) );
+	res->liens = xmalloc( res->capacite_etats * sizeof(int) );
+	res->premieres = xmalloc( res->capacite_etats * sizeof(int) );
+	res->nb_transitions = 0;
+	res->capacite_transitions = 16;
+	res->lettres = xmalloc( res->capacite_transitions );
+	res->cibles = xmalloc( res->capacite_transitions * sizeof(int) );
+	res->suivantes = xmalloc( res->capacite_transitions * sizeof(int) );
+	res->dernier = nouvel_etat_suffixe( res, 0 );
+	return res;
+}
+
+Automate_suffixes * creer_automate_suffixes_mot( const char * mot ){
+	Automate_suffixes * res = creer_automate_suffixes();
+	for( ; *mot; mot++ ) ajouter_lettre_suffixe( res, *mot );
+	return res;
+}
+
+void liberer_automate_suffixes( Automate_suffixes * automate ){
+	if( automate ){
+		xfree( automate->longueurs );
+		xfree( automate->liens );
+		xfree( automate->premieres );
+		xfree( automate->lettres );
+		xfree( automate->cibles );
+		xfree( automate->suivantes );
+		xfree( automate );
+	}
+}
+
+void ajouter_lettre_suffixe( Automate_suffixes * a, char lettre ){
+	int nouveau = nouvel_etat_suffixe( a, a->longueurs[ a->dernier ] + 1 );
+	int p = a->dernier, t, q, clone;
+
+	// Les suffixes qui n'avaient pas de transition par 'lettre' mènent au
+	// nouvel état.
+	while( p >= 0 && ( t = trouver_transition_suffixe( a, p, lettre ) ) < 0 ){
+		nouvelle_transition_suffixe( a, p, lettre, nouveau );
+		p = a->liens[p];
+	}
+	a->dernier = nouveau;
+	if( p < 0 ){
+		a->liens[nouveau] = 0;
+		return;
+	}
+	q = a->cibles[t];
+	if( a->longueurs[p] + 1 == a->longueurs[q] ){
+		a->liens[nouveau] = q;
+		return;
+	}
+
+	// q regroupe des mots de longueurs différentes, qui ne sont plus tous
+	// suffixes du texte : on sépare les plus courts dans un clone.
+	clone = nouvel_etat_suffixe( a, a->longueurs[p] + 1 );
+	for( t = a->premieres[q]; t >= 0; t = a->suivantes[t] ){
+		nouvelle_transition_suffixe( a, clone, a->lettres[t], a->cibles[t] );
+	}
+	a->liens[clone] = a->liens[q];
+	while( p >= 0 ){
+		t = trouver_transition_suffixe( a, p, lettre );
+		if( a->cibles[t] != q ) break;
+		a->cibles[t] = clone;
+		p = a->liens[p];
+	}
+	a->liens[q] = clone;
+	a->liens[nouveau] = clone;
+}
+
+int nb_etats_suffixes( const Automate_suffixes * automate ){
+	return automate->nb_etats;
+}
+
+/* Renvoie l'état atteint en lisant 'motif' depuis l'état initial, ou -1.
+ */
+static int lire_motif( const Automate_suffixes * a, const char * motif ){
+	int e = 0;
+	for( ; *motif; motif++ ){
+		int t = trouver_transition_suffixe( a, e, *motif );
+		if( t < 0 ) return -1;
+		e = a->cibles[t];
+	}
+	return e;
+}
+
+int est_facteur( const Automate_suffixes * automate, const char * motif ){
+	return lire_motif( automate, motif ) >= 0;
+}
+
+int est_suffixe( const Automate_suffixes * automate, const char * motif ){
+	int e = lire_motif( automate, motif ), f;
+	if( e < 0 ) return 0;
+	// Les états finaux sont ceux de la chaîne des liens suffixes du dernier
+	// état.
+	for( f = automate->dernier; f >= 0; f = automate->liens[f] ){
+		if( f == e ) return 1;
+	}
+	return 0;
+}
+
+Automate * automate_suffixes_vers_automate(
+	const Automate_suffixes * automate, int facteurs
+){
+	Automate * res = creer_automate();
+	int e, t;
+	for( e = 0; e < automate->nb_etats; e++ ){
+		ajouter_etat( res, e );
+		if( facteurs ) ajouter_etat_final( res, e );
+		for( t = automate->premieres[e]; t >= 0; t = automate->suivantes[t] ){
+			ajouter_transition( res, e, automate->lettres[t], automate->cibles[t] );
+		}
+	}
+	if( ! facteurs ){
+		for( e = automate->dernier; e >= 0; e = automate->liens[e] ){
+			ajouter_etat_final( res, e );
+		}
+	}
+	ajouter_etat_initial( res, 0 );
+	return res;
+}
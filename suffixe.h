@@ -0,0 +1,91 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __SUFFIXE_H__
+#define __SUFFIXE_H__
+
+#include "automate.h"
+
+/**
+ * \brief L'automate des suffixes d'un mot (ou DAWG) : le plus petit automate
+ *        déterministe qui reconnaît les suffixes du mot. Si tous ses états
+ *        sont finaux, il reconnaît les facteurs du mot.
+ *
+ * Les états et les transitions sont rangés dans des tableaux : chaque état a
+ * la liste chaînée de ses transitions sortantes, son lien suffixe et la
+ * longueur du plus long mot qui y mène.
+ */
+typedef struct _Automate_suffixes Automate_suffixes;
+
+/**
+ * \brief Crée l'automate des suffixes du mot vide.
+ */
+Automate_suffixes * creer_automate_suffixes();
+
+/**
+ * \brief Crée l'automate des suffixes d'un mot, en temps linéaire.
+ */
+Automate_suffixes * creer_automate_suffixes_mot( const char * mot );
+
+void liberer_automate_suffixes( Automate_suffixes * automate );
+
+/**
+ * \brief Ajoute une lettre à la fin du mot dont l'automate reconnaît les
+ *        suffixes.
+ *
+ * L'automate est mis à jour en place (construction en ligne de Blumer et
+ * al.), en temps constant amorti pour un alphabet fixé : on peut donc
+ * l'utiliser sur un texte lu au fur et à mesure.
+ */
+void ajouter_lettre_suffixe( Automate_suffixes * automate, char lettre );
+
+/**
+ * \brief Renvoie le nombre d'états de l'automate des suffixes.
+ */
+int nb_etats_suffixes( const Automate_suffixes * automate );
+
+/**
+ * \brief Renvoie 1 si 'motif' est un facteur du mot, et 0 sinon, en temps
+ *        proportionnel à la longueur du motif.
+ */
+int est_facteur( const Automate_suffixes * automate, const char * motif );
+
+/**
+ * \brief Renvoie 1 si 'motif' est un suffixe du mot, et 0 sinon.
+ */
+int est_suffixe( const Automate_suffixes * automate, const char * motif );
+
+/**
+ * \brief Convertit l'automate des suffixes en Automate.
+ *
+ * Les états gardent leurs numéros, l'état initial est 0. Si 'facteurs' vaut
+ * 1, tous les états sont finaux et l'automate reconnaît les facteurs du mot ;
+ * sinon, il reconnaît ses suffixes.
+ *
+ * \param automate L'automate des suffixes
+ * \param facteurs 0 ou 1
+ * \return L'automate
+ */
+Automate * automate_suffixes_vers_automate(
+	const Automate_suffixes * automate, int facteurs
+);
+
+#endif
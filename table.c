@@ -55,8 +55,8 @@ intptr_t get_valeur( Table_iterateur it ){
 Table_association * creer_table_association(
 	const Table* table, const intptr_t cle, intptr_t valeur
 ){
-	Table_association * res = xmalloc(
-		sizeof( Table_association )
+	Table_association * res = xmalloc_etiquete(
+		sizeof( Table_association ), ALLOCATION_TABLE
 	);
 	if( table->copier_cle && cle ){
 		res->cle = table->copier_cle( cle );
@@ -71,8 +71,8 @@ Table_association * creer_table_association(
 }
 
 Table_association * copier_table_association( Table_association * asso ){
-	Table_association * res = xmalloc(
-		sizeof( Table_association )
+	Table_association * res = xmalloc_etiquete(
+		sizeof( Table_association ), ALLOCATION_TABLE
 	);
 	*res = *asso;
 	if( asso->copier_cle && asso->cle ){
@@ -117,7 +117,7 @@ Table* creer_table(
 	intptr_t (*copier_cle)( const intptr_t cle ),
 	void (*supprimer_cle)(intptr_t cle)
 ){
-	Table* res = xmalloc( sizeof(Table) );
+	Table* res = xmalloc_etiquete( sizeof(Table), ALLOCATION_TABLE );
 	res->root = avl_create ( compare_table_association, NULL, NULL );
 
 	res->supprimer_cle = supprimer_cle;
@@ -144,6 +144,75 @@ void add_table( Table* table, const intptr_t cle, intptr_t valeur ) {
 	}
 }
 
+/*
+ * Construit un arbre équilibré à partir d'associations triées : la racine est
+ * l'association du milieu. Les hauteurs des deux sous-arbres diffèrent d'au
+ * plus 1, ce qui donne directement les facteurs d'équilibre.
+ */
+static struct avl_node * construire_arbre_trie(
+	struct avl_table * arbre, Table_association ** assos, size_t nb,
+	int * hauteur
+){
+	struct avl_node * noeud;
+	size_t milieu = nb / 2;
+	int hauteur_gauche, hauteur_droite;
+	if( nb == 0 ){
+		*hauteur = 0;
+		return NULL;
+	}
+	noeud = arbre->avl_alloc->libavl_malloc( arbre->avl_alloc, sizeof *noeud );
+	noeud->avl_data = assos[milieu];
+	noeud->avl_link[0] = construire_arbre_trie(
+		arbre, assos, milieu, &hauteur_gauche
+	);
+	noeud->avl_link[1] = construire_arbre_trie(
+		arbre, assos + milieu + 1, nb - milieu - 1, &hauteur_droite
+	);
+	noeud->avl_balance = hauteur_droite - hauteur_gauche;
+	*hauteur = 1 + ( hauteur_gauche > hauteur_droite
+		? hauteur_gauche : hauteur_droite );
+	return noeud;
+}
+
+#define NB_ASSOCIATIONS_LOCALES 16
+
+void add_table_triee(
+	Table* table, const intptr_t* cles, const intptr_t* valeurs, size_t nb
+){
+	Table_association * locales[NB_ASSOCIATIONS_LOCALES];
+	Table_association ** assos = locales;
+	int trie = ( table->root->avl_count == 0 ), hauteur;
+	size_t i;
+
+	for( i = 0; trie && i + 1 < nb; i++ ){
+		trie = table->comparer_cle
+			? table->comparer_cle( cles[i], cles[i+1] ) < 0
+			: cles[i] < cles[i+1];
+	}
+	if( ! trie ){
+		for( i = 0; i < nb; i++ ){
+			add_table( table, cles[i], valeurs ? valeurs[i] : (intptr_t) NULL );
+		}
+		return;
+	}
+	if( nb > NB_ASSOCIATIONS_LOCALES ){
+		assos = xmalloc_etiquete(
+			nb * sizeof(Table_association*), ALLOCATION_TABLE
+		);
+	}
+	for( i = 0; i < nb; i++ ){
+		assos[i] = creer_table_association(
+			table, cles[i], valeurs ? valeurs[i] : (intptr_t) NULL
+		);
+	}
+	table->root->avl_root = construire_arbre_trie(
+		table->root, assos, nb, &hauteur
+	);
+	table->root->avl_count = nb;
+	table->root->avl_generation++;
+	if( assos != locales ) xfree( assos );
+}
+
 intptr_t delete_table( Table* table, intptr_t cle ){
 	intptr_t valeur = (intptr_t) NULL;
 	Table_association* asso_tree = NULL;
@@ -176,6 +176,19 @@ void liberer_table( Table* table );
  */
 void add_table( Table* table, const intptr_t cle, const intptr_t valeur );
 
+/*
+ * Ajoute 'nb' associations d'un coup : cles[i] est associée à valeurs[i]
+ * (ou à NULL si 'valeurs' est NULL). Les clés sont copiées comme dans
+ * add_table().
+ *
+ * Si la table est vide et que les clés sont données par ordre strictement
+ * croissant, l'arbre est construit directement, en temps linéaire. Sinon, les
+ * associations sont ajoutées une par une avec add_table().
+ */
+void add_table_triee(
+	Table* table, const intptr_t* cles, const intptr_t* valeurs, size_t nb
+);
+
 
 /*
  * Supprime une clé de la table. La mémoire de la clé est libérée et la valeur
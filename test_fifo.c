@@ -0,0 +1,324 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3 
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "fifo.h"
+#include "file_concurrente.h"
+#include "outils.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+int test_ordre_fifo(){
+	int result = 1;
+	int i, ordre = 1;
+
+	Fifo * fifo = creer_fifo();
+	TEST( est_vide( fifo ), result );
+	for( i = 0; i < 5; i++ ) ajouter_fifo( fifo, i );
+	TEST( taille_fifo( fifo ) == 5, result );
+	TEST( obtenir_fifo( fifo ) == 0, result );
+	for( i = 0; i < 5; i++ ){
+		if( retirer_fifo( fifo ) != i ) ordre = 0;
+	}
+	TEST( ordre, result );
+	TEST( est_vide( fifo ), result );
+	liberer_fifo( fifo );
+
+	return result;
+}
+
+int test_tableau_circulaire(){
+	int result = 1;
+	intptr_t tampon[100];
+	int i, k, nb_retraits, ordre = 1;
+	intptr_t prochain_ajout = 0, prochain_retrait = 0;
+
+	// Des ajouts et des retraits entrelacés font tourner le début de la
+	// file, et les agrandissements se produisent à cheval sur la fin du
+	// tableau.
+	Fifo * fifo = creer_fifo();
+	for( k = 0; k < 200; k++ ){
+		int nb_ajouts = k % 7 + 1;
+		for( i = 0; i < nb_ajouts; i++ ) tampon[i] = prochain_ajout++;
+		if( k % 2 ){
+			ajouter_elements_fifo( fifo, tampon, nb_ajouts );
+		}else{
+			for( i = 0; i < nb_ajouts; i++ ) ajouter_fifo( fifo, tampon[i] );
+		}
+		nb_retraits = retirer_elements_fifo( fifo, tampon, k % 5 );
+		for( i = 0; i < nb_retraits; i++ ){
+			if( tampon[i] != prochain_retrait++ ) ordre = 0;
+		}
+	}
+	TEST( taille_fifo( fifo ) == prochain_ajout - prochain_retrait, result );
+	while( ! est_vide( fifo ) ){
+		if( retirer_fifo( fifo ) != prochain_retrait++ ) ordre = 0;
+	}
+	TEST( ordre, result );
+	nb_retraits = retirer_elements_fifo( fifo, tampon, 10 );
+	TEST( nb_retraits == 0, result );
+
+	ajouter_fifo( fifo, 42 );
+	vider_fifo( fifo );
+	TEST( est_vide( fifo ), result );
+	liberer_fifo( fifo );
+
+	return result;
+}
+
+int test_longue_file(){
+	int result = 1;
+	int i, ordre = 1;
+
+	// Une longue file se libère sans récursion.
+	Fifo * fifo = creer_fifo();
+	for( i = 0; i < 1000000; i++ ) ajouter_fifo( fifo, i );
+	for( i = 0; i < 500000; i++ ){
+		if( retirer_fifo( fifo ) != i ) ordre = 0;
+	}
+	TEST( ordre, result );
+	TEST( taille_fifo( fifo ) == 500000, result );
+	liberer_fifo( fifo );
+
+	return result;
+}
+
+int test_pile(){
+	int result = 1;
+	intptr_t elements[] = { 1, 2, 3, 4 };
+	intptr_t tampon[4];
+	size_t nb;
+	int i, ordre = 1;
+
+	Pile * pile = creer_pile();
+	TEST( pile_est_vide( pile ), result );
+	for( i = 0; i < 100; i++ ) empiler( pile, i );
+	TEST( sommet_pile( pile ) == 99, result );
+	for( i = 99; i >= 0; i-- ){
+		if( depiler( pile ) != i ) ordre = 0;
+	}
+	TEST( ordre, result );
+	TEST( pile_est_vide( pile ), result );
+
+	empiler_elements( pile, elements, 4 );
+	TEST( taille_pile( pile ) == 4, result );
+	nb = depiler_elements( pile, tampon, 3 );
+	TEST( nb == 3, result );
+	TEST( tampon[0] == 4 && tampon[1] == 3 && tampon[2] == 2, result );
+	TEST( sommet_pile( pile ) == 1, result );
+	vider_pile( pile );
+	TEST( pile_est_vide( pile ), result );
+	liberer_pile( pile );
+
+	return result;
+}
+
+#define NB_FILS_STRESS 4
+#define NB_ELEMENTS_PAR_FIL 200000
+
+/*
+ * Les tests concurrents vérifient que chaque élément produit est reçu
+ * exactement une fois : chaque réception incrémente le compteur de
+ * l'élément. Les fils qui attendent cèdent le processeur, pour que le
+ * test avance aussi sur une machine à un seul cœur.
+ */
+typedef struct {
+	File_concurrente * file;
+	Deque_vol * deque;
+	int numero;
+	int * recus;
+	int * fin_production;
+} Fil_stress;
+
+static void recevoir( int * recus, intptr_t element ){
+	__atomic_fetch_add( &recus[ element ], 1, __ATOMIC_RELAXED );
+}
+
+static void * producteur( void * donnees ){
+	Fil_stress * f = donnees;
+	intptr_t i;
+	for( i = 0; i < NB_ELEMENTS_PAR_FIL; i++ ){
+		while( ! ajouter_file_concurrente(
+			f->file, f->numero * NB_ELEMENTS_PAR_FIL + i
+		) ){
+			sched_yield();
+		}
+	}
+	return NULL;
+}
+
+static void * consommateur( void * donnees ){
+	Fil_stress * f = donnees;
+	intptr_t element;
+	for(;;){
+		if( retirer_file_concurrente( f->file, &element ) ){
+			recevoir( f->recus, element );
+		}else if( __atomic_load_n( f->fin_production, __ATOMIC_ACQUIRE ) ){
+			// Les producteurs ont fini : on vide ce qui reste.
+			while( retirer_file_concurrente( f->file, &element ) ){
+				recevoir( f->recus, element );
+			}
+			return NULL;
+		}else{
+			sched_yield();
+		}
+	}
+}
+
+static int tous_recus_une_fois( const int * recus, int nb ){
+	int i;
+	for( i = 0; i < nb; i++ ){
+		if( recus[i] != 1 ) return 0;
+	}
+	return 1;
+}
+
+int test_file_concurrente(){
+	int result = 1;
+	int i, ok, ordre, fin_production = 0;
+	int nb = NB_FILS_STRESS * NB_ELEMENTS_PAR_FIL;
+	int * recus = calloc( nb, sizeof(int) );
+	intptr_t element;
+	pthread_t producteurs[ NB_FILS_STRESS ], consommateurs[ NB_FILS_STRESS ];
+	Fil_stress fils[ NB_FILS_STRESS ];
+
+	File_concurrente * file = creer_file_concurrente( 5 );
+	ok = retirer_file_concurrente( file, &element );
+	TEST( ! ok, result );
+	for( i = 0; i < 8; i++ ) ajouter_file_concurrente( file, i );
+	TEST( taille_file_concurrente( file ) == 8, result );
+	ok = ajouter_file_concurrente( file, 8 );
+	TEST( ! ok, result );
+	ordre = 1;
+	for( i = 0; i < 8; i++ ){
+		ok = retirer_file_concurrente( file, &element );
+		if( ! ok || element != i ) ordre = 0;
+	}
+	TEST( ordre, result );
+	liberer_file_concurrente( file );
+
+	// Une petite file pour que les fils se heurtent souvent aux bornes.
+	file = creer_file_concurrente( 64 );
+	for( i = 0; i < NB_FILS_STRESS; i++ ){
+		fils[i].file = file;
+		fils[i].numero = i;
+		fils[i].recus = recus;
+		fils[i].fin_production = &fin_production;
+		pthread_create( &consommateurs[i], NULL, consommateur, &fils[i] );
+	}
+	for( i = 0; i < NB_FILS_STRESS; i++ ){
+		pthread_create( &producteurs[i], NULL, producteur, &fils[i] );
+	}
+	for( i = 0; i < NB_FILS_STRESS; i++ ) pthread_join( producteurs[i], NULL );
+	__atomic_store_n( &fin_production, 1, __ATOMIC_RELEASE );
+	for( i = 0; i < NB_FILS_STRESS; i++ ) pthread_join( consommateurs[i], NULL );
+	TEST( tous_recus_une_fois( recus, nb ), result );
+	liberer_file_concurrente( file );
+	free( recus );
+
+	return result;
+}
+
+static void * voleur( void * donnees ){
+	Fil_stress * f = donnees;
+	intptr_t element;
+	for(;;){
+		Resultat_vol vol = voler_deque_vol( f->deque, &element );
+		if( vol == VOL_REUSSI ){
+			recevoir( f->recus, element );
+		}else if( vol == VOL_VIDE ){
+			if( __atomic_load_n( f->fin_production, __ATOMIC_ACQUIRE ) ){
+				return NULL;
+			}
+			sched_yield();
+		}
+	}
+}
+
+int test_deque_vol(){
+	int result = 1;
+	int i, ok, fin_production = 0;
+	int nb = NB_FILS_STRESS * NB_ELEMENTS_PAR_FIL;
+	int * recus = calloc( nb, sizeof(int) );
+	intptr_t element;
+	Resultat_vol vol;
+	pthread_t voleurs[ NB_FILS_STRESS ];
+	Fil_stress fils[ NB_FILS_STRESS ];
+
+	// Sans voleur, la deque est une pile pour son propriétaire, et une
+	// file pour les voleurs.
+	Deque_vol * deque = creer_deque_vol();
+	for( i = 0; i < 100; i++ ) empiler_deque_vol( deque, i );
+	TEST( taille_deque_vol( deque ) == 100, result );
+	ok = depiler_deque_vol( deque, &element );
+	TEST( ok && element == 99, result );
+	vol = voler_deque_vol( deque, &element );
+	TEST( vol == VOL_REUSSI && element == 0, result );
+	for( i = 1; i < 99; i++ ) depiler_deque_vol( deque, &element );
+	ok = depiler_deque_vol( deque, &element );
+	TEST( ! ok, result );
+	vol = voler_deque_vol( deque, &element );
+	TEST( vol == VOL_VIDE, result );
+	liberer_deque_vol( deque );
+
+	// Le propriétaire empile et dépile par rafales pendant que les autres
+	// fils volent : la deque grandit et son dernier élément est disputé.
+	deque = creer_deque_vol();
+	for( i = 0; i < NB_FILS_STRESS; i++ ){
+		fils[i].deque = deque;
+		fils[i].recus = recus;
+		fils[i].fin_production = &fin_production;
+		pthread_create( &voleurs[i], NULL, voleur, &fils[i] );
+	}
+	for( i = 0; i < nb; i++ ){
+		empiler_deque_vol( deque, i );
+		if( i % 3 == 0 && depiler_deque_vol( deque, &element ) ){
+			recevoir( recus, element );
+		}
+	}
+	while( depiler_deque_vol( deque, &element ) ) recevoir( recus, element );
+	__atomic_store_n( &fin_production, 1, __ATOMIC_RELEASE );
+	for( i = 0; i < NB_FILS_STRESS; i++ ) pthread_join( voleurs[i], NULL );
+	TEST( tous_recus_une_fois( recus, nb ), result );
+	liberer_deque_vol( deque );
+	free( recus );
+
+	return result;
+}
+
+int main(){
+	int result = 1;
+
+	result &= test_ordre_fifo();
+	result &= test_tableau_circulaire();
+	result &= test_longue_file();
+	result &= test_pile();
+	result &= test_file_concurrente();
+	result &= test_deque_vol();
+
+	if( ! result ){
+		fprintf( stderr, "Certains tests du fichier %s ont échoués.\n", __FILE__ );
+	}
+
+	return result;
+}
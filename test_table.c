@@ -395,6 +395,52 @@ int test_trouver_table(){
 	return result;
 }
 
+int test_add_table_triee(){
+	int result = 1;
+	Table * table = creer_table( NULL, NULL, NULL );
+	intptr_t cles[100], valeurs[100];
+	Table_iterateur it;
+	int i;
+
+	for( i = 0; i < 100; i++ ){
+		cles[i] = 2 * i - 50;
+		valeurs[i] = i;
+	}
+	add_table_triee( table, cles, valeurs, 100 );
+	i = 0;
+	for( it = premier_iterateur_table( table );
+		! iterateur_est_vide( it );
+		it = iterateur_suivant_table( it )
+	){
+		TEST( get_cle( it ) == cles[i] && get_valeur( it ) == i, result );
+		i++;
+	}
+	TEST( i == 100, result );
+
+	// L'arbre construit reste équilibré après des modifications.
+	for( i = 0; i < 100; i += 2 ) delete_table( table, cles[i] );
+	add_table( table, 1, 1 );
+	TEST( iterateur_est_vide( trouver_table( table, cles[0] ) ), result );
+	TEST( get_valeur( trouver_table( table, cles[51] ) ) == 51, result );
+	TEST( get_valeur( trouver_table( table, 1 ) ) == 1, result );
+
+	// Une table non vide : les associations sont ajoutées une par une.
+	add_table_triee( table, cles, NULL, 2 );
+	TEST( ! iterateur_est_vide( trouver_table( table, cles[0] ) ), result );
+	TEST( get_valeur( trouver_table( table, cles[1] ) ) == 0, result );
+	liberer_table( table );
+
+	// Des clés non triées
+	table = creer_table( NULL, NULL, NULL );
+	cles[0] = 3;
+	cles[1] = 1;
+	add_table_triee( table, cles, valeurs, 2 );
+	TEST( get_cle( premier_iterateur_table( table ) ) == 1, result );
+	liberer_table( table );
+
+	return result;
+}
+
 int test_get_cle(){
 	// Voir general_test
 	return 1;
@@ -420,6 +466,7 @@ int main(){
 	result &= test_pour_toute_valeur_table();
 	result &= test_pour_toute_cle_valeur_table();
 	result &= test_trouver_table();
+	result &= test_add_table_triee();
 	result &= test_get_cle();
 	result &= test_get_valeur();
 
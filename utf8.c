@@ -0,0 +1,173 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "utf8.h"
+
+int encoder_utf8( uint32_t c, char * octets ){
+	unsigned char * o = (unsigned char *) octets;
+	if( c < 0x80 ){
+		o[0] = c;
+		return 1;
+	}
+	if( c < 0x800 ){
+		o[0] = 0xC0 | ( c >> 6 );
+		o[1] = 0x80 | ( c & 0x3F );
+		return 2;
+	}
+	if( c >= 0xD800 && c <= 0xDFFF ) return 0;
+	if( c < 0x10000 ){
+		o[0] = 0xE0 | ( c >> 12 );
+		o[1] = 0x80 | ( ( c >> 6 ) & 0x3F );
+		o[2] = 0x80 | ( c & 0x3F );
+		return 3;
+	}
+	if( c <= CODE_POINT_MAX ){
+		o[0] = 0xF0 | ( c >> 18 );
+		o[1] = 0x80 | ( ( c >> 12 ) & 0x3F );
+		o[2] = 0x80 | ( ( c >> 6 ) & 0x3F );
+		o[3] = 0x80 | ( c & 0x3F );
+		return 4;
+	}
+	return 0;
+}
+
+int decoder_utf8( const char * octets, uint32_t * code_point ){
+	const unsigned char * o = (const unsigned char *) octets;
+	static const uint32_t minimums[] = { 0, 0, 0x80, 0x800, 0x10000 };
+	uint32_t c;
+	int n, i;
+
+	if( o[0] < 0x80 ){
+		*code_point = o[0];
+		return 1;
+	}
+	if( ( o[0] & 0xE0 ) == 0xC0 ){
+		n = 2;
+		c = o[0] & 0x1F;
+	}else if( ( o[0] & 0xF0 ) == 0xE0 ){
+		n = 3;
+		c = o[0] & 0x0F;
+	}else if( ( o[0] & 0xF8 ) == 0xF0 ){
+		n = 4;
+		c = o[0] & 0x07;
+	}else{
+		return 0;
+	}
+	// Un '\0' n'est pas un octet de continuation : la lecture s'arrête
+	// avant la fin de la chaîne.
+	for( i = 1; i < n; i++ ){
+		if( ( o[i] & 0xC0 ) != 0x80 ) return 0;
+		c = ( c << 6 ) | ( o[i] & 0x3F );
+	}
+	if( c < minimums[n] || c > CODE_POINT_MAX ) return 0;
+	if( c >= 0xD800 && c <= 0xDFFF ) return 0;
+	*code_point = c;
+	return n;
+}
+
+/*
+ * On coupe l'intervalle jusqu'à ce que tous ses points de code aient la même
+ * longueur d'encodage, et que pour chaque position, les octets de debut et de
+ * fin délimitent exactement les octets possibles : il suffit pour cela que
+ * debut et fin ne diffèrent que par des suffixes de 6 * i bits qui sont
+ * respectivement 00...0 et 11...1.
+ */
+void pour_toute_sequence_utf8(
+	uint32_t debut, uint32_t fin,
+	void (* action )( const Intervalle_octets * sequence, int longueur, void * data ),
+	void * data
+){
+	static const uint32_t bornes[] = { 0x7F, 0x7FF, 0xFFFF };
+	Intervalle_octets sequence[LONGUEUR_MAX_UTF8];
+	char octets_debut[LONGUEUR_MAX_UTF8], octets_fin[LONGUEUR_MAX_UTF8];
+	int i, n;
+
+	if( fin > CODE_POINT_MAX ) fin = CODE_POINT_MAX;
+	if( debut > fin ) return;
+	if( debut <= 0xDFFF && fin >= 0xD800 ){
+		if( debut < 0xD800 ) pour_toute_sequence_utf8( debut, 0xD7FF, action, data );
+		if( fin > 0xDFFF ) pour_toute_sequence_utf8( 0xE000, fin, action, data );
+		return;
+	}
+	for( i = 0; i < 3; i++ ){
+		if( debut <= bornes[i] && fin > bornes[i] ){
+			pour_toute_sequence_utf8( debut, bornes[i], action, data );
+			pour_toute_sequence_utf8( bornes[i] + 1, fin, action, data );
+			return;
+		}
+	}
+	for( i = 1; i < LONGUEUR_MAX_UTF8; i++ ){
+		uint32_t masque = ( (uint32_t) 1 << ( 6 * i ) ) - 1;
+		if( ( debut & ~masque ) == ( fin & ~masque ) ) continue;
+		if( ( debut & masque ) != 0 ){
+			pour_toute_sequence_utf8( debut, debut | masque, action, data );
+			pour_toute_sequence_utf8( ( debut | masque ) + 1, fin, action, data );
+			return;
+		}
+		if( ( fin & masque ) != masque ){
+			pour_toute_sequence_utf8( debut, ( fin & ~masque ) - 1, action, data );
+			pour_toute_sequence_utf8( fin & ~masque, fin, action, data );
+			return;
+		}
+	}
+
+	n = encoder_utf8( debut, octets_debut );
+	encoder_utf8( fin, octets_fin );
+	for( i = 0; i < n; i++ ){
+		sequence[i].debut = (unsigned char) octets_debut[i];
+		sequence[i].fin = (unsigned char) octets_fin[i];
+	}
+	action( sequence, n, data );
+}
+
+typedef struct {
+	Automate * automate;
+	int origine;
+	int arrivee;
+	int etat_libre;
+} Donnees_intervalle;
+
+static void ajouter_sequence(
+	const Intervalle_octets * sequence, int longueur, void * data
+){
+	Donnees_intervalle * d = (Donnees_intervalle *) data;
+	int courant = d->origine, i, c;
+	for( i = 0; i < longueur; i++ ){
+		int suivant = ( i == longueur - 1 ) ? d->arrivee : d->etat_libre++;
+		for( c = sequence[i].debut; c <= sequence[i].fin; c++ ){
+			ajouter_transition( d->automate, courant, (char) c, suivant );
+		}
+		courant = suivant;
+	}
+}
+
+int ajouter_intervalle_utf8(
+	Automate * automate, int origine, uint32_t debut, uint32_t fin,
+	int arrivee, int etat_libre
+){
+	Donnees_intervalle d;
+	d.automate = automate;
+	d.origine = origine;
+	d.arrivee = arrivee;
+	d.etat_libre = etat_libre;
+	pour_toute_sequence_utf8( debut, fin, ajouter_sequence, &d );
+	return d.etat_libre;
+}
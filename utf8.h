@@ -0,0 +1,106 @@
+/*
+ *   Ce fichier fait parti d'un projet de programmation donné en Licence 3
+ *   à l'Université de Bordeaux 1
+ *
+ *   Copyright (C) 2014 Adrien Boussicault
+ *
+ *    This Library is free software: you can redistribute it and/or modify
+ *    it under the terms of the GNU General Public License as published by
+ *    the Free Software Foundation, either version 2 of the License, or
+ *    (at your option) any later version.
+ *
+ *    This Library is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this Library.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef __UTF8_H__
+#define __UTF8_H__
+
+#include <stdint.h>
+
+#include "automate.h"
+
+#define CODE_POINT_MAX 0x10FFFF
+#define LONGUEUR_MAX_UTF8 4
+
+/**
+ * \brief Encode un point de code en UTF-8.
+ *
+ * \param code_point Un point de code
+ * \param octets Un tampon d'au moins LONGUEUR_MAX_UTF8 octets
+ * \return Le nombre d'octets écrits, ou 0 si le point de code est invalide
+ *         (supérieur à CODE_POINT_MAX, ou de la plage des substituts
+ *         D800-DFFF)
+ */
+int encoder_utf8( uint32_t code_point, char * octets );
+
+/**
+ * \brief Décode le point de code UTF-8 qui commence à l'adresse 'octets'.
+ *
+ * Les encodages trop longs, les substituts et les séquences tronquées sont
+ * refusés.
+ *
+ * \param octets Le début d'une séquence UTF-8, terminée par '\0'
+ * \param code_point L'adresse où écrire le point de code
+ * \return Le nombre d'octets lus, ou 0 si la séquence est invalide
+ */
+int decoder_utf8( const char * octets, uint32_t * code_point );
+
+/**
+ * \brief Un intervalle d'octets [debut, fin].
+ */
+typedef struct {
+	unsigned char debut;
+	unsigned char fin;
+} Intervalle_octets;
+
+/**
+ * \brief Découpe un intervalle de points de code en séquences d'intervalles
+ *        d'octets.
+ *
+ * Les encodages UTF-8 des points de code de [debut, fin] (substituts exclus)
+ * sont exactement les suites d'octets o_1 ... o_n telles que chaque o_i est
+ * dans le i-ème intervalle de l'une des séquences passées à 'action'. Les
+ * séquences sont disjointes, et il y en a au plus une dizaine par
+ * intervalle.
+ *
+ * \param debut Le premier point de code
+ * \param fin Le dernier point de code
+ * \param action La fonction appelée pour chaque séquence, avec sa longueur
+ * \param data Un pointeur passé à 'action'
+ */
+void pour_toute_sequence_utf8(
+	uint32_t debut, uint32_t fin,
+	void (* action )( const Intervalle_octets * sequence, int longueur, void * data ),
+	void * data
+);
+
+/**
+ * \brief Ajoute à un automate des chemins de l'état 'origine' à l'état
+ *        'arrivee' étiquetés par les encodages UTF-8 des points de code de
+ *        [debut, fin].
+ *
+ * L'automate reste un automate sur les octets : la reconnaissance d'un texte
+ * UTF-8 ne demande aucun décodage. Les états intermédiaires sont numérotés à
+ * partir de 'etat_libre'.
+ *
+ * \param automate Un automate
+ * \param origine L'état de départ
+ * \param debut Le premier point de code
+ * \param fin Le dernier point de code
+ * \param arrivee L'état d'arrivée
+ * \param etat_libre Le premier numéro d'état inutilisé
+ * \return Le premier numéro d'état encore inutilisé après l'ajout
+ */
+int ajouter_intervalle_utf8(
+	Automate * automate, int origine, uint32_t debut, uint32_t fin,
+	int arrivee, int etat_libre
+);
+
+#endif